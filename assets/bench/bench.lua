@@ -0,0 +1,10 @@
+-- Run by every script entity of the bench scene : a fixed amount of work per frame
+local time = 0
+local value = 0
+
+function Update(elapsedTime)
+    time = time + elapsedTime
+    for i = 1, 32 do
+        value = (value + math.sin(time * i)) % 1000
+    end
+end
@@ -0,0 +1,5 @@
+set(SOURCE_FILES
+sources/bench/BenchScene.cpp
+sources/bench/BenchScene.h
+sources/bench/main.cpp
+ )
@@ -0,0 +1,97 @@
+#include "BenchScene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "core/ECS/World.h"
+#include "core/scenegraph/SceneGraph.h"
+#include "physic/PhysicsShapeComponent/PhysicsBoxComponent.h"
+#include "physic/PhysicsShapeComponent/PhysicsSphereComponent.h"
+#include "script/ScriptComponent.h"
+
+namespace
+{
+	constexpr float PLATFORM_SIZE = 20.f;
+	constexpr float BOULDER_RADIUS = 1.f;
+	constexpr float BOULDER_MIN_HEIGHT = 5.f;
+	constexpr float BOULDER_MAX_HEIGHT = 60.f;
+	constexpr const char* BENCH_SCRIPT = "bench/bench.lua"; // relative to assets/
+
+	// std distributions differ between standard libraries, the engine output does not
+	float RandomRange(std::mt19937& random, float min, float max)
+	{
+		return min + (max - min) * (float)((double)random() / 4294967296.0);
+	}
+
+	void CreatePlatforms(Core::SceneNode* parent, int count, int side)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			Core::SceneNode* node = parent->CreateChild();
+			node->SetName("Platform" + std::to_string(i));
+			node->SetPosition({(float)(i % side) * PLATFORM_SIZE, 0.f, (float)(i / side) * PLATFORM_SIZE});
+
+			Physics::PhysicsStaticBoxComponentParams boxParams;
+			boxParams.halfExtents = {PLATFORM_SIZE / 2, 1.f, PLATFORM_SIZE / 2};
+			node->GetEntity()->AddComponent<Physics::PhysicsStaticBoxComponent>(&boxParams);
+		}
+	}
+
+	void CreateBoulders(Core::SceneNode* parent, int count, int side, std::mt19937& random)
+	{
+		const float extent = (float)side * PLATFORM_SIZE - PLATFORM_SIZE / 2;
+
+		for (int i = 0; i < count; i++)
+		{
+			Core::SceneNode* node = parent->CreateChild();
+			node->SetName("Boulder" + std::to_string(i));
+			node->SetPosition({
+				RandomRange(random, -PLATFORM_SIZE / 2, extent),
+				RandomRange(random, BOULDER_MIN_HEIGHT, BOULDER_MAX_HEIGHT),
+				RandomRange(random, -PLATFORM_SIZE / 2, extent)
+			});
+
+			Physics::PhysicsDynamicSphereComponentParams sphereParams;
+			sphereParams.radius = BOULDER_RADIUS;
+			sphereParams.density = 5.f;
+			sphereParams.restitution = 0.1f;
+			sphereParams.dynamicFriction = 0.95f;
+			sphereParams.staticFriction = 0.8f;
+			node->GetEntity()->AddComponent<Physics::PhysicsDynamicSphereComponent>(&sphereParams);
+		}
+	}
+
+	void CreateScripts(Core::SceneNode* parent, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			Core::SceneNode* node = parent->CreateChild();
+			node->SetName("Script" + std::to_string(i));
+			node->GetEntity()->AddComponent<script::ScriptComponent>(BENCH_SCRIPT);
+		}
+	}
+}
+
+void CreateBenchScene(const BenchSceneParams& params)
+{
+	std::mt19937 random(params.seed);
+	const int side = std::max(1, (int)std::ceil(std::sqrt((double)params.platforms)));
+
+	Core::SceneNode* root = Core::World::GetLevel()->GetRoot();
+
+	Core::SceneNode* platforms = root->CreateChild();
+	platforms->SetName("Platforms");
+	CreatePlatforms(platforms, params.platforms, side);
+
+	Core::SceneNode* boulders = root->CreateChild();
+	boulders->SetName("Boulders");
+	CreateBoulders(boulders, params.boulders, side, random);
+
+	Core::SceneNode* scripts = root->CreateChild();
+	scripts->SetName("Scripts");
+	CreateScripts(scripts, params.scripts);
+
+	Core::World::GetLevel()->UpdateAll();
+}
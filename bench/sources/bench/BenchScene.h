@@ -0,0 +1,12 @@
+#pragma once
+
+// Scripted scene without any model nor light, everything is placed from the seed so two runs simulate the same frames
+struct BenchSceneParams
+{
+	int platforms = 16; // static boxes on a square grid
+	int boulders = 256; // dynamic spheres dropped above the platforms
+	int scripts = 64; // entities running assets/bench/bench.lua
+	unsigned int seed = 1;
+};
+
+void CreateBenchScene(const BenchSceneParams& params);
@@ -0,0 +1,263 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "BenchScene.h"
+#include "core/CLog.h"
+#include "core/GameLoop.h"
+#include "core/DebugWindow/Profiler.h"
+#include "core/ECS/World.h"
+#include "physic/PhysicsManager.h"
+
+// Runs the engine without window nor renderer on a generated scene, or a level, for a fixed number of fixed step frames,
+// then prints the per frame timings of every profiler zone as json, on stdout unless --output is given. The logs go to stderr.
+// With --replay the inputs recorded by the editor drive the session, at the recorded step, until the recording ends.
+//   bench [--platforms <n>] [--boulders <n>] [--scripts <n>] [--seed <n>] [--frames <n>] [--step <seconds>] [--output <file.json>]
+//         [--level <file>] [--replay <file>] [--async-physics <0|1>] [--binary-log <0|1>]
+
+namespace
+{
+	struct BenchParams
+	{
+		BenchSceneParams scene;
+		int frames = 0; // 1000, or the whole recording when replaying
+		float step = 1.f / 60.f;
+		std::string outputPath; // stdout when empty
+		std::string levelPath; // the generated scene when empty
+		std::string replayPath;
+		bool isAsyncPhysics = false;
+		bool isBinaryLog = false; // the log file in the logdecoder format instead of text
+	};
+
+	void AppendJsonString(std::string& out, const char* str)
+	{
+		out.push_back('"');
+		for (; *str != '\0'; str++)
+		{
+			if (*str == '"' || *str == '\\')
+			{
+				out.push_back('\\');
+			}
+			if ((unsigned char)*str >= 0x20)
+			{
+				out.push_back(*str);
+			}
+		}
+		out.push_back('"');
+	}
+
+	void AppendHistogram(std::string& out, const Core::Histogram& histogram)
+	{
+		char buffer[256];
+		snprintf(buffer, sizeof(buffer),
+		         "\"frames\":%llu,\"mean\":%.4f,\"p50\":%.4f,\"p95\":%.4f,\"p99\":%.4f,\"max\":%.4f",
+		         histogram.GetCount(), histogram.GetMean(), histogram.Percentile(50.f), histogram.Percentile(95.f),
+		         histogram.Percentile(99.f), histogram.GetMax());
+		out.append(buffer);
+	}
+
+	std::string FormatReport(const BenchParams& params, double totalMilliseconds)
+	{
+		char buffer[256];
+		snprintf(buffer, sizeof(buffer),
+		         "{\n\"scene\":{\"platforms\":%d,\"boulders\":%d,\"scripts\":%d,\"seed\":%u},\n"
+		         "\"frameCount\":%d,\"step\":%.6f,\"asyncPhysics\":%s,\"totalMilliseconds\":%.3f,\n",
+		         params.scene.platforms, params.scene.boulders, params.scene.scripts, params.scene.seed,
+		         params.frames, params.step, params.isAsyncPhysics ? "true" : "false", totalMilliseconds);
+
+		std::string json(buffer);
+		if (params.levelPath.empty() == false)
+		{
+			json.append("\"level\":");
+			AppendJsonString(json, params.levelPath.c_str());
+			json.append(",\n");
+		}
+		if (params.replayPath.empty() == false)
+		{
+			json.append("\"replay\":");
+			AppendJsonString(json, params.replayPath.c_str());
+			json.append(",\n");
+		}
+		json.append("\"frame\":{");
+		AppendHistogram(json, Core::FrameStats::GetFrameHistogram());
+		json.append("},\n\"zones\":[\n");
+
+		const std::vector<Core::Profiler::ZoneHistory>& histories = Core::Profiler::GetZoneHistories();
+		for (size_t i = 0; i < histories.size(); i++)
+		{
+			json.append("{\"name\":");
+			AppendJsonString(json, histories[i].zone->name);
+			json.append(",\"file\":");
+			AppendJsonString(json, histories[i].zone->file);
+			json.append(",\"line\":").append(std::to_string(histories[i].zone->line)).append(",");
+			AppendHistogram(json, histories[i].histogram);
+			json.append(i + 1 < histories.size() ? "},\n" : "}\n");
+		}
+		json.append("]}\n");
+		return json;
+	}
+
+	// the default console callback prints to stdout, where the report goes
+	void PrintLogMessageError(Core::CLogMessage* logMessage)
+	{
+		fprintf(stderr, "%s\n", logMessage->message.c_str());
+	}
+
+	int PrintUsage()
+	{
+		fprintf(stderr, "usage: bench [--platforms <n>] [--boulders <n>] [--scripts <n>] [--seed <n>] [--frames <n>] "
+		                "[--step <seconds>] [--output <file.json>] [--level <file>] [--replay <file>] [--async-physics <0|1>] "
+		                "[--binary-log <0|1>]\n");
+		return EXIT_FAILURE;
+	}
+
+	bool ParseArguments(int argc, char** argv, BenchParams& params)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			if (i + 1 >= argc)
+			{
+				return false;
+			}
+
+			const char* option = argv[i];
+			const char* value = argv[++i];
+			if (strcmp(option, "--platforms") == 0)
+			{
+				params.scene.platforms = atoi(value);
+			}
+			else if (strcmp(option, "--boulders") == 0)
+			{
+				params.scene.boulders = atoi(value);
+			}
+			else if (strcmp(option, "--scripts") == 0)
+			{
+				params.scene.scripts = atoi(value);
+			}
+			else if (strcmp(option, "--seed") == 0)
+			{
+				params.scene.seed = (unsigned int)strtoul(value, nullptr, 10);
+			}
+			else if (strcmp(option, "--frames") == 0)
+			{
+				params.frames = atoi(value);
+			}
+			else if (strcmp(option, "--step") == 0)
+			{
+				params.step = (float)atof(value);
+			}
+			else if (strcmp(option, "--output") == 0)
+			{
+				params.outputPath = value;
+			}
+			else if (strcmp(option, "--level") == 0)
+			{
+				params.levelPath = value;
+			}
+			else if (strcmp(option, "--replay") == 0)
+			{
+				params.replayPath = value;
+			}
+			else if (strcmp(option, "--async-physics") == 0)
+			{
+				params.isAsyncPhysics = atoi(value) != 0;
+			}
+			else if (strcmp(option, "--binary-log") == 0)
+			{
+				params.isBinaryLog = atoi(value) != 0;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return params.scene.platforms >= 0 && params.scene.boulders >= 0 && params.scene.scripts >= 0
+			&& params.frames >= 0 && params.step > 0.f;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchParams params;
+	if (ParseArguments(argc, argv, params) == false)
+	{
+		return PrintUsage();
+	}
+
+	Core::SetLogCallback(PrintLogMessageError);
+	Core::SetAssertCallback(PrintLogMessageError);
+	if (params.isBinaryLog)
+	{
+		Core::SetLogFileFormat(Core::ELogFileFormat::BINARY);
+	}
+
+	PROFILE_THREAD("Main");
+	Core::FrameStats::SetSpikeDumpEnabled(false); // the whole run is reported
+
+	Physics::InitPhysics();
+
+	if (params.levelPath.empty())
+	{
+		Core::World::Initialize();
+		CreateBenchScene(params.scene);
+	}
+	else
+	{
+		Core::World::Initialize(params.levelPath.c_str());
+	}
+
+	Core::GameLoop::SetSimulationRate(1.f / params.step);
+	Core::GameLoop::SetAsyncPhysics(params.isAsyncPhysics);
+	if (params.replayPath.empty() == false)
+	{
+		if (Core::GameLoop::ReplayInputs(params.replayPath.c_str()) == false)
+		{
+			fprintf(stderr, "could not replay \"%s\"\n", params.replayPath.c_str());
+			return EXIT_FAILURE;
+		}
+
+		params.step = Core::GameLoop::GetFixedStep();
+		if (params.frames == 0 || params.frames > (int)Core::GameLoop::GetRecordedStepCount())
+		{
+			params.frames = (int)Core::GameLoop::GetRecordedStepCount();
+		}
+	}
+	else if (params.frames == 0)
+	{
+		params.frames = 1000;
+	}
+
+	Core::World::Start();
+
+	const auto start = std::chrono::steady_clock::now();
+
+	// headless : exactly one fixed step per frame, as fast as possible
+	Core::GameLoop gameLoop;
+	gameLoop.Run(params.frames);
+
+	const double totalMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	const std::string report = FormatReport(params, totalMilliseconds);
+
+	Core::World::Stop();
+	Core::FlushLog();
+
+	if (params.outputPath.empty())
+	{
+		fwrite(report.data(), 1, report.size(), stdout);
+		return EXIT_SUCCESS;
+	}
+
+	std::ofstream file(params.outputPath, std::ios::out | std::ios::binary);
+	file.write(report.data(), (std::streamsize)report.size());
+	if (file.good() == false)
+	{
+		fprintf(stderr, "could not write \"%s\"\n", params.outputPath.c_str());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
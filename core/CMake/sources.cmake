@@ -6,14 +6,16 @@ sources/core/CLog.cpp
 sources/core/CLog.doc.h
 sources/core/CLog.h
 sources/core/Constant.h
-sources/core/DebugWindow/BenchmarkValue.cpp
-sources/core/DebugWindow/BenchmarkValue.h
 sources/core/DebugWindow/DebugSection.cpp
 sources/core/DebugWindow/DebugSection.h
 sources/core/DebugWindow/DebugWatchValue.cpp
 sources/core/DebugWindow/DebugWatchValue.h
 sources/core/DebugWindow/DebugWindow.cpp
 sources/core/DebugWindow/DebugWindow.h
+sources/core/DebugWindow/FrameStats.cpp
+sources/core/DebugWindow/FrameStats.h
+sources/core/DebugWindow/Profiler.cpp
+sources/core/DebugWindow/Profiler.h
 sources/core/Delegate.h
 sources/core/ECS/Component.h
 sources/core/ECS/Entity.cpp
@@ -23,13 +25,19 @@ sources/core/ECS/Event.cpp
 sources/core/ECS/Event.h
 sources/core/ECS/Handle.h
 sources/core/ECS/HasFunction.h
+sources/core/ECS/LevelFormat.cpp
+sources/core/ECS/LevelFormat.h
 sources/core/ECS/Macro.h
 sources/core/ECS/System.h
 sources/core/ECS/template/CompTemplate.h
 sources/core/ECS/World.cpp
 sources/core/ECS/World.h
+sources/core/ECS/WorldSnapshot.cpp
+sources/core/ECS/WorldSnapshot.h
 sources/core/File.cpp
 sources/core/File.h
+sources/core/FramePacer.cpp
+sources/core/FramePacer.h
 sources/core/filesys/Config.cpp
 sources/core/filesys/Config.doc.h
 sources/core/filesys/Config.h
@@ -40,11 +48,17 @@ sources/core/filesys/MemoryMappedFile.h
 sources/core/Flag.h
 sources/core/GameLoop.cpp
 sources/core/GameLoop.h
+sources/core/GameLoopFrontend.h
 sources/core/InputManager/DefaultInputManager.cpp
 sources/core/InputManager/DefaultInputManager.h
+sources/core/InputManager/InputEventRing.h
 sources/core/InputManager/InputManager.doc.h
 sources/core/InputManager/InputManager.h
 sources/core/InputManager/InputManager.inl
+sources/core/InputManager/InputRecording.cpp
+sources/core/InputManager/InputRecording.h
+sources/core/LogFormat.cpp
+sources/core/LogFormat.h
 sources/core/PoolAllocator.cpp
 sources/core/PoolAllocator.doc.h
 sources/core/PoolAllocator.h
@@ -1,11 +1,12 @@
 #include <ctime>
 
-#include <direct.h>
-
 #include "CLog.h"
 
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 
 namespace Core
@@ -19,48 +20,315 @@ namespace Core
         filePath = file;
     }
 
-    CLog::CLog()
+    CLog::CLog() :
+        queue(new LogSlot[QUEUE_SIZE])
     {
-        const std::string configText(IS_RELEASE ? "release_" : "debug_");
-        const std::string file = "log_" + configText + LogTime(true) + ".txt";
+        for (size_t i = 0; i < QUEUE_SIZE; i++)
+        {
+            queue[i].sequence.store(i, std::memory_order_relaxed);
+        }
 
-        OpenFile(file);
+        OpenFile(LogFileName(ELogFileFormat::TEXT), ELogFileFormat::TEXT); // binary is opt-in, see SetFileFormat()
         SetCallback(PrintLogMessageConsole);
         SetAssertCallback(PrintLogMessageConsole);
+
+        isRunning.store(true, std::memory_order_release);
+        writerThread = std::thread(&CLog::WriterLoop, this);
     }
 
     CLog::~CLog()
     {
+        isRunning.store(false, std::memory_order_release);
+        if (writerThread.joinable())
+        {
+            writerThread.join(); // the writer drains the queue before leaving
+        }
+
         if (logFile.is_open())
         {
             logFile.close();
         }
     }
 
-    void CLog::LogMessage(const ELogLevel level, const std::string& message, int line, const char* file, const ELogChannel channel)
+    void CLog::LogMessage(const ELogLevel level, std::string message, int line, const char* file, const ELogChannel channel)
+    {
+        LogRecord record;
+        record.time = std::chrono::system_clock::now();
+        record.message = std::move(message);
+        record.filePath = file;
+        record.logLine = line;
+        record.level = level;
+        record.channel = channel;
+
+        Push(record);
+    }
+
+    void CLog::Push(LogRecord& record)
     {
-        const std::string messageFormatted(FormatMessage(level, message, channel));
+        if (TryPush(record))
+        {
+            return;
+        }
+
+        if (record.level != ELogLevel::CLOG_ERROR || isRunning.load(std::memory_order_acquire) == false)
+        {
+            droppedCount.fetch_add(1, std::memory_order_relaxed); // reported by the writer thread
+            return;
+        }
 
+        if (std::this_thread::get_id() == writerThread.get_id())
         {
-            std::lock_guard<std::mutex> lock(logMutex);
+            // a callback logging while the queue is full, the writer cannot wait for itself : written with the next batch
+            writerOverflow.push_back(std::move(record));
+            return;
+        }
 
-            if (logFile.is_open())
+        const auto deadline = std::chrono::steady_clock::now() + ERROR_PUSH_TIMEOUT;
+        while (TryPush(record) == false)
+        {
+            if (isRunning.load(std::memory_order_acquire) == false || std::chrono::steady_clock::now() >= deadline)
             {
-                logFile << messageFormatted << std::endl;
+                droppedCount.fetch_add(1, std::memory_order_relaxed); // the writer is stuck, most likely in a callback
+                return;
             }
 
-            logMessages.emplace_back(level, messageFormatted, line, file, channel);
+            std::this_thread::yield();
+        }
+    }
 
-            if(callbackLog != nullptr)
-            callbackLog(&logMessages.back());
+    void CLog::Flush()
+    {
+        if (std::this_thread::get_id() == writerThread.get_id())
+        {
+            return;
+        }
+
+        const size_t target = enqueuePos.load(std::memory_order_acquire);
+        while (isRunning.load(std::memory_order_acquire)
+            && writtenPos.load(std::memory_order_acquire) < target)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool CLog::TryPush(LogRecord& record)
+    {
+        size_t position = enqueuePos.load(std::memory_order_relaxed);
+        LogSlot* slot;
+
+        while (true)
+        {
+            slot = &queue[position & (QUEUE_SIZE - 1)];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const ptrdiff_t difference = (ptrdiff_t)sequence - (ptrdiff_t)position;
+
+            if (difference == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // the writer has not consumed this slot yet
+            }
+            else
+            {
+                position = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->record = std::move(record);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool CLog::TryPop(LogRecord& record)
+    {
+        const size_t position = dequeuePos.load(std::memory_order_relaxed);
+        LogSlot& slot = queue[position & (QUEUE_SIZE - 1)];
+
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+        {
+            return false; // empty, or the producer has not finished writing the slot
+        }
+
+        record = std::move(slot.record);
+        slot.sequence.store(position + QUEUE_SIZE, std::memory_order_release);
+        dequeuePos.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void CLog::WriterLoop()
+    {
+        while (true)
+        {
+            const bool isStopping = isRunning.load(std::memory_order_acquire) == false;
+
+            if (WriteBatch() == 0)
+            {
+                if (isStopping)
+                {
+                    return;
+                }
+
+                std::this_thread::sleep_for(WRITER_SLEEP);
+            }
+        }
+    }
+
+    size_t CLog::WriteBatch()
+    {
+        std::vector<LogRecord> records;
+
+        LogRecord record;
+        while (records.size() < QUEUE_SIZE && TryPop(record))
+        {
+            records.push_back(std::move(record));
+        }
+
+        for (LogRecord& overflowRecord : writerOverflow) // logged after the queued records
+        {
+            records.push_back(std::move(overflowRecord));
+        }
+        writerOverflow.clear();
+
+        if (const size_t dropped = droppedCount.exchange(0, std::memory_order_relaxed))
+        {
+            record = LogRecord();
+            record.time = std::chrono::system_clock::now();
+            record.message = FormatString("%zu log messages dropped, the log queue was full", dropped);
+            record.filePath = __FILE__;
+            record.logLine = __LINE__;
+            record.level = ELogLevel::CLOG_WARNING;
+            records.push_back(std::move(record));
+        }
+
+        if (records.empty() == false)
+        {
+            std::vector<CLogMessage> batch;
+            batch.reserve(records.size());
+            std::string out;
+
+            {
+                std::lock_guard<std::mutex> lock(fileMutex);
+
+                for (LogRecord& logRecord : records)
+                {
+                    std::string message = logRecord.site
+                        ? LogFormat::Render(logRecord.site->format, logRecord.arguments.data, logRecord.arguments.size)
+                        : std::move(logRecord.message);
+                    std::string formatted = FormatMessage(logRecord, message);
+
+                    if (fileFormat == ELogFileFormat::BINARY)
+                    {
+                        WriteBinary(logRecord, message, out);
+                    }
+                    else
+                    {
+                        out.append(formatted).push_back('\n');
+                    }
+
+                    batch.emplace_back(logRecord.level, formatted, logRecord.logLine, logRecord.filePath, logRecord.channel);
+                }
+
+                if (logFile.is_open())
+                {
+                    logFile.write(out.data(), (std::streamsize)out.size());
+                    logFile.flush(); // once per batch instead of once per line
+                }
+            }
+
+            for (CLogMessage& message : batch)
+            {
+                Dispatch(message);
+            }
+        }
+
+        writtenPos.store(dequeuePos.load(std::memory_order_relaxed), std::memory_order_release);
+
+        return records.size();
+    }
+
+    void CLog::WriteBinary(const LogRecord& record, const std::string& message, std::string& out)
+    {
+        const void* siteKey = record.site ? (const void*)record.site : (const void*)record.filePath;
+        const int siteLine = record.site ? 0 : record.logLine;
+
+        auto [it, isNewSite] = binarySites.try_emplace({siteKey, siteLine}, (unsigned int)binarySites.size());
+        if (isNewSite)
+        {
+            const char* file = record.filePath ? record.filePath : "";
+            const char* format = record.site ? record.site->format : "%s";
+            const unsigned short fileLength = (unsigned short)std::min<size_t>(strlen(file), 0xFFFF);
+            const unsigned short formatLength = (unsigned short)std::min<size_t>(strlen(format), 0xFFFF);
+
+            out.push_back((char)LogFormat::ERecord::SITE);
+            out.append((const char*)&it->second, sizeof(it->second));
+            out.append((const char*)&record.logLine, sizeof(record.logLine));
+            out.append((const char*)&fileLength, sizeof(fileLength));
+            out.append(file, fileLength);
+            out.append((const char*)&formatLength, sizeof(formatLength));
+            out.append(format, formatLength);
+        }
+
+        const long long ticks = record.time.time_since_epoch().count();
+        const unsigned char level = (unsigned char)record.level;
+        const unsigned char channel = (unsigned char)record.channel;
+
+        out.push_back((char)LogFormat::ERecord::MESSAGE);
+        out.append((const char*)&it->second, sizeof(it->second));
+        out.push_back((char)level);
+        out.push_back((char)channel);
+        out.append((const char*)&ticks, sizeof(ticks));
+
+        if (record.site)
+        {
+            out.append((const char*)&record.arguments.size, sizeof(record.arguments.size));
+            out.append(record.arguments.data, record.arguments.size);
+        }
+        else // the whole message is a single string argument
+        {
+            const unsigned short length = (unsigned short)std::min<size_t>(message.size(), 0xFFFF - 3);
+            const unsigned short size = (unsigned short)(1 + sizeof(length) + length);
+
+            out.append((const char*)&size, sizeof(size));
+            out.push_back((char)LogFormat::EArgument::STRING);
+            out.append((const char*)&length, sizeof(length));
+            out.append(message.data(), length);
+        }
+    }
+
+    void CLog::Dispatch(CLogMessage& message)
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+
+        logMessages.push_back(message);
+        if (logMessages.size() > HISTORY_SIZE)
+        {
+            logMessages.pop_front();
+        }
+
+        if (callbackLog != nullptr)
+        {
+            callbackLog(&message);
         }
     }
 
     std::string CLog::LogTime(const bool cleanString)
     {
-        time_t timestamp = time(nullptr);
+        return LogTime(time(nullptr), cleanString);
+    }
+
+    std::string CLog::LogTime(time_t timestamp, const bool cleanString)
+    {
         struct tm timeInfos {};
-        const errno_t err = localtime_s(&timeInfos, &timestamp);
+#ifdef _WIN32
+        const bool err = localtime_s(&timeInfos, &timestamp) != 0;
+#else
+        const bool err = localtime_r(&timestamp, &timeInfos) == nullptr;
+#endif
         char buffer[80];
         std::string formattedDate;
         if (!err)
@@ -79,21 +347,74 @@ namespace Core
         return formattedDate;
     }
 
+    std::vector<CLogMessage> CLog::GetLogMessages() const
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+
+        return std::vector<CLogMessage>(logMessages.begin(), logMessages.end());
+    }
+
     void CLog::SetCallback(const std::function<void(CLogMessage*)>& callback)
     {
+        std::lock_guard<std::mutex> lock(logMutex);
         callbackLog = callback;
     }
 
     void CLog::SetAssertCallback(const std::function<void(CLogMessage*)>& callback)
     {
+        std::lock_guard<std::mutex> lock(logMutex);
         assertCallback = callback;
     }
 
-    void CLog::OpenFile(const std::string& filepath)
+    void CLog::SetFileFormat(const ELogFileFormat format)
+    {
+        {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            if (format == fileFormat)
+            {
+                return;
+            }
+        }
+
+        Flush(); // the queued messages go to the previous file
+        OpenFile(LogFileName(format), format);
+    }
+
+    std::string CLog::LogFileName(const ELogFileFormat format)
+    {
+        const std::string configText(IS_RELEASE ? "release_" : "debug_");
+        return "log_" + configText + LogTime(true) +
+            (format == ELogFileFormat::BINARY ? LogFormat::FILE_EXTENSION : ".txt");
+    }
+
+    void CLog::OpenFile(const std::string& filepath, const ELogFileFormat format)
     {
         const std::string& logSubDirectory = CreateDirectories();
 
-        logFile.open(logSubDirectory + filepath);
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (logFile.is_open())
+        {
+            logFile.close();
+        }
+
+        fileFormat = format;
+        binarySites.clear();
+
+        if (format == ELogFileFormat::BINARY)
+        {
+            logFile.open(logSubDirectory + filepath, std::ios::out | std::ios::binary);
+
+            LogFormat::FileHeader header{};
+            memcpy(header.magic, LogFormat::MAGIC, sizeof(header.magic));
+            header.version = LogFormat::VERSION;
+            header.tickNumerator = std::chrono::system_clock::period::num;
+            header.tickDenominator = std::chrono::system_clock::period::den;
+            logFile.write((const char*)&header, sizeof(header));
+        }
+        else
+        {
+            logFile.open(logSubDirectory + filepath);
+        }
     }
 
     std::string CLog::CreateDirectories()
@@ -101,18 +422,28 @@ namespace Core
         std::string logSubDirectory(IS_RELEASE ? "Release" : "Debug");
         logSubDirectory = "Logs/" + logSubDirectory + "/";
 
-        if (!_mkdir("Logs")) // create logs directory
-        {}
-        if (!_mkdir(logSubDirectory.c_str())) // create debug or release sub-directory
-        {}
+        std::error_code error; // already there is fine, a failure shows when the file is opened
+        std::filesystem::create_directories(logSubDirectory, error);
 
         return logSubDirectory;
     }
 
-    std::string CLog::FormatMessage(const ELogLevel level, const std::string& message, const ELogChannel channel) const
+    std::string CLog::FormatMessage(const LogRecord& record, const std::string& message)
     {
-        return "[" + LogTime() + "] " + logChannels[static_cast<int>(channel)] + " " +
-            logLevels[static_cast<int>(level)] + " : " + message + "";
+        const time_t timestamp = std::chrono::system_clock::to_time_t(record.time);
+        if (timestamp != cachedTime || cachedTimeText.empty())
+        {
+            cachedTime = timestamp;
+            cachedTimeText = LogTime(timestamp);
+        }
+
+        std::string formatted;
+        formatted.reserve(cachedTimeText.size() + message.size() + 48);
+        formatted.append("[").append(cachedTimeText).append("] ")
+                 .append(LogFormat::CHANNEL_NAMES[static_cast<int>(record.channel)]).append(" ")
+                 .append(LogFormat::LEVEL_NAMES[static_cast<int>(record.level)]).append(" : ")
+                 .append(message);
+        return formatted;
     }
 
     CLog& GetLogSingleton()
@@ -132,22 +463,39 @@ namespace Core
         GetLogSingleton().SetAssertCallback(assertCallback);
     }
 
-    void Log(const ELogLevel level, const std::string& message, const int line, const char* file, const ELogChannel channel)
+    void Log(const ELogLevel level, std::string message, const int line, const char* file, const ELogChannel channel)
     {
-        GetLogSingleton().LogMessage(level, message, line, file, channel);
+        GetLogSingleton().LogMessage(level, std::move(message), line, file, channel);
     }
 
     void Assert(bool statement, const std::string& failMessage, const int line, const char* file, const ELogChannel channel)
     {
         if(!statement)
         {
-            GetLogSingleton().LogMessage(LOG_ERROR, failMessage, line, file, channel);
-            GetLogSingleton().assertCallback(&GetLogMessages(LOG_ERROR, channel).back());
+            CLog& log = GetLogSingleton();
+            log.LogMessage(LOG_ERROR, failMessage, line, file, channel);
+            log.Flush(); // the message must reach the file before the assert stops the program
+
+            CLogMessage message(LOG_ERROR, failMessage, line, file, channel);
+            if (log.assertCallback != nullptr)
+            {
+                log.assertCallback(&message);
+            }
             assert(false);
         }
     }
 
-    const std::vector<CLogMessage>& GetLogMessages()
+    void SetLogFileFormat(const ELogFileFormat format)
+    {
+        GetLogSingleton().SetFileFormat(format);
+    }
+
+    void FlushLog()
+    {
+        GetLogSingleton().Flush();
+    }
+
+    std::vector<CLogMessage> GetLogMessages()
     {
         return GetLogSingleton().GetLogMessages();
     }
@@ -1,5 +1,6 @@
 #pragma once
 #include <fstream>
+#include <deque>
 #include <functional>
 #include <sstream>
 #include <vector>
@@ -67,7 +68,9 @@ namespace Core
 
         /**
          * Internal function to add a specified message to the current log file and print it to the console with a given level.
-         * Current time and date will automatically be appended to the message.
+         * The message is pushed in a lock-free queue and returns immediately: the writer thread adds the time and date, writes
+         * the file in batches and calls the callback. When the queue is full, errors wait for a free slot and other levels are
+         * dropped (the number of dropped messages is logged afterward).
          *
          * @param level - Message level
          * @param message - Message to log and print
@@ -84,11 +87,16 @@ namespace Core
         static std::string  LogTime(bool cleanString = false);
 
         /**
-         * Retrieves all current messages.
+         * Blocks until every message logged before the call is written to the file and dispatched to the callback.
+         */
+        void                Flush();
+
+        /**
+         * Retrieves a copy of the last HISTORY_SIZE messages.
          *
          * @return Logged messaged
          */
-        [[nodiscard]] std::vector<CLogMessage> GetLogMessages() const { return logMessages; }
+        [[nodiscard]] std::vector<CLogMessage> GetLogMessages() const;
 
         /**
          * Sets a new callback function to call whenever a message is added to logs.
@@ -99,13 +107,16 @@ namespace Core
 
         /**
          * Open a file with the specified filepath.
+         * In BINARY format the file holds LogFormat records (call sites, timestamp ticks and raw LOGF arguments)
+         * that are rendered and filtered offline by the logdecoder tool. Release builds log in BINARY format.
          * 
          * @param filepath - Filepath of the file to open/create
+         * @param format - TEXT or BINARY
          */
-        void                OpenFile(const std::string& filepath);
+        void                OpenFile(const std::string& filepath, ELogFileFormat format = ELogFileFormat::TEXT);
 
         /**
-         * Callback function called every time a message is added to the log.
+         * Callback function called every time a message is added to the log. Called from the writer thread.
          */
         std::function<void(CLogMessage*)> callbackLog;
 
@@ -138,19 +149,14 @@ namespace Core
         std::ofstream   logFile;
 
         /**
-         * List of different severity levels name corresponding to their ELogLevel index.
+         * Cached date of the last formatted message, the date is only formatted once per second.
          */
-        std::string     logLevels[4]{ "Debug", "Info", "Warning", "Error" };
+        std::string     cachedTimeText;
 
         /**
-         * List of different channels name corresponding to their ELogChannel index.
+         * Last HISTORY_SIZE messages, for the console window.
          */
-        std::string     logChannels[7]{ "General", "Editor", "Render", "Network", "Vulkan General", "Vulkan Validation", "Vulkan Performance" };
-
-        /**
-         * Vector of every messages received since the start of the editor.
-         */
-        std::vector<CLogMessage> logMessages;
+        std::deque<CLogMessage> logMessages;
     };
 
     /**
@@ -211,11 +217,16 @@ namespace Core
      void    Assert(bool statement, const std::string& failMessage, ELogChannel channel = ELogChannel::CLOG_GENERAL);
 
     /**
-     * Returns all current log messages from the global logger.
+     * Blocks until every message logged so far by the global logger is written.
+     */
+     void    FlushLog();
+
+    /**
+     * Returns a copy of the last log messages from the global logger.
      *
-     * @return All log messages
+     * @return Last log messages
      */
-     const std::vector<CLogMessage>&    GetLogMessages();
+     std::vector<CLogMessage>    GetLogMessages();
 
     /**
      * Returns all current log messages from the global logger corresponding to a specified level and channel (default all channels)
@@ -1,9 +1,17 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <fstream>
 #include <functional>
+#include <memory>
+#include <thread>
 #include <vector>
+#include <map>
 #include <mutex>
 
+#include "LogFormat.h"
+
 #define ID(x) x
 #define GET_MACRO(_1, _2, _3, NAME, ...) NAME
 /**
@@ -14,11 +22,18 @@
  * ASSERT(Boolean Statement, Fail message, Channel(optional))
  */
 #define ASSERT(...) ID(GET_MACRO(__VA_ARGS__, ASSERT3, ASSERT2)(__VA_ARGS__))
+/**
+ * LOGF(Level, Channel, printf format literal, arguments...)
+ * The arguments are captured raw and formatted on the writer thread (or by logdecoder for binary log files)
+ */
+#define LOGF(level, channel, format, ...) do { static constexpr Core::LogSite __log_site__{format, __FILE__, __LINE__};\
+	LOGF_IF(level) Core::LogFormatted(level, channel, __log_site__, ##__VA_ARGS__); } while (false)
 
 #ifndef _SHIPPING
 constexpr bool IS_RELEASE = false;
 #define LOG2(level, message) Log(level, message, __LINE__, __FILE__)
 #define LOG3(level, message, channel) Log(level, message, __LINE__, __FILE__, channel)
+#define LOGF_IF(level)
 #else
 constexpr bool IS_RELEASE = true;
 #ifndef LOG_MIN_LEVEL // Minimum required level to log messages
@@ -26,6 +41,7 @@ constexpr bool IS_RELEASE = true;
 #endif
 #define LOG2(level, message) if constexpr ((int)(level) >= LOG_MIN_LEVEL) Log(level, message, __LINE__, __FILE__)
 #define LOG3(level, message, channel) if constexpr ((int)(level) >= LOG_MIN_LEVEL) Log(level, message, __LINE__, __FILE__, channel)
+#define LOGF_IF(level) if constexpr ((int)(level) >= LOG_MIN_LEVEL)
 #endif
 
 #define ASSERT2(statement, message) Core::Assert(statement, message, __LINE__, __FILE__)
@@ -61,6 +77,19 @@ namespace Core
 		CLOG_ERROR
 	};
 
+	enum class ELogFileFormat
+	{
+		TEXT,
+		BINARY // LogFormat records, read with the logdecoder tool
+	};
+
+	struct LogSite // one per LOGF call, never copied
+	{
+		const char* format;
+		const char* file;
+		int line;
+	};
+
 	struct CLogMessage
 	{
 		CLogMessage() = delete;
@@ -85,16 +114,26 @@ namespace Core
 		CLog& operator=(const CLog&) = delete;
 		CLog& operator=(CLog&&) = delete;
 
-		void LogMessage(ELogLevel level, const std::string& message, int line, const char* file, ELogChannel channel);
+		// queue the message for the writer thread, the caller never waits on the file or the callbacks
+		void LogMessage(ELogLevel level, std::string message, int line, const char* file, ELogChannel channel);
+
+		template <typename ... Args>
+		void LogFormatted(ELogLevel level, ELogChannel channel, const LogSite& site, const Args& ... args);
+
+		void Flush(); // wait until every message queued so far is written and dispatched
 
 		static std::string LogTime(bool cleanString = false);
+		static std::string LogTime(time_t timestamp, bool cleanString = false);
 
-		[[nodiscard]] const std::vector<CLogMessage>& GetLogMessages() const { return logMessages; }
+		[[nodiscard]] std::vector<CLogMessage> GetLogMessages() const; // copy of the last HISTORY_SIZE messages
 
+		// callbacks are called from the writer thread
 		void SetCallback(const std::function<void(CLogMessage*)>&);
 		void SetAssertCallback(const std::function<void(CLogMessage*)>&);
 
-		void OpenFile(const std::string& filepath);
+		void OpenFile(const std::string& filepath, ELogFileFormat format = ELogFileFormat::TEXT);
+		// text by default, binary is smaller and cheaper to write but needs logdecoder : continues in a new file
+		void SetFileFormat(ELogFileFormat format);
 
 		template <typename ... Args>
 		static std::string FormatString(const std::string& format, Args ... args)
@@ -108,23 +147,81 @@ namespace Core
 		std::function<void(CLogMessage*)> callbackLog;
 		std::function<void(CLogMessage*)> assertCallback;
 	private:
+		struct LogRecord // formatted on the writer thread
+		{
+			std::chrono::system_clock::time_point time;
+			std::string message;
+			const char* filePath = nullptr;
+			int logLine = 0;
+			ELogLevel level = ELogLevel::CLOG_INFO;
+			ELogChannel channel = ELogChannel::CLOG_GENERAL;
+			const LogSite* site = nullptr; // LOGF : message is empty and the arguments are not formatted yet
+			LogFormat::Arguments arguments;
+		};
+
+		struct LogSlot
+		{
+			std::atomic<size_t> sequence;
+			LogRecord record;
+		};
+
+		static constexpr size_t QUEUE_SIZE = 4096; // power of two
+		static constexpr size_t HISTORY_SIZE = 4096;
+		static constexpr std::chrono::milliseconds WRITER_SLEEP{2};
+		static constexpr std::chrono::milliseconds ERROR_PUSH_TIMEOUT{100}; // an error waits that long for a free slot
 
 		static std::string CreateDirectories();
+		static std::string LogFileName(ELogFileFormat format);
 
-		[[nodiscard]] std::string FormatMessage(ELogLevel level, const std::string& message, ELogChannel channel) const;
+		[[nodiscard]] std::string FormatMessage(const LogRecord& record, const std::string& message);
+		void WriteBinary(const LogRecord& record, const std::string& message, std::string& out);
 
-		std::ofstream logFile;
-		inline static std::string logLevels[4]{"Debug", "Info", "Warning", "Error"};
-		inline static std::string logChannels[static_cast<int>(ELogChannel::CLOG_ALL_CHANNELS)]{
-			"General", "Editor", "Render", "Network", "Physics", "Vulkan General", "Vulkan Validation",
-			"Vulkan Performance", "ECS", "Script", "Sound", "Reflection", "Model"
-		};
+		void Push(LogRecord& record);
 
-		std::vector<CLogMessage> logMessages;
+		bool TryPush(LogRecord& record); // multiple producers, false if the queue is full
+		bool TryPop(LogRecord& record); // writer thread only
+		void WriterLoop();
+		size_t WriteBatch();
+		void Dispatch(CLogMessage& message);
 
-		std::mutex logMutex;
+		std::ofstream logFile;
+		ELogFileFormat fileFormat = ELogFileFormat::TEXT;
+		std::map<std::pair<const void*, int>, unsigned int> binarySites; // (site or file, line) -> SITE record id
+		std::mutex fileMutex;
+		static_assert(LogFormat::CHANNEL_COUNT == static_cast<int>(ELogChannel::CLOG_ALL_CHANNELS));
+
+		time_t cachedTime = 0; // the text date only changes once per second
+		std::string cachedTimeText;
+
+		std::unique_ptr<LogSlot[]> queue;
+		std::atomic<size_t> enqueuePos{0};
+		std::atomic<size_t> dequeuePos{0};
+		std::atomic<size_t> writtenPos{0};
+		std::atomic<size_t> droppedCount{0};
+		std::vector<LogRecord> writerOverflow; // writer thread only : errors logged by the callbacks while the queue is full
+
+		std::deque<CLogMessage> logMessages;
+		mutable std::mutex logMutex; // history and callbacks, never taken by LogMessage()
+
+		std::atomic<bool> isRunning{false};
+		std::thread writerThread;
 	};
 
+	template <typename ... Args>
+	void CLog::LogFormatted(ELogLevel level, ELogChannel channel, const LogSite& site, const Args& ... args)
+	{
+		LogRecord record;
+		record.time = std::chrono::system_clock::now();
+		record.filePath = site.file;
+		record.logLine = site.line;
+		record.level = level;
+		record.channel = channel;
+		record.site = &site;
+		record.arguments.Add(args...);
+
+		Push(record);
+	}
+
 	CLog& GetLogSingleton();
 
 	inline void PrintLogMessageConsole(CLogMessage* logMessage) { printf("%s\n", logMessage->message.c_str()); }
@@ -133,13 +230,23 @@ namespace Core
 
 	void SetAssertCallback(const std::function<void(CLogMessage*)>& = PrintLogMessageConsole);
 
-	void Log(ELogLevel level, const std::string& message, int line, const char* file,
+	template <typename ... Args>
+	void LogFormatted(ELogLevel level, ELogChannel channel, const LogSite& site, const Args& ... args)
+	{
+		GetLogSingleton().LogFormatted(level, channel, site, args...);
+	}
+
+	void Log(ELogLevel level, std::string message, int line, const char* file,
 	                     ELogChannel channel = ELogChannel::CLOG_GENERAL);
 
 	void Assert(bool statement, const std::string& failMessage, int line, const char* file,
 	                        ELogChannel channel = ELogChannel::CLOG_GENERAL);
 
-	const std::vector<CLogMessage>& GetLogMessages();
+	void SetLogFileFormat(ELogFileFormat format);
+
+	void FlushLog();
+
+	std::vector<CLogMessage> GetLogMessages();
 
 	std::vector<CLogMessage> GetLogMessages(ELogLevel level,
 	                                                    ELogChannel channel = ELogChannel::CLOG_ALL_CHANNELS);
@@ -149,3 +256,4 @@ namespace Core
 #define LOG_WARNING Core::ELogLevel::CLOG_WARNING
 #define LOG_INFO Core::ELogLevel::CLOG_INFO
 #define LOG_DEBUG Core::ELogLevel::CLOG_DEBUG
+
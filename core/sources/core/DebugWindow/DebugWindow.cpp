@@ -28,35 +28,8 @@ namespace Core
 		}
 	}
 
-	void DebugWindow::StartBenchmark(const std::string& name)
-	{
-		const auto it = std::find(defaultDebugWindow.benchmarkValues.begin(),
-		                          defaultDebugWindow.benchmarkValues.end(), name);
-
-		if (it == defaultDebugWindow.benchmarkValues.end())
-			defaultDebugWindow.benchmarkValues.emplace_back(name).StartTimer();
-		else
-			it->StartTimer();
-	}
-
-	void DebugWindow::StopBenchmark(const std::string& name)
-	{
-		const auto it = std::find(defaultDebugWindow.benchmarkValues.begin(),
-		                          defaultDebugWindow.benchmarkValues.end(), name);
-
-		if (it == defaultDebugWindow.benchmarkValues.end())
-			defaultDebugWindow.benchmarkValues.emplace_back(name).StopTimer();
-		else
-			it->StopTimer();
-	}
-
 	const std::vector<DebugSection>& DebugWindow::GetSections()
 	{
 		return defaultDebugWindow.debugSections;
 	}
-
-	const std::vector<BenchmarkValue>& DebugWindow::GetBenchmarkValues()
-	{
-		return defaultDebugWindow.benchmarkValues;
-	}
 }
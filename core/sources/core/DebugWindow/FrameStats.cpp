@@ -0,0 +1,114 @@
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Core
+{
+	unsigned int Histogram::BucketIndex(unsigned long long microseconds)
+	{
+		if (microseconds < LINEAR_BUCKETS)
+		{
+			return (unsigned int)microseconds;
+		}
+
+		unsigned int exponent = 5; // highest set bit, LINEAR_BUCKETS == 1 << 5
+		while (exponent < MAX_EXPONENT && (microseconds >> (exponent + 1)) != 0)
+		{
+			exponent++;
+		}
+		if (exponent == MAX_EXPONENT)
+		{
+			return BUCKET_COUNT - 1;
+		}
+
+		const unsigned int subBucket = (unsigned int)(microseconds >> (exponent - 4)) & (SUB_BUCKETS - 1);
+		return LINEAR_BUCKETS + (exponent - 5) * SUB_BUCKETS + subBucket;
+	}
+
+	float Histogram::BucketUpperBound(unsigned int index)
+	{
+		if (index < LINEAR_BUCKETS)
+		{
+			return (float)(index + 1) / 1000.f;
+		}
+
+		const unsigned int exponent = 5 + (index - LINEAR_BUCKETS) / SUB_BUCKETS;
+		const unsigned int subBucket = (index - LINEAR_BUCKETS) % SUB_BUCKETS;
+		return (float)((unsigned long long)(SUB_BUCKETS + subBucket + 1) << (exponent - 4)) / 1000.f;
+	}
+
+	void Histogram::Add(float milliseconds)
+	{
+		milliseconds = std::max(milliseconds, 0.f);
+
+		buckets[BucketIndex((unsigned long long)(milliseconds * 1000.f))]++;
+		count++;
+		totalMilliseconds += milliseconds;
+		maxMilliseconds = std::max(maxMilliseconds, milliseconds);
+	}
+
+	void Histogram::Reset()
+	{
+		*this = Histogram();
+	}
+
+	float Histogram::Percentile(float percent) const
+	{
+		if (count == 0)
+		{
+			return 0.f;
+		}
+
+		const double rank = std::ceil((double)std::clamp(percent, 0.f, 100.f) / 100.0 * (double)count);
+		const unsigned long long target = std::max(1ull, (unsigned long long)rank);
+
+		unsigned long long seen = 0;
+		for (unsigned int i = 0; i < BUCKET_COUNT; i++)
+		{
+			seen += buckets[i];
+			if (seen >= target)
+			{
+				// the last bucket has no upper bound
+				return i == BUCKET_COUNT - 1 ? maxMilliseconds : std::min(BucketUpperBound(i), maxMilliseconds);
+			}
+		}
+		return maxMilliseconds;
+	}
+
+	void FrameStats::SetSpikeThreshold(float milliseconds, float medianFactor)
+	{
+		spikeMilliseconds = milliseconds;
+		spikeMedianFactor = medianFactor;
+	}
+
+	bool FrameStats::AddFrame(float milliseconds)
+	{
+		const bool isWarm = frameHistogram.GetCount() >= WARMUP_FRAMES;
+		const float median = frameHistogram.Percentile(50.f);
+
+		frameHistogram.Add(milliseconds);
+		framesSinceDump++;
+
+		if (isWarm == false || milliseconds <= spikeMilliseconds || milliseconds <= median * spikeMedianFactor)
+		{
+			return false;
+		}
+
+		spikeCount++;
+		if (isDumpEnabled == false || framesSinceDump < SPIKE_COOLDOWN)
+		{
+			return false; // still counted, but a hitch repeating every frame must not flood the disk
+		}
+
+		framesSinceDump = 0;
+		return true;
+	}
+
+	void FrameStats::Reset()
+	{
+		frameHistogram.Reset();
+		spikeCount = 0;
+		framesSinceDump = SPIKE_COOLDOWN;
+	}
+}
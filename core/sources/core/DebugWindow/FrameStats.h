@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+
+namespace Core
+{
+	// Streaming histogram of durations in milliseconds, fixed size whatever the number of samples.
+	// Buckets are linear below 32 us then 16 per power of two, so percentiles are within ~6% of the exact value.
+	class Histogram
+	{
+	public:
+		static constexpr unsigned int LINEAR_BUCKETS = 32; // 1 us each
+		static constexpr unsigned int SUB_BUCKETS = 16; // per power of two
+		static constexpr unsigned int MAX_EXPONENT = 25; // 2^25 us, about 33 s, longer samples go to the last bucket
+		static constexpr unsigned int BUCKET_COUNT = LINEAR_BUCKETS + (MAX_EXPONENT - 5) * SUB_BUCKETS;
+
+		void Add(float milliseconds);
+		void Reset();
+
+		// percent in [0, 100], upper bound of the bucket holding the percentile, 0 when empty
+		[[nodiscard]] float Percentile(float percent) const;
+		[[nodiscard]] float GetMax() const { return maxMilliseconds; }
+		[[nodiscard]] float GetMean() const { return count ? (float)(totalMilliseconds / (double)count) : 0.f; }
+		[[nodiscard]] unsigned long long GetCount() const { return count; }
+
+	private:
+		static unsigned int BucketIndex(unsigned long long microseconds);
+		static float BucketUpperBound(unsigned int index);
+
+		unsigned int buckets[BUCKET_COUNT] = {};
+		unsigned long long count = 0;
+		double totalMilliseconds = 0.0;
+		float maxMilliseconds = 0.f;
+	};
+
+	// Frame time histogram and spike detection, fed by Profiler::MarkFrame.
+	// Active in every build so hitches can be diagnosed from the dumps left in the logs directory.
+	class FrameStats
+	{
+	public:
+		static constexpr unsigned long long WARMUP_FRAMES = 120; // loading frames are not compared to the median
+		static constexpr unsigned long long SPIKE_COOLDOWN = 300; // frames between two spike dumps
+		static constexpr unsigned int DUMP_FRAMES = 120; // frames written before the spike
+
+		// a frame is a spike when it is longer than both thresholds
+		static void SetSpikeThreshold(float milliseconds, float medianFactor);
+		static void SetSpikeDumpEnabled(bool isEnabled) { isDumpEnabled = isEnabled; }
+
+		// returns true when the frame is a spike that should be dumped
+		static bool AddFrame(float milliseconds);
+		static void Reset();
+
+		static const Histogram& GetFrameHistogram() { return frameHistogram; }
+		static unsigned long long GetSpikeCount() { return spikeCount; }
+		static const std::string& GetLastDumpPath() { return lastDumpPath; }
+		static void SetLastDumpPath(std::string path) { lastDumpPath = std::move(path); }
+
+	private:
+		inline static Histogram frameHistogram;
+		inline static float spikeMilliseconds = 33.f;
+		inline static float spikeMedianFactor = 3.f;
+		inline static bool isDumpEnabled = true;
+
+		inline static unsigned long long spikeCount = 0;
+		inline static unsigned long long framesSinceDump = SPIKE_COOLDOWN;
+		inline static std::string lastDumpPath;
+	};
+}
@@ -0,0 +1,318 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <fstream>
+
+#include "../CLog.h"
+#include "../ThreadPool.h"
+
+namespace Core
+{
+	namespace
+	{
+		const long long processStart = std::chrono::steady_clock::now().time_since_epoch().count();
+
+		double ToMicroseconds(long long ticks)
+		{
+			return (double)(ticks - processStart) * 1e6 * std::chrono::steady_clock::period::num
+				/ std::chrono::steady_clock::period::den;
+		}
+
+		void AppendJsonString(std::string& out, const char* str)
+		{
+			out.push_back('"');
+			for (; *str != '\0'; str++)
+			{
+				switch (*str)
+				{
+				case '"':
+					out.append("\\\"");
+					break;
+				case '\\':
+					out.append("\\\\");
+					break;
+				default:
+					if ((unsigned char)*str >= 0x20)
+					{
+						out.push_back(*str);
+					}
+					break;
+				}
+			}
+			out.push_back('"');
+		}
+
+		float ToMilliseconds(long long ticks)
+		{
+			return (float)((double)ticks * 1e3 * std::chrono::steady_clock::period::num / std::chrono::steady_clock::period::den);
+		}
+	}
+
+	long long Profiler::Now()
+	{
+		return std::chrono::steady_clock::now().time_since_epoch().count();
+	}
+
+	Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+	{
+		thread_local ThreadBuffer* buffer = RegisterThread();
+		return *buffer;
+	}
+
+	Profiler::ThreadBuffer* Profiler::RegisterThread()
+	{
+		std::lock_guard<std::mutex> lock(threadsMutex);
+
+		// kept after the thread exits so its zones can still be exported
+		threads.push_back(std::make_unique<ThreadBuffer>());
+		ThreadBuffer* buffer = threads.back().get();
+		buffer->id = (unsigned int)threads.size();
+		buffer->name = "Thread " + std::to_string(buffer->id);
+		return buffer;
+	}
+
+	void Profiler::BeginZone(const Zone& zone)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		if (buffer.depth < MAX_DEPTH)
+		{
+			buffer.stack[buffer.depth] = {&zone, Now()};
+		}
+		buffer.depth++;
+	}
+
+	void Profiler::EndZone()
+	{
+		const long long end = Now();
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		if (buffer.depth == 0)
+		{
+			return;
+		}
+
+		buffer.depth--;
+		if (buffer.depth >= MAX_DEPTH)
+		{
+			return; // too deep, not recorded
+		}
+
+		const OpenZone& open = buffer.stack[buffer.depth];
+		const size_t index = buffer.writeCount.load(std::memory_order_relaxed);
+		buffer.events[index & (EVENT_CAPACITY - 1)] = {open.zone, open.begin, end, buffer.depth};
+		buffer.writeCount.store(index + 1, std::memory_order_release);
+	}
+
+	void Profiler::SetThreadName(const std::string& name)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		buffer.name = name;
+	}
+
+	size_t Profiler::CopyEvents(const ThreadBuffer& buffer, size_t first, size_t last, std::vector<Event>& out)
+	{
+		if (last - first > EVENT_CAPACITY)
+		{
+			first = last - EVENT_CAPACITY;
+		}
+
+		const size_t copyStart = out.size();
+		for (size_t i = first; i < last; i++)
+		{
+			out.push_back(buffer.events[i & (EVENT_CAPACITY - 1)]);
+		}
+
+		// the owner thread may have wrapped around while copying : drop what it overwrote
+		const size_t writeCount = buffer.writeCount.load(std::memory_order_acquire);
+		if (writeCount > first + EVENT_CAPACITY)
+		{
+			const size_t overwritten = std::min(writeCount - EVENT_CAPACITY - first, last - first);
+			out.erase(out.begin() + (ptrdiff_t)copyStart, out.begin() + (ptrdiff_t)(copyStart + overwritten));
+			first += overwritten;
+		}
+
+		return first;
+	}
+
+	void Profiler::MarkFrame()
+	{
+		const long long frameStart = Now();
+		frameStarts[frameCount % FRAME_CAPACITY] = frameStart;
+
+		std::vector<float> frameTotals(zoneHistories.size(), 0.f);
+		std::vector<char> zoneRan(zoneHistories.size(), 0);
+		std::vector<Event> events;
+		{
+			std::lock_guard<std::mutex> lock(threadsMutex);
+
+			for (const std::unique_ptr<ThreadBuffer>& buffer : threads)
+			{
+				const size_t writeCount = buffer->writeCount.load(std::memory_order_acquire);
+				CopyEvents(*buffer, buffer->aggregatedCount, writeCount, events);
+				buffer->aggregatedCount = writeCount;
+			}
+		}
+
+		for (const Event& event : events)
+		{
+			auto [it, isNewZone] = zoneHistoryIndices.try_emplace(event.zone, zoneHistories.size());
+			if (isNewZone)
+			{
+				ZoneHistory& history = zoneHistories.emplace_back();
+				history.zone = event.zone;
+				std::fill(std::begin(history.milliseconds), std::end(history.milliseconds), 0.f);
+				frameTotals.push_back(0.f);
+				zoneRan.push_back(0);
+			}
+
+			frameTotals[it->second] += ToMilliseconds(event.end - event.begin);
+			zoneRan[it->second] = 1;
+		}
+
+		// the frame that just ended replaces the oldest one
+		const int offset = GetHistoryOffset();
+		for (size_t i = 0; i < zoneHistories.size(); i++)
+		{
+			zoneHistories[i].milliseconds[offset] = frameTotals[i];
+			if (zoneRan[i])
+			{
+				zoneHistories[i].histogram.Add(frameTotals[i]);
+			}
+		}
+
+		const float frameMilliseconds = frameCount > 0
+			? ToMilliseconds(frameStart - frameStarts[(frameCount - 1) % FRAME_CAPACITY]) : 0.f;
+		const bool isSpike = frameCount > 0 && FrameStats::AddFrame(frameMilliseconds);
+
+		frameCount++;
+
+		if (isSpike)
+		{
+			DumpSpike(frameMilliseconds);
+		}
+	}
+
+	void Profiler::ResetStats()
+	{
+		for (ZoneHistory& history : zoneHistories)
+		{
+			history.histogram.Reset();
+		}
+		FrameStats::Reset();
+	}
+
+	void Profiler::DumpSpike(float frameMilliseconds)
+	{
+		// the spike is the frame before the one that just started, both of their markers are dumped
+		const unsigned long long spikeFrame = frameCount - 2;
+		const unsigned long long dumpedFrames = std::min<unsigned long long>(FrameStats::DUMP_FRAMES, spikeFrame);
+		auto capture = std::make_shared<TraceCapture>();
+		CaptureTrace(spikeFrame - dumpedFrames, *capture);
+
+		std::string filePath = "Logs/spike_" + CLog::LogTime(true) + "_" + std::to_string(spikeFrame) + ".json";
+		LOGF(LOG_WARNING, ELogChannel::CLOG_GENERAL, "Frame spike: %.2f ms (p50 %.2f ms), last %llu frames dumped to %s",
+		     frameMilliseconds, FrameStats::GetFrameHistogram().Percentile(50.f), dumpedFrames, filePath);
+		FrameStats::SetLastDumpPath(filePath);
+
+		// formatting the json takes a few milliseconds, which would make the next frame a hitch too
+		ThreadPool::GetDefaultThreadPool().AddTask([capture, filePath = std::move(filePath)]
+		{
+			if (WriteChromeTrace(*capture, filePath) == false)
+			{
+				LOGF(LOG_WARNING, ELogChannel::CLOG_GENERAL, "Could not write the spike dump %s", filePath);
+			}
+		});
+	}
+
+	float Profiler::GetLastMilliseconds(const ZoneHistory& history)
+	{
+		return history.milliseconds[(GetHistoryOffset() + HISTORY_SIZE - 1) % HISTORY_SIZE];
+	}
+
+	void Profiler::CaptureTrace(unsigned long long firstFrame, TraceCapture& capture)
+	{
+		// the whole rings for a full export, the start of the first frame may already be overwritten
+		const long long firstTick = firstFrame > 0 ? frameStarts[firstFrame % FRAME_CAPACITY] : LLONG_MIN;
+		firstFrame = std::max(firstFrame, frameCount > FRAME_CAPACITY ? frameCount - FRAME_CAPACITY : 0);
+
+		capture.firstFrame = firstFrame;
+		capture.frameStarts.clear();
+		for (unsigned long long frame = firstFrame; frame < frameCount; frame++)
+		{
+			capture.frameStarts.push_back(frameStarts[frame % FRAME_CAPACITY]);
+		}
+
+		std::lock_guard<std::mutex> lock(threadsMutex);
+
+		capture.threads.clear();
+		for (const std::unique_ptr<ThreadBuffer>& thread : threads)
+		{
+			ThreadCapture& threadCapture = capture.threads.emplace_back();
+			threadCapture.name = thread->name;
+			threadCapture.id = thread->id;
+
+			CopyEvents(*thread, 0, thread->writeCount.load(std::memory_order_acquire), threadCapture.events);
+			threadCapture.events.erase(std::remove_if(threadCapture.events.begin(), threadCapture.events.end(),
+				[firstTick](const Event& event) { return event.end < firstTick; }), threadCapture.events.end());
+		}
+	}
+
+	bool Profiler::WriteChromeTrace(const TraceCapture& capture, const std::string& filePath)
+	{
+		std::ofstream file(filePath, std::ios::out | std::ios::binary);
+		if (file.is_open() == false)
+		{
+			return false;
+		}
+
+		std::string json("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+		char buffer[128];
+
+		for (const ThreadCapture& thread : capture.threads)
+		{
+			json.append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":")
+			    .append(std::to_string(thread.id)).append(",\"args\":{\"name\":");
+			AppendJsonString(json, thread.name.c_str());
+			json.append("}},\n");
+
+			for (const Event& event : thread.events)
+			{
+				json.append("{\"name\":");
+				AppendJsonString(json, event.zone->name);
+				snprintf(buffer, sizeof(buffer), ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"file\":",
+				         thread.id, ToMicroseconds(event.begin), ToMicroseconds(event.end) - ToMicroseconds(event.begin));
+				json.append(buffer);
+				AppendJsonString(json, event.zone->file);
+				json.append(",\"line\":").append(std::to_string(event.zone->line)).append("}},\n");
+			}
+		}
+
+		for (size_t i = 0; i < capture.frameStarts.size(); i++)
+		{
+			snprintf(buffer, sizeof(buffer), "{\"name\":\"Frame %llu\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":%.3f},\n",
+			         capture.firstFrame + i, ToMicroseconds(capture.frameStarts[i]));
+			json.append(buffer);
+		}
+
+		if (json.back() == '\n' && json[json.size() - 2] == ',')
+		{
+			json.erase(json.size() - 2, 1); // trailing comma
+		}
+		json.append("]}\n");
+
+		file.write(json.data(), (std::streamsize)json.size());
+		return file.good();
+	}
+
+	bool Profiler::ExportChromeTrace(const std::string& filePath)
+	{
+		TraceCapture capture;
+		CaptureTrace(0, capture);
+		return WriteChromeTrace(capture, filePath);
+	}
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "FrameStats.h"
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+// kept in shipping builds for the frame statistics and spike dumps, define PROFILER_DISABLED to compile the zones out
+#ifndef PROFILER_DISABLED
+/**
+ * PROFILE_ZONE(name literal) : time the rest of the enclosing scope
+ */
+#define PROFILE_ZONE(name) PROFILE_ZONE_IMPL(name, __COUNTER__)
+#define PROFILE_ZONE_IMPL(name, counter)\
+	static constexpr Core::Profiler::Zone PROFILE_CONCAT(__profile_zone_, counter){name, __FILE__, __LINE__, Core::Profiler::ZoneId(name)};\
+	const Core::Profiler::ScopedZone PROFILE_CONCAT(__profile_scope_, counter)(PROFILE_CONCAT(__profile_zone_, counter))
+#else
+#define PROFILE_ZONE(name)
+#endif
+
+/**
+ * PROFILE_FRAME() : mark the start of a new frame, call once per frame on the main thread
+ */
+#define PROFILE_FRAME() Core::Profiler::MarkFrame()
+/**
+ * PROFILE_THREAD(name) : name the calling thread on the timeline
+ */
+#define PROFILE_THREAD(name) Core::Profiler::SetThreadName(name)
+
+namespace Core
+{
+	// Scoped CPU zones recorded per thread in lock-free ring buffers, without any lookup by name.
+	// The last EVENT_CAPACITY zones of every thread can be exported to the chrome trace event format
+	// (chrome://tracing, ui.perfetto.dev) and the main thread aggregates them per frame for the debug window.
+	class Profiler
+	{
+	public:
+		static constexpr int HISTORY_SIZE = 256;
+		static constexpr size_t EVENT_CAPACITY = 8192; // per thread, power of two
+		static constexpr unsigned int MAX_DEPTH = 64;
+
+		struct Zone // one static instance per PROFILE_ZONE, its address identifies the zone
+		{
+			const char* name;
+			const char* file;
+			int line;
+			unsigned long long id; // same for every zone with this name, stable between runs
+		};
+
+		class ScopedZone
+		{
+		public:
+			explicit ScopedZone(const Zone& zone) { BeginZone(zone); }
+			ScopedZone(const ScopedZone&) = delete;
+			ScopedZone(ScopedZone&&) = delete;
+			~ScopedZone() { EndZone(); }
+
+			ScopedZone& operator=(const ScopedZone&) = delete;
+			ScopedZone& operator=(ScopedZone&&) = delete;
+		};
+
+		struct ZoneHistory
+		{
+			const Zone* zone;
+			float milliseconds[HISTORY_SIZE]; // total time per frame, ring indexed like GetHistoryOffset()
+			Histogram histogram; // total time of the frames the zone ran in
+		};
+
+		static constexpr unsigned long long ZoneId(const char* name)
+		{
+			unsigned long long hash = 14695981039346656037ull;
+			while (*name != '\0')
+			{
+				hash ^= (unsigned char)*name++;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		static void BeginZone(const Zone& zone);
+		static void EndZone();
+
+		static void SetThreadName(const std::string& name);
+
+		static void MarkFrame();
+		static unsigned long long GetFrameIndex() { return frameCount; }
+
+		// main thread only
+		static const std::vector<ZoneHistory>& GetZoneHistories() { return zoneHistories; }
+		static int GetHistoryOffset() { return (int)(frameCount % HISTORY_SIZE); } // index of the oldest frame
+		static float GetLastMilliseconds(const ZoneHistory& history);
+
+		static bool ExportChromeTrace(const std::string& filePath);
+		static void ResetStats(); // clears the zone and frame histograms
+
+	private:
+		struct Event
+		{
+			const Zone* zone;
+			long long begin;
+			long long end;
+			unsigned int depth;
+		};
+
+		struct ThreadCapture
+		{
+			std::string name;
+			unsigned int id;
+			std::vector<Event> events;
+		};
+
+		struct TraceCapture // copy of the rings, written to disk outside of the main thread for the spike dumps
+		{
+			std::vector<ThreadCapture> threads;
+			unsigned long long firstFrame;
+			std::vector<long long> frameStarts;
+		};
+
+		struct OpenZone
+		{
+			const Zone* zone;
+			long long begin;
+		};
+
+		struct ThreadBuffer // written by its thread only
+		{
+			std::string name;
+			unsigned int id = 0;
+
+			Event events[EVENT_CAPACITY];
+			std::atomic<size_t> writeCount{0};
+
+			OpenZone stack[MAX_DEPTH];
+			unsigned int depth = 0;
+
+			size_t aggregatedCount = 0; // main thread, events already added to the zone histories
+		};
+
+		static constexpr size_t FRAME_CAPACITY = 1024;
+
+		static long long Now();
+		static ThreadBuffer& GetThreadBuffer();
+		static ThreadBuffer* RegisterThread();
+
+		// copy the events [first, last) still in the ring, return the index of the first copied event
+		static size_t CopyEvents(const ThreadBuffer& buffer, size_t first, size_t last, std::vector<Event>& out);
+
+		// main thread, events ending after the start of firstFrame
+		static void CaptureTrace(unsigned long long firstFrame, TraceCapture& capture);
+		static bool WriteChromeTrace(const TraceCapture& capture, const std::string& filePath);
+		static void DumpSpike(float frameMilliseconds);
+
+		inline static std::mutex threadsMutex; // taken when a thread is registered and by the main thread readers
+		inline static std::vector<std::unique_ptr<ThreadBuffer>> threads;
+
+		inline static long long frameStarts[FRAME_CAPACITY] = {};
+		inline static unsigned long long frameCount = 0;
+
+		inline static std::vector<ZoneHistory> zoneHistories;
+		inline static std::unordered_map<const Zone*, size_t> zoneHistoryIndices;
+	};
+}
@@ -1,49 +1,266 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "functional"
 
-#define DELEGATE_INTERNAL(DEL, DEL_NAME, PARAMS, PARAM_NAMES, PARAMS_COUNT) \
-class On##DEL_NAME{ \
-	public:  \
-		std::vector<DEL> delegates; \
-		static constexpr int paramsCount = PARAMS_COUNT;\
-	public: \
-		On##DEL_NAME(){delegates.reserve(2);} \
-		On##DEL_NAME & operator +=(DEL func) { delegates.push_back(func); return *this; } \
-		void Add(DEL func) { delegates.push_back(func); }\
-		void Broadcast PARAMS { for (int __DEL##INDEX = 0; \
-		__DEL##INDEX < delegates.size() && delegates.size() < 50; __DEL##INDEX++) (delegates[__DEL##INDEX])PARAM_NAMES; } \
-		void ClearDelegates()\
-		{\
-		    delegates.clear();\
-		}\
-		template <typename A, typename B>\
-        void Add(A function, B object) {\
-            if constexpr (paramsCount == 0) { Add(std::bind(function, object)); return; }\
-            if constexpr (paramsCount == 1) { Add(std::bind(function, object, std::placeholders::_1)); return; }\
-            if constexpr (paramsCount == 2) { Add(std::bind(function, object, std::placeholders::_1, std::placeholders::_2)); return; }\
-            if constexpr (paramsCount == 3) { Add(std::bind(function, object, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)); return; }\
-            if constexpr (paramsCount == 4) { Add(std::bind(function, object, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4)); return; }\
-            if constexpr (paramsCount == 5) { Add(std::bind(function, object, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5)); return; }\
-        }\
-		template <typename A, typename B, typename C>\
-        void Add(A function, B object, C firstArgument) {\
-		    Add(std::bind(function, object, firstArgument));\
-		}\
-		template <typename A, typename B, typename C, typename D>\
-        void Add(A function, B object, C firstArgument, D secondArgument) {\
-		    Add(std::bind(function, object, firstArgument, secondArgument));\
-		}\
+namespace Core
+{
+	class DelegateHandle
+	{
+	public:
+		DelegateHandle() = default;
+		explicit DelegateHandle(unsigned int value) : value(value) {}
+
+		bool operator==(const DelegateHandle& rhs) const { return value == rhs.value; }
+		bool operator!=(const DelegateHandle& rhs) const { return value != rhs.value; }
+
+		bool IsValid() const { return value != INVALID_VALUE; }
+		bool IsNotValid() const { return value == INVALID_VALUE; }
+		unsigned int GetValue() const { return value; }
+
+		static const unsigned int INVALID_VALUE = 0;
+
+	private:
+		unsigned int value = DelegateHandle::INVALID_VALUE;
+	};
+
+	template <typename Signature>
+	class Delegate;
+
+	// Callable stored in place, never allocates : a member function with its object, a function pointer
+	// or a functor up to BUFFER_SIZE bytes (lambda captures, std::bind results)
+	template <typename ... Args>
+	class Delegate<void(Args...)>
+	{
+	public:
+		static constexpr size_t BUFFER_SIZE = 4 * sizeof(void*);
+
+		Delegate() = default;
+
+		template <typename Method, typename Object,
+		          typename = std::enable_if_t<std::is_member_function_pointer_v<Method>>>
+		Delegate(Method method, Object* object) : Delegate(MemberCall<Method, Object>{method, object}) {}
+
+		template <typename Functor,
+		          typename = std::enable_if_t<std::is_same_v<std::decay_t<Functor>, Delegate> == false>>
+		Delegate(Functor&& functor) { Store(std::forward<Functor>(functor)); }
+
+		Delegate(const Delegate& other) { CopyFrom(other); }
+		Delegate& operator=(const Delegate& other)
+		{
+			if (this != &other)
+			{
+				Reset();
+				CopyFrom(other);
+			}
+			return *this;
+		}
+		~Delegate() { Reset(); }
+
+		void operator()(Args... args) const { invoke(buffer, std::forward<Args>(args)...); }
+		explicit operator bool() const { return invoke != nullptr; }
+
+		void Reset()
+		{
+			if (manage)
+			{
+				manage(buffer, nullptr);
+			}
+			invoke = nullptr;
+			manage = nullptr;
+		}
+
+	private:
+		using InvokeFunction = void (*)(void* functor, Args... args);
+		using ManageFunction = void (*)(void* destination, const void* source); // copy, or destroy when source is null
+
+		template <typename Method, typename Object>
+		struct MemberCall
+		{
+			Method method;
+			Object* object;
+
+			void operator()(Args... args) const { (object->*method)(std::forward<Args>(args)...); }
+		};
+
+		template <typename Functor>
+		void Store(Functor&& functor)
+		{
+			using Stored = std::decay_t<Functor>;
+			static_assert(sizeof(Stored) <= BUFFER_SIZE, "delegate functor too large, capture a pointer instead");
+			static_assert(alignof(Stored) <= alignof(void*), "delegate functor over aligned");
+
+			new (buffer) Stored(std::forward<Functor>(functor));
+			invoke = [](void* stored, Args... args) { (*static_cast<Stored*>(stored))(std::forward<Args>(args)...); };
+
+			if constexpr (std::is_trivially_copyable_v<Stored> == false)
+			{
+				manage = [](void* destination, const void* source)
+				{
+					if (source)
+					{
+						new (destination) Stored(*static_cast<const Stored*>(source));
+					}
+					else
+					{
+						static_cast<Stored*>(destination)->~Stored();
+					}
+				};
+			}
+		}
+
+		void CopyFrom(const Delegate& other)
+		{
+			if (other.manage)
+			{
+				other.manage(buffer, other.buffer);
+			}
+			else
+			{
+				memcpy(buffer, other.buffer, BUFFER_SIZE);
+			}
+			invoke = other.invoke;
+			manage = other.manage;
+		}
+
+		alignas(void*) mutable unsigned char buffer[BUFFER_SIZE] = {};
+		InvokeFunction invoke = nullptr;
+		ManageFunction manage = nullptr; // null for trivially copyable functors, copied byte by byte
 	};
 
+	// List of delegates called by Broadcast. Adding or removing delegates from one of them is allowed :
+	// the delegates added during a broadcast are called from the next one, the removed ones are not called anymore
+	template <typename Signature>
+	class MulticastDelegate;
+
+	template <typename ... Args>
+	class MulticastDelegate<void(Args...)>
+	{
+	public:
+		using DelegateType = Delegate<void(Args...)>;
+
+		MulticastDelegate() { entries.reserve(2); }
+
+		DelegateHandle Add(DelegateType delegate)
+		{
+			entries.push_back({std::move(delegate), nextId});
+			return DelegateHandle(nextId++);
+		}
+
+		template <typename Method, typename Object,
+		          typename = std::enable_if_t<std::is_member_function_pointer_v<Method>>>
+		DelegateHandle Add(Method method, Object* object) { return Add(DelegateType(method, object)); }
+
+		// the bound arguments replace the broadcast ones
+		template <typename Method, typename Object, typename First, typename ... Others>
+		DelegateHandle Add(Method method, Object* object, First first, Others ... others)
+		{
+			return Add(DelegateType([method, object, first, others...](Args...) { (object->*method)(first, others...); }));
+		}
+
+		MulticastDelegate& operator+=(DelegateType delegate)
+		{
+			Add(std::move(delegate));
+			return *this;
+		}
+
+		bool Remove(DelegateHandle handle)
+		{
+			for (size_t i = 0; i < entries.size(); i++)
+			{
+				if (entries[i].id != handle.GetValue() || handle.IsNotValid())
+				{
+					continue;
+				}
+
+				if (broadcastDepth > 0)
+				{
+					entries[i].id = DelegateHandle::INVALID_VALUE; // erased once the broadcast is over
+					hasRemovedEntries = true;
+				}
+				else
+				{
+					entries.erase(entries.begin() + (ptrdiff_t)i);
+				}
+				return true;
+			}
+			return false;
+		}
+
+		void ClearDelegates()
+		{
+			if (broadcastDepth == 0)
+			{
+				entries.clear();
+				return;
+			}
+
+			for (Entry& entry : entries)
+			{
+				entry.id = DelegateHandle::INVALID_VALUE;
+			}
+			hasRemovedEntries = true;
+		}
+
+		void Broadcast(Args ... args)
+		{
+			broadcastDepth++;
+
+			const size_t count = entries.size();
+			for (size_t i = 0; i < count; i++)
+			{
+				if (entries[i].id == DelegateHandle::INVALID_VALUE)
+				{
+					continue;
+				}
+
+				// copied, the vector may grow during the call and the delegate may remove itself
+				const DelegateType delegate = entries[i].delegate;
+				delegate(args...);
+			}
+
+			broadcastDepth--;
+			if (broadcastDepth == 0 && hasRemovedEntries)
+			{
+				entries.erase(std::remove_if(entries.begin(), entries.end(),
+					[](const Entry& entry) { return entry.id == DelegateHandle::INVALID_VALUE; }), entries.end());
+				hasRemovedEntries = false;
+			}
+		}
+
+		[[nodiscard]] bool IsEmpty() const { return entries.empty(); }
+
+	private:
+		struct Entry
+		{
+			DelegateType delegate;
+			unsigned int id;
+		};
+
+		std::vector<Entry> entries;
+		unsigned int nextId = 1;
+		unsigned int broadcastDepth = 0;
+		bool hasRemovedEntries = false;
+	};
+}
+
+#define DELEGATE_INTERNAL(SIGNATURE, DEL_NAME) \
+	class On##DEL_NAME : public ::Core::MulticastDelegate<SIGNATURE> {};
+
 #define DELEGATE(DELEGATE)\
-	DELEGATE_INTERNAL(std::function<void(void)>, DELEGATE, (), (), 0)
+	DELEGATE_INTERNAL(void(void), DELEGATE)
 #define DELEGATE_One_Param(DELEGATE, type, arg) \
-    DELEGATE_INTERNAL(std::function<void(type)>, DELEGATE, (type arg), (arg), 1)
+    DELEGATE_INTERNAL(void(type), DELEGATE)
 #define DELEGATE_Two_Params(DELEGATE, type, arg, type2, arg2) \
-    DELEGATE_INTERNAL(std::function<void(type, type2)>, DELEGATE, (type arg, type2 arg2), (arg, arg2), 2)
+    DELEGATE_INTERNAL(void(type, type2), DELEGATE)
 #define DELEGATE_Three_Params(DELEGATE, type, arg, type2, arg2, type3, arg3) \
-    DELEGATE_INTERNAL(std::function<void(type, type2, type3)>, DELEGATE, (type arg, type2 arg2, type3 arg3), (arg, arg2, arg3), 3)
+    DELEGATE_INTERNAL(void(type, type2, type3), DELEGATE)
 #define DELEGATE_Four_Params(DELEGATE, type, arg, type2, arg2, type3, arg3, type4, arg4) \
-    DELEGATE_INTERNAL(std::function<void(type, type2, type3, type4)>, DELEGATE, (type arg, type2 arg2, type3 arg3, type4 arg4), (arg, arg2, arg3, arg4), 4)
+    DELEGATE_INTERNAL(void(type, type2, type3, type4), DELEGATE)
 #define DELEGATE_Five_Params(DELEGATE, type, arg, type2, arg2, type3, arg3, type4, arg4, type5, arg5) \
-    DELEGATE_INTERNAL(std::function<void(type, type2, type3, type4, type5)>, DELEGATE, (type arg, type2 arg2, type3 arg3, type4 arg4, type5 arg5), (arg, arg2, arg3, arg4, arg5), 5)
\ No newline at end of file
+    DELEGATE_INTERNAL(void(type, type2, type3, type4, type5), DELEGATE)
@@ -60,6 +60,20 @@ namespace Core
 
 		static Iterator GetAll() { return Iterator(all); }
 
+		// compile time lookup of the fields reflected by Reflection::ComponentMeta()
+		template<long long pHash>
+		static constexpr auto FindFieldDescriptor()
+		{
+			if constexpr (pHash == ConstexprCustomHash("entityHandle"))
+				return FieldDescriptor<Component, EntityHandle, &Component::entityHandle, pHash>();
+			else if constexpr (pHash == ConstexprCustomHash("isInUse"))
+				return FieldDescriptor<Component, bool, &Component::isInUse, pHash>();
+			else if constexpr (pHash == ConstexprCustomHash("isActive"))
+				return FieldDescriptor<Component, bool, &Component::isActive, pHash>();
+			else
+				return FieldNotFound();
+		}
+
 	protected:
 
 		Component() = default;
@@ -77,6 +91,14 @@ namespace Core
 
 		static int SetupComponent();
 
+		// offset in T of a field of this base, the field found at compile time
+		template<long long pHash>
+		static int FieldOffset()
+		{
+			const long long baseOffset = (long long)static_cast<Component*>((T*)alignof(T)) - (long long)alignof(T);
+			return (int)baseOffset + FindField<Component, pHash>().Offset();
+		}
+
 		EntityHandle entityHandle;
 		bool isInUse = false;
 		bool isActive = false;
@@ -93,9 +115,9 @@ namespace Core
 				Function("CreateComponentFor", "void*", { Parameter("EntityHandle", "handle"), Parameter("const void*", "params") }, true)
 			{}
 
-			void InvokeImpl(void*) const override
+			void InvokeImpl(void*, void* const* args, void* result) const override
 			{
-				*(void**)buffer = CreateComponentFor(*(EntityHandle*)GetParamValue("handle"), *(void**)GetParamValue("params"));
+				Forward<EntityHandle, const void*>(&CreateComponentFor, args, result);
 			}
 		};
 
@@ -105,9 +127,13 @@ namespace Core
 				Function("CreateComponent", "void*", true)
 			{}
 
-			void InvokeImpl(void*) const override
+			void InvokeImpl(void*, void* const*, void* result) const override
 			{
-				*(void**)buffer = CreateComponent();
+				void* component = CreateComponent();
+				if (result != nullptr)
+				{
+					new (result) void*(component);
+				}
 			}
 		};
 
@@ -117,9 +143,9 @@ namespace Core
 				Function("GetComponent", "void*", { Parameter("ComponentHandle", "handle") }, true)
 			{}
 
-			void InvokeImpl(void*) const override
+			void InvokeImpl(void*, void* const* args, void* result) const override
 			{
-				*(void**)buffer = GetComponent(*(ComponentHandle*)GetParamValue("handle"));
+				Forward<ComponentHandle>(&GetComponent, args, result);
 			}
 		};
 
@@ -129,9 +155,9 @@ namespace Core
 				Function("DestroyComponent", "bool", { Parameter("ComponentHandle", "handle") }, true)
 			{}
 
-			void InvokeImpl(void*) const override
+			void InvokeImpl(void*, void* const* args, void* result) const override
 			{
-				*(bool*)buffer = DestroyComponent(*(ComponentHandle*)GetParamValue("handle"));
+				Forward<ComponentHandle>(&DestroyComponent, args, result);
 			}
 		};
 
@@ -141,9 +167,12 @@ namespace Core
 				Function("GetHandle", "ComponentHandle")
 			{}
 
-			void InvokeImpl(void* ref) const override
+			void InvokeImpl(void* ref, void* const*, void* result) const override
 			{
-				*(ComponentHandle*)buffer = ((T*)ref)->GetHandle();
+				if (result != nullptr)
+				{
+					new (result) ComponentHandle(((T*)ref)->GetHandle());
+				}
 			}
 		};
 
@@ -295,7 +324,9 @@ namespace Core
 			World::RegisterComponentForBeginPlay(&T::BeginPlayAllComponent); // todo: use lambda
 		}
 
-		World::RegisterComponentForSerialization(&T::GetRawComponentData, &T::GetNumberOfComponentData, &T::GetMetaData);
+		World::RegisterComponentForSerialization(&T::GetRawComponentData, &T::GetNumberOfComponentData, &T::GetMetaData,
+		                                         FieldOffset<ConstexprCustomHash("entityHandle")>(),
+		                                         FieldOffset<ConstexprCustomHash("isInUse")>());
 
 		return -1;
 	}
@@ -132,12 +132,10 @@ namespace Core
 		}
 
 		const Function* createFunction = compMeta->FindFunction("CreateComponentFor");
-		createFunction->SetParam("handle", &handle);
-		createFunction->SetParam("params", &params);
-		void* component = *(void**)createFunction->Invoke(nullptr).Data;
+		void* component = createFunction->Call<void*>(nullptr, handle, params);
 
 		const Function* getHandleFunction = compMeta->FindFunction("GetHandle");
-		ComponentHandle componentHandle = *(ComponentHandle*)getHandleFunction->Invoke(component).Data;
+		ComponentHandle componentHandle = getHandleFunction->Call<ComponentHandle>(component);
 
 		GetDetail().emplace_back(handle, componentHandle);
 
@@ -199,9 +197,7 @@ namespace Core
 		const Structure* compType = (Structure*)Type::Find(component.GetType());
 		const Function* destroyComponentFunction = compType->FindFunction("DestroyComponent");
 
-		destroyComponentFunction->SetParam("handle", &component);
-
-		return *(bool*)destroyComponentFunction->Invoke(nullptr).Data;
+		return destroyComponentFunction->Call<bool>(nullptr, component);
 	}
 
 	bool Entity::Iterator::Next()
@@ -27,9 +27,7 @@ namespace Core
 			const Structure* compType = (Structure*)Type::Find(componentHandle.GetType());
 			const Function* getComponentFunction = compType->FindFunction("GetComponent");
 
-			getComponentFunction->SetParam("handle", &componentHandle);
-
-			return *(void**)getComponentFunction->Invoke(nullptr).Data;
+			return getComponentFunction->Call<void*>(nullptr, componentHandle);
 		}
 
 		template<typename T>
@@ -2,4 +2,33 @@
 
 namespace Core
 {
+	void EventBus::RegisterQueue(QueueBase* queue)
+	{
+		std::lock_guard<std::mutex> lock(queuesMutex);
+		queues.push_back(queue);
+	}
+
+	void EventBus::DispatchAll()
+	{
+		std::vector<QueueBase*> registered;
+		{
+			// copied, a producer thread may register a new event type meanwhile
+			std::lock_guard<std::mutex> lock(queuesMutex);
+			registered = queues;
+		}
+
+		for (QueueBase* queue : registered)
+		{
+			queue->Dispatch();
+		}
+	}
+
+	void EventBus::ClearAll()
+	{
+		std::lock_guard<std::mutex> lock(queuesMutex);
+		for (QueueBase* queue : queues)
+		{
+			queue->Clear();
+		}
+	}
 }
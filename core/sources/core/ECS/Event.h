@@ -1,15 +1,153 @@
 #pragma once
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "../Delegate.h"
+
 namespace Core
 {
-	class Event
+	// Typed deferred events. Producers enqueue plain structs from any thread into a buffer per event type,
+	// the handlers are called in batch on the main thread when the buffer is dispatched (DispatchAll once per frame in GameLoop).
+	// Events enqueued while dispatching, even by a handler, wait for the next dispatch.
+	class EventBus
 	{
 	public:
+		EventBus() = delete;
+
+		template <typename T>
+		static void Enqueue(T event);
+
+		template <typename T>
+		static DelegateHandle Subscribe(Delegate<void(const T&)> handler) { return GetQueue<T>().handlers.Add(std::move(handler)); }
+		template <typename T>
+		static bool Unsubscribe(DelegateHandle handle) { return GetQueue<T>().handlers.Remove(handle); }
 
-		Event() = default;
-		~Event() = default;
+		// drops the pending events matching the predicate, including the ones of the batch being dispatched
+		// (an event refers to an object destroyed by a previous handler)
+		template <typename T, typename Predicate>
+		static void Discard(Predicate predicate);
+
+		template <typename T>
+		static void Dispatch() { GetQueue<T>().Dispatch(); }
+		static void DispatchAll(); // in the order the event types were first used
+		static void ClearAll();
 
 	private:
+		class QueueBase
+		{
+		public:
+			virtual ~QueueBase() = default;
+			virtual void Dispatch() = 0;
+			virtual void Clear() = 0;
+		};
+
+		template <typename T>
+		class Queue : public QueueBase
+		{
+		public:
+			void Dispatch() override;
+			void Clear() override;
+
+			std::mutex mutex; // pending only, the other members belong to the main thread
+			std::vector<T> pending;
 
+			std::vector<T> dispatching; // swapped with pending, keeps both capacities
+			std::vector<char> isDiscarded;
+			size_t dispatchIndex = 0;
+			bool isDispatching = false;
+
+			MulticastDelegate<void(const T&)> handlers;
+		};
+
+		template <typename T>
+		static Queue<T>& GetQueue();
+		static void RegisterQueue(QueueBase* queue);
+
+		inline static std::mutex queuesMutex;
+		inline static std::vector<QueueBase*> queues; // not owned, function local statics of GetQueue
 	};
-}
\ No newline at end of file
+
+	template <typename T>
+	EventBus::Queue<T>& EventBus::GetQueue()
+	{
+		static Queue<T> queue;
+		static const bool isRegistered = (RegisterQueue(&queue), true);
+		(void)isRegistered;
+		return queue;
+	}
+
+	template <typename T>
+	void EventBus::Enqueue(T event)
+	{
+		Queue<T>& queue = GetQueue<T>();
+
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.pending.push_back(std::move(event));
+	}
+
+	template <typename T, typename Predicate>
+	void EventBus::Discard(Predicate predicate)
+	{
+		Queue<T>& queue = GetQueue<T>();
+
+		if (queue.isDispatching)
+		{
+			for (size_t i = queue.dispatchIndex; i < queue.dispatching.size(); i++)
+			{
+				if (queue.isDiscarded[i] == false && predicate(queue.dispatching[i]))
+				{
+					queue.isDiscarded[i] = true;
+				}
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.pending.erase(std::remove_if(queue.pending.begin(), queue.pending.end(), predicate), queue.pending.end());
+	}
+
+	template <typename T>
+	void EventBus::Queue<T>::Dispatch()
+	{
+		if (isDispatching)
+		{
+			return; // the new events are already waiting for the next dispatch
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (pending.empty())
+			{
+				return;
+			}
+			dispatching.swap(pending);
+		}
+
+		isDispatching = true;
+		isDiscarded.assign(dispatching.size(), false);
+
+		for (dispatchIndex = 0; dispatchIndex < dispatching.size(); dispatchIndex++)
+		{
+			if (isDiscarded[dispatchIndex] == false)
+			{
+				handlers.Broadcast(dispatching[dispatchIndex]);
+			}
+		}
+
+		dispatching.clear();
+		isDispatching = false;
+	}
+
+	template <typename T>
+	void EventBus::Queue<T>::Clear()
+	{
+		if (isDispatching)
+		{
+			isDiscarded.assign(dispatching.size(), true);
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.clear();
+	}
+}
@@ -0,0 +1,374 @@
+#include "LevelFormat.h"
+
+#include <cstring>
+#include <mutex>
+
+#include "Handle.h"
+#include "../reflection/StructMeta.h"
+#include "../CLog.h"
+
+namespace Core::LevelFormat
+{
+	namespace
+	{
+		constexpr unsigned long long FNV_OFFSET = 14695981039346656037ull;
+		constexpr unsigned long long FNV_PRIME = 1099511628211ull;
+
+		void HashBytes(unsigned long long& hash, const void* data, size_t size)
+		{
+			const unsigned char* bytes = (const unsigned char*)data;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= FNV_PRIME;
+			}
+		}
+
+		bool IsStringType(const Type* type)
+		{
+			return type->name.hash == ConstexprCustomHash("string")
+				|| type->name.hash == ConstexprCustomHash("std::string");
+		}
+
+		void Flatten(StructureLayout& layout, const Structure* meta, const std::string& prefix, int baseOffset)
+		{
+			for (StructureField field : meta->GetAllFields())
+			{
+				if (field.flags.include(FieldFlag::TRANSIENT))
+				{
+					continue;
+				}
+
+				std::string name = prefix + field.name->text;
+				int instanceOffset = baseOffset + field.offset;
+
+				if (field.flags.include(FieldFlag::POINTER))
+				{
+					std::string message("attempt to serialize a pointer : skipping serialization for ");
+					message.append(meta->name.text).append("::").append(field.name->text);
+					LOG(LOG_WARNING, message, ELogChannel::CLOG_ECS);
+					continue;
+				}
+
+				EFieldKind kind = EFieldKind::RAW;
+				unsigned int size = 0;
+
+				if (IsStringType(field.type))
+				{
+					kind = EFieldKind::STRING;
+					size = sizeof(unsigned int);
+				}
+				else if (field.type->name.hash == ConstexprCustomHash("EntityHandle"))
+				{
+					kind = EFieldKind::ENTITY_HANDLE;
+					size = sizeof(int);
+				}
+				else if (field.type->name.hash == ConstexprCustomHash("ComponentHandle"))
+				{
+					kind = EFieldKind::COMPONENT_HANDLE;
+					size = COMPONENT_HANDLE_RECORD_SIZE;
+				}
+				else
+				{
+					switch (field.type->category)
+					{
+					case ETypeCategory::ENUMERATION:
+					case ETypeCategory::PRIMITIVE:
+					case ETypeCategory::WRAPPER:
+						size = field.type->size;
+						break;
+					case ETypeCategory::STRUCTURE:
+						Flatten(layout, (const Structure*)field.type, name + ".", instanceOffset);
+						continue;
+					default:
+						{
+							std::string message(
+								"attempt to serialize an unsupported data category : skipping serialization for ");
+							message.append(meta->name.text).append("::").append(field.name->text);
+							LOG(LOG_WARNING, message, ELogChannel::CLOG_ECS);
+							continue;
+						}
+					}
+				}
+
+				layout.fields.push_back({name, field.type, instanceOffset, layout.stride, size, kind});
+				layout.stride += size;
+
+				HashBytes(layout.schemaHash, name.data(), name.size() + 1);
+				HashBytes(layout.schemaHash, field.type->name.text.data(), field.type->name.text.size() + 1);
+				HashBytes(layout.schemaHash, &size, sizeof(size));
+				HashBytes(layout.schemaHash, &kind, sizeof(kind));
+			}
+		}
+
+		template <typename T>
+		bool ReadValue(T& value, const char*& ptr, const char* endPtr)
+		{
+			if ((size_t)(endPtr - ptr) < sizeof(T))
+			{
+				return false;
+			}
+
+			memcpy(&value, ptr, sizeof(T));
+			ptr += sizeof(T);
+			return true;
+		}
+	}
+
+	const StructureLayout& StructureLayout::Get(const Structure* meta)
+	{
+		static std::mutex layoutsMutex;
+		static std::unordered_map<const Structure*, StructureLayout> layouts;
+
+		std::lock_guard<std::mutex> lock(layoutsMutex);
+
+		auto it = layouts.find(meta);
+		if (it == layouts.end())
+		{
+			it = layouts.emplace(meta, Build(meta)).first;
+		}
+		return it->second;
+	}
+
+	StructureLayout StructureLayout::Build(const Structure* meta)
+	{
+		StructureLayout layout;
+		layout.schemaHash = FNV_OFFSET;
+		Flatten(layout, meta, "", 0);
+
+		for (const FieldLayout& field : layout.fields)
+		{
+			if (field.kind == EFieldKind::RAW && layout.ops.empty() == false)
+			{
+				SerializeOp& last = layout.ops.back();
+				if (last.kind == EFieldKind::RAW
+					&& last.instanceOffset + (int)last.size == field.instanceOffset
+					&& last.recordOffset + last.size == field.recordOffset)
+				{
+					last.size += field.size;
+					continue;
+				}
+			}
+
+			layout.ops.push_back({field.kind, field.instanceOffset, field.recordOffset, field.size});
+		}
+
+		return layout;
+	}
+
+	void StructureLayout::WriteRecord(const char* instance, char* record, StringTable& strings) const
+	{
+		for (const SerializeOp& op : ops)
+		{
+			const char* source = instance + op.instanceOffset;
+			char* target = record + op.recordOffset;
+
+			if (op.kind == EFieldKind::STRING)
+			{
+				unsigned int stringIndex = strings.Add(*(const std::string*)source);
+				memcpy(target, &stringIndex, sizeof(stringIndex));
+			}
+			else if (op.kind == EFieldKind::COMPONENT_HANDLE)
+			{
+				const ComponentHandle& handle = *(const ComponentHandle*)source;
+				WriteComponentHandle(target, handle.GetValue(), handle.GetType());
+			}
+			else
+			{
+				memcpy(target, source, op.size); // handles are saved as is and remapped on load
+			}
+		}
+	}
+
+	void WriteComponentHandle(char* record, const int value, const long long type)
+	{
+		memset(record, 0, COMPONENT_HANDLE_RECORD_SIZE);
+		memcpy(record + COMPONENT_HANDLE_VALUE_OFFSET, &value, sizeof(value));
+		memcpy(record + COMPONENT_HANDLE_TYPE_OFFSET, &type, sizeof(type));
+	}
+
+	void ReadComponentHandle(const char* record, int& value, long long& type)
+	{
+		memcpy(&value, record + COMPONENT_HANDLE_VALUE_OFFSET, sizeof(value));
+		memcpy(&type, record + COMPONENT_HANDLE_TYPE_OFFSET, sizeof(type));
+	}
+
+	unsigned int StringTable::Add(const std::string& str)
+	{
+		auto [it, inserted] = indices.try_emplace(str, (unsigned int)indices.size());
+		if (inserted)
+		{
+			data.append(str);
+			offsets.push_back((unsigned int)data.size());
+		}
+		return it->second;
+	}
+
+	void StringTable::Write(std::vector<char>& out) const
+	{
+		Append(out, (unsigned int)indices.size());
+		const char* offsetBytes = (const char*)offsets.data();
+		out.insert(out.end(), offsetBytes, offsetBytes + offsets.size() * sizeof(unsigned int));
+		out.insert(out.end(), data.begin(), data.end());
+	}
+
+	bool StringTableView::Read(const char* payload, size_t size)
+	{
+		const char* ptr = payload;
+		const char* endPtr = payload + size;
+
+		unsigned int count;
+		if (ReadValue(count, ptr, endPtr) == false
+			|| (size_t)(endPtr - ptr) < ((size_t)count + 1) * sizeof(unsigned int))
+		{
+			return false;
+		}
+
+		offsets.resize((size_t)count + 1);
+		memcpy(offsets.data(), ptr, offsets.size() * sizeof(unsigned int));
+		ptr += offsets.size() * sizeof(unsigned int);
+		data = ptr;
+
+		return offsets.back() <= (size_t)(endPtr - ptr);
+	}
+
+	std::string StringTableView::Get(unsigned int index) const
+	{
+		if (index >= Count())
+		{
+			return std::string();
+		}
+		return std::string(data + offsets[index], offsets[index + 1] - offsets[index]);
+	}
+
+	bool StringTableView::Equals(unsigned int index, const std::string& str) const
+	{
+		if (index >= Count())
+		{
+			return false;
+		}
+		return str.size() == offsets[index + 1] - offsets[index]
+			&& memcmp(data + offsets[index], str.data(), str.size()) == 0;
+	}
+
+	LevelReader::LevelReader(const char* data, size_t size)
+	{
+		if (IsLevelFormat(data, size) == false)
+		{
+			return;
+		}
+
+		const char* ptr = data;
+		const char* endPtr = data + size;
+
+		LevelHeader header;
+		ReadValue(header, ptr, endPtr);
+		version = header.version;
+		if (version == 0 || version > VERSION)
+		{
+			LOG(LOG_ERROR, CLog::FormatString("unsupported level version %u (expected %u)", header.version, VERSION),
+			    ELogChannel::CLOG_ECS);
+			return;
+		}
+
+		for (unsigned int i = 0; i < header.chunkCount; i++)
+		{
+			ChunkHeader chunk;
+			if (ReadValue(chunk, ptr, endPtr) == false || chunk.size > (size_t)(endPtr - ptr))
+			{
+				LOG(LOG_ERROR, "truncated level file", ELogChannel::CLOG_ECS);
+				return;
+			}
+
+			bool isChunkValid = true;
+			switch (chunk.id)
+			{
+			case CHUNK_STRINGS:
+				isChunkValid = strings.Read(ptr, chunk.size);
+				break;
+			case CHUNK_NODES:
+				isChunkValid = ReadNodes(ptr, chunk.size);
+				break;
+			case CHUNK_COMPONENTS:
+				isChunkValid = ReadComponentBlock(ptr, chunk.size);
+				break;
+			default:
+				break;
+			}
+
+			if (isChunkValid == false)
+			{
+				LOG(LOG_ERROR, "corrupted level chunk", ELogChannel::CLOG_ECS);
+				return;
+			}
+
+			ptr += chunk.size;
+		}
+
+		isValid = nodes.empty() == false;
+	}
+
+	bool LevelReader::IsLevelFormat(const char* data, size_t size)
+	{
+		return data && size >= sizeof(LevelHeader) && memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+	}
+
+	bool LevelReader::ReadNodes(const char* payload, size_t size)
+	{
+		const char* ptr = payload;
+		const char* endPtr = payload + size;
+
+		unsigned int count;
+		if (ReadValue(count, ptr, endPtr) == false || (size_t)(endPtr - ptr) < (size_t)count * sizeof(NodeRecord))
+		{
+			return false;
+		}
+
+		nodes.resize(count);
+		memcpy(nodes.data(), ptr, (size_t)count * sizeof(NodeRecord));
+		return true;
+	}
+
+	bool LevelReader::ReadComponentBlock(const char* payload, size_t size)
+	{
+		const char* ptr = payload;
+		const char* endPtr = payload + size;
+
+		ComponentBlockView block;
+		if (ReadValue(block.header, ptr, endPtr) == false
+			|| (size_t)(endPtr - ptr) < (size_t)block.header.fieldCount * sizeof(FieldRecord))
+		{
+			return false;
+		}
+
+		block.fields.resize(block.header.fieldCount);
+		memcpy(block.fields.data(), ptr, block.fields.size() * sizeof(FieldRecord));
+		ptr += block.fields.size() * sizeof(FieldRecord);
+
+		const size_t recordsSize = (size_t)block.header.count * block.header.stride;
+		const size_t indicesSize = version >= 2 ? (size_t)block.header.count * sizeof(int) : 0;
+		if ((size_t)(endPtr - ptr) < recordsSize + indicesSize)
+		{
+			return false;
+		}
+
+		for (const FieldRecord& field : block.fields)
+		{
+			if ((size_t)field.recordOffset + field.size > block.header.stride)
+			{
+				return false;
+			}
+		}
+
+		block.records = ptr;
+		block.indices = indicesSize ? ptr + recordsSize : nullptr;
+		componentBlocks.push_back(std::move(block));
+		return true;
+	}
+
+	void AppendChunk(std::vector<char>& out, unsigned int id, const std::vector<char>& payload)
+	{
+		Append(out, ChunkHeader{id, (unsigned int)payload.size()});
+		out.insert(out.end(), payload.begin(), payload.end());
+	}
+}
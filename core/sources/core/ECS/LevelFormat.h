@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Quaternion/Quaternion.h"
+#include "Vector/Vector3.h"
+
+namespace Core
+{
+	class Structure;
+	struct Type;
+
+	// Binary level layout (native endianness) :
+	//   LevelHeader
+	//   chunkCount x { ChunkHeader, payload[ChunkHeader::size] }
+	// Unknown chunks are skipped and files written by an older VERSION stay readable.
+	namespace LevelFormat
+	{
+		constexpr unsigned int MakeChunkId(const char (&id)[5])
+		{
+			return (unsigned int)id[0] | (unsigned int)id[1] << 8 | (unsigned int)id[2] << 16 | (unsigned int)id[3] << 24;
+		}
+
+		constexpr char MAGIC[4] = {'C', 'E', 'L', 'V'};
+		constexpr unsigned int VERSION = 2; // 2 : component blocks end with the saved component index of each record
+		constexpr unsigned int INVALID_INDEX = 0xFFFFFFFF;
+
+		constexpr unsigned int CHUNK_STRINGS = MakeChunkId("STRS");		// uint count, uint offsets[count + 1], char data[]
+		constexpr unsigned int CHUNK_NODES = MakeChunkId("NODE");		// uint count, NodeRecord[count] (pre-order, root first)
+		constexpr unsigned int CHUNK_COMPONENTS = MakeChunkId("COMP");	// ComponentBlockHeader, FieldRecord[fieldCount], count * stride bytes, int indices[count]
+
+		struct LevelHeader
+		{
+			char magic[4];
+			unsigned int version;
+			unsigned int chunkCount;
+			unsigned int flags;
+		};
+
+		struct ChunkHeader
+		{
+			unsigned int id;
+			unsigned int size;
+		};
+
+		struct NodeRecord
+		{
+			int entity;
+			int parent; // index in the node table, -1 for the root
+			unsigned int name; // index in the string table
+			LibMath::Vector3 position;
+			LibMath::Quaternion rotation;
+			LibMath::Vector3 scale;
+		};
+
+		struct ComponentBlockHeader
+		{
+			unsigned long long schemaHash;
+			unsigned int typeName; // index in the string table
+			unsigned int fieldCount;
+			unsigned int count;
+			unsigned int stride;
+		};
+
+		enum class EFieldKind : unsigned int
+		{
+			RAW, // trivially copyable, copied as is
+			STRING, // uint index in the string table
+			ENTITY_HANDLE, // int, remapped through the node table on load
+			COMPONENT_HANDLE, // remapped through the saved component indices on load
+		};
+
+		// COMPONENT_HANDLE records : int value, 4 zero bytes, long long type. Written field by field rather than
+		// copied, the padding of ComponentHandle is not initialized and would make the same world save differently.
+		constexpr unsigned int COMPONENT_HANDLE_VALUE_OFFSET = 0;
+		constexpr unsigned int COMPONENT_HANDLE_TYPE_OFFSET = 8;
+		constexpr unsigned int COMPONENT_HANDLE_RECORD_SIZE = 16;
+
+		void WriteComponentHandle(char* record, int value, long long type);
+		void ReadComponentHandle(const char* record, int& value, long long& type);
+
+		struct FieldRecord
+		{
+			unsigned int name; // index in the string table ("transform.position" for nested fields)
+			unsigned int typeName; // index in the string table
+			unsigned int recordOffset;
+			unsigned int size;
+			EFieldKind kind;
+		};
+
+		// A reflected structure flattened to its serializable leaf fields
+		struct FieldLayout
+		{
+			std::string name;
+			const Type* type;
+			int instanceOffset;
+			unsigned int recordOffset;
+			unsigned int size;
+			EFieldKind kind;
+		};
+
+		// Fields compiled to copy instructions : contiguous RAW fields are merged into a single memcpy
+		struct SerializeOp
+		{
+			EFieldKind kind;
+			int instanceOffset;
+			unsigned int recordOffset;
+			unsigned int size;
+		};
+
+		class StringTable;
+		class StringTableView;
+
+		struct StructureLayout
+		{
+			static const StructureLayout& Get(const Structure* meta); // built once per structure
+			static StructureLayout Build(const Structure* meta);
+
+			void WriteRecord(const char* instance, char* record, StringTable& strings) const;
+
+			// Lookup must provide Remap(EFieldKind, const char* savedValue, void* field) for handle fields
+			template <typename Lookup>
+			void ReadRecord(const char* record, char* instance, const StringTableView& strings,
+			                const Lookup& lookup) const;
+
+			std::vector<FieldLayout> fields;
+			std::vector<SerializeOp> ops;
+			unsigned int stride = 0;
+			unsigned long long schemaHash = 0;
+		};
+
+		class StringTable
+		{
+		public:
+			unsigned int Add(const std::string& str);
+			void Write(std::vector<char>& out) const;
+
+		private:
+			std::unordered_map<std::string, unsigned int> indices;
+			std::vector<unsigned int> offsets{0};
+			std::string data;
+		};
+
+		class StringTableView
+		{
+		public:
+			bool Read(const char* payload, size_t size);
+
+			std::string Get(unsigned int index) const;
+			bool Equals(unsigned int index, const std::string& str) const;
+			unsigned int Count() const { return offsets.empty() ? 0 : (unsigned int)offsets.size() - 1; }
+
+		private:
+			std::vector<unsigned int> offsets;
+			const char* data = nullptr;
+		};
+
+		struct ComponentBlockView
+		{
+			ComponentBlockHeader header;
+			std::vector<FieldRecord> fields;
+			const char* records;
+			const char* indices; // nullptr for version 1 files
+		};
+
+		class LevelReader
+		{
+		public:
+			LevelReader(const char* data, size_t size);
+
+			static bool IsLevelFormat(const char* data, size_t size);
+
+			bool IsValid() const { return isValid; }
+			unsigned int GetVersion() const { return version; }
+			const StringTableView& GetStrings() const { return strings; }
+			const std::vector<NodeRecord>& GetNodes() const { return nodes; }
+			const std::vector<ComponentBlockView>& GetComponentBlocks() const { return componentBlocks; }
+
+		private:
+			bool ReadNodes(const char* payload, size_t size);
+			bool ReadComponentBlock(const char* payload, size_t size);
+
+			StringTableView strings;
+			std::vector<NodeRecord> nodes;
+			std::vector<ComponentBlockView> componentBlocks;
+			unsigned int version = 0;
+			bool isValid = false;
+		};
+
+		template <typename T>
+		void Append(std::vector<char>& out, const T& value)
+		{
+			const char* bytes = (const char*)&value;
+			out.insert(out.end(), bytes, bytes + sizeof(T));
+		}
+
+		void AppendChunk(std::vector<char>& out, unsigned int id, const std::vector<char>& payload);
+
+		template <typename Lookup>
+		void StructureLayout::ReadRecord(const char* record, char* instance, const StringTableView& strings,
+		                                 const Lookup& lookup) const
+		{
+			for (const SerializeOp& op : ops)
+			{
+				const char* source = record + op.recordOffset;
+				char* target = instance + op.instanceOffset;
+
+				switch (op.kind)
+				{
+				case EFieldKind::STRING:
+					{
+						unsigned int stringIndex;
+						memcpy(&stringIndex, source, sizeof(stringIndex));
+						*(std::string*)target = strings.Get(stringIndex);
+						break;
+					}
+				case EFieldKind::ENTITY_HANDLE:
+				case EFieldKind::COMPONENT_HANDLE:
+					lookup.Remap(op.kind, source, target);
+					break;
+				default:
+					memcpy(target, source, op.size);
+					break;
+				}
+			}
+		}
+	}
+}
@@ -1,11 +1,16 @@
 #include "World.h"
 
+#include <algorithm>
+#include <cstring>
+#include <future>
 #include <stack>
 
+#include "../DebugWindow/Profiler.h"
 #include "../reflection/EnumMeta.h"
 #include "../reflection/StructMeta.h"
 #include "../scenegraph/SceneGraph.h"
 #include "../CLog.h"
+#include "../ThreadPool.h"
 
 namespace Core
 {
@@ -20,6 +25,7 @@ namespace Core
 		isInPlay = false;
 
 		level = new SceneGraph();
+		levelGeneration++;
 	}
 
 	void World::Initialize(const char* fileName)
@@ -74,7 +80,12 @@ namespace Core
 
 	void World::UpdateAll(float elapsedTime)
 	{
-		UpdateAllComponent(elapsedTime);
+		{
+			PROFILE_ZONE("Components");
+			UpdateAllComponent(elapsedTime);
+		}
+
+		PROFILE_ZONE("Scene graph");
 		level->UpdateAll();
 	}
 
@@ -88,9 +99,24 @@ namespace Core
 
 	void World::RegisterComponentForSerialization(GetDataPtrFunctionPtr dataFunctionPtr,
 	                                              GetDataQtyFunctionPtr sizeFunctionPtr,
-	                                              GetMetaDataFunctionPtr metaFunctionPtr)
+	                                              GetMetaDataFunctionPtr metaFunctionPtr,
+	                                              const int entityHandleOffset, const int isInUseOffset)
 	{
-		serializaComponentFunctions.emplace_back(dataFunctionPtr, sizeFunctionPtr, metaFunctionPtr);
+		serializaComponentFunctions.emplace_back(dataFunctionPtr, sizeFunctionPtr, metaFunctionPtr, entityHandleOffset,
+		                                         isInUseOffset);
+	}
+
+	const SerializeFunction* World::FindSerializeFunction(const Structure* meta)
+	{
+		for (const SerializeFunction& functions : serializaComponentFunctions)
+		{
+			if (functions.GetMeta() == meta)
+			{
+				return &functions;
+			}
+		}
+
+		return nullptr;
 	}
 
 	bool World::Save(const char* fileName)
@@ -101,204 +127,517 @@ namespace Core
 			return false;
 		}
 
-		if (SaveNode(file, level->GetRoot()) == false)
+		std::vector<char> buffer;
+		SaveToMemory(buffer);
+
+		file.write(buffer.data(), buffer.size());
+		file.close();
+		return file.good();
+	}
+
+	void World::SaveToMemory(std::vector<char>& buffer)
+	{
+		LevelFormat::StringTable strings;
+
+		std::vector<LevelFormat::NodeRecord> nodes;
+		SaveNode(nodes, level->GetRoot(), -1, strings);
+
+		std::vector<char> nodeChunk;
+		LevelFormat::Append(nodeChunk, (unsigned int)nodes.size());
+		nodeChunk.insert(nodeChunk.end(), (const char*)nodes.data(),
+		                 (const char*)nodes.data() + nodes.size() * sizeof(LevelFormat::NodeRecord));
+
+		std::vector<std::vector<char>> componentChunks;
+		for (const SerializeFunction& functions : serializaComponentFunctions)
+		{
+			std::vector<char> componentChunk;
+			SaveComponents(componentChunk, functions, strings);
+			if (componentChunk.empty() == false)
+			{
+				componentChunks.push_back(std::move(componentChunk));
+			}
+		}
+
+		// the string table is complete only once every node and component has been written
+		std::vector<char> stringChunk;
+		strings.Write(stringChunk);
+
+		LevelFormat::LevelHeader header{};
+		memcpy(header.magic, LevelFormat::MAGIC, sizeof(header.magic));
+		header.version = LevelFormat::VERSION;
+		header.chunkCount = 2 + (unsigned int)componentChunks.size();
+
+		buffer.clear();
+		LevelFormat::Append(buffer, header);
+		LevelFormat::AppendChunk(buffer, LevelFormat::CHUNK_STRINGS, stringChunk);
+		LevelFormat::AppendChunk(buffer, LevelFormat::CHUNK_NODES, nodeChunk);
+		for (const std::vector<char>& componentChunk : componentChunks)
+		{
+			LevelFormat::AppendChunk(buffer, LevelFormat::CHUNK_COMPONENTS, componentChunk);
+		}
+	}
+
+	// Replace the current level by the legacy level and save it in the binary format
+	bool World::ConvertLevel(const char* legacyFileName, const char* fileName)
+	{
+		Initialize();
+
+		LevelFile file(legacyFileName);
+		if (file.data.IsValid() == false || LoadLegacy(file) == false)
 		{
 			return false;
 		}
 
-		for (const SerializeFunction& functions : serializaComponentFunctions)
+		return Save(fileName);
+	}
+
+	void World::SaveNode(std::vector<LevelFormat::NodeRecord>& nodes, const SceneNode* node, int parent,
+	                     LevelFormat::StringTable& strings)
+	{
+		const int index = (int)nodes.size();
+		nodes.push_back({
+			node->GetEntity()->GetHandle().GetValue(),
+			parent,
+			strings.Add(node->GetName()),
+			node->GetLocalTransform().position,
+			node->GetLocalTransform().rotation,
+			node->GetLocalTransform().scale
+		});
+
+		for (const SceneNode* child : node->GetChildren())
 		{
-			if (SaveComponents(file, functions) == false)
+			SaveNode(nodes, child, index, strings);
+		}
+	}
+
+	void World::SaveComponents(std::vector<char>& chunk, const SerializeFunction& functions,
+	                           LevelFormat::StringTable& strings)
+	{
+		int qty = functions.GetQty();
+		if (qty == 0)
+		{
+			return;
+		}
+
+		const char* data = (char*)functions.GetData();
+		const Structure* metaData = functions.GetMeta();
+
+		std::vector<const char*> instances;
+		for (int index = 0; index < qty; index++)
+		{
+			const char* current = data + ((long long)index * (long long)metaData->size);
+			if (functions.IsInUse(current))
 			{
-				return false;
+				instances.push_back(current);
 			}
 		}
 
-		file.close();
-		return true;
+		if (instances.empty())
+		{
+			return;
+		}
+
+		const LevelFormat::StructureLayout& layout = LevelFormat::StructureLayout::Get(metaData);
+
+		LevelFormat::ComponentBlockHeader header{
+			layout.schemaHash,
+			strings.Add(metaData->name.text),
+			(unsigned int)layout.fields.size(),
+			(unsigned int)instances.size(),
+			layout.stride
+		};
+		LevelFormat::Append(chunk, header);
+
+		for (const LevelFormat::FieldLayout& field : layout.fields)
+		{
+			LevelFormat::Append(chunk, LevelFormat::FieldRecord{
+				                    strings.Add(field.name),
+				                    strings.Add(field.type->name.text),
+				                    field.recordOffset,
+				                    field.size,
+				                    field.kind
+			                    });
+		}
+
+		const size_t recordsBegin = chunk.size();
+		chunk.resize(recordsBegin + instances.size() * layout.stride);
+
+		char* record = chunk.data() + recordsBegin;
+		for (const char* instance : instances)
+		{
+			layout.WriteRecord(instance, record, strings);
+			record += layout.stride;
+		}
+
+		for (const char* instance : instances)
+		{
+			LevelFormat::Append(chunk, (int)((instance - data) / metaData->size));
+		}
+	}
+
+	EntityHandle LevelLookup::LookupEntity(int savedValue) const
+	{
+		if (savedValue < 0 || savedValue >= (int)entityLookup.size())
+		{
+			return EntityHandle();
+		}
+		return entityLookup[savedValue];
+	}
+
+	ComponentHandle LevelLookup::LookupComponent(const ComponentHandle& saved) const
+	{
+		const auto it = componentLookup.find(saved.GetType());
+		if (it == componentLookup.end() || saved.IsNotValid() || saved.GetValue() >= (int)it->second.size())
+		{
+			return ComponentHandle();
+		}
+		return ComponentHandle(it->second[saved.GetValue()], saved.GetType());
+	}
+
+	void LevelLookup::Remap(LevelFormat::EFieldKind kind, const char* savedValue, void* field) const
+	{
+		if (kind == LevelFormat::EFieldKind::ENTITY_HANDLE)
+		{
+			int saved;
+			memcpy(&saved, savedValue, sizeof(saved));
+			*(EntityHandle*)field = LookupEntity(saved);
+		}
+		else if (kind == LevelFormat::EFieldKind::COMPONENT_HANDLE)
+		{
+			int value;
+			long long type;
+			LevelFormat::ReadComponentHandle(savedValue, value, type);
+			*(ComponentHandle*)field = LookupComponent(ComponentHandle(value, type));
+		}
 	}
 
-	bool World::SaveNode(std::ofstream& file, const SceneNode* node)
+	struct ComponentBlockLoad
 	{
-		char buffer[((sizeof(LibMath::Quaternion) > sizeof(LibMath::Vector3))
-			             ? sizeof(LibMath::Quaternion)
-			             : sizeof(LibMath::Vector3))];
+		const LevelFormat::ComponentBlockView* block = nullptr;
+		const Structure* meta = nullptr;
+		const SerializeFunction* functions = nullptr;
+		const LevelFormat::StructureLayout* layout = nullptr;
+		bool isSameSchema = false;
+		std::vector<std::pair<const LevelFormat::FieldRecord*, const LevelFormat::FieldLayout*>> mapping; // when the schema changed
+		std::vector<int> indices; // loaded component index of each record
+	};
 
-		file << "<node ";
+	bool World::Load(const char* fileName)
+	{
+		LevelFile file(fileName);
 
-		file << "entity={";
-		*(int*)buffer = node->GetEntity()->GetHandle().GetValue();
-		file.write(buffer, sizeof(int));
-		file << "}"; //todo: refacto
+		if (file.data.IsValid() == false)
+		{
+			return true;
+		}
 
-		file << "name=";
-		*(int*)buffer = (int)node->GetName().size();
-		file.write(buffer, sizeof(int));
-		file << "{" << node->GetName() << "}";
+		if (LevelFormat::LevelReader::IsLevelFormat(file.data.GetData(), file.data.GetSize()) == false)
+		{
+			std::string message("loading a level saved in the legacy format, save it again to convert it : ");
+			message.append(fileName);
+			LOG(LOG_INFO, message, ELogChannel::CLOG_ECS);
+			return LoadLegacy(file);
+		}
 
-		memcpy(buffer, &node->GetLocalTransform().position, sizeof(LibMath::Vector3));
-		file << "position={";
-		file.write(buffer, sizeof(LibMath::Vector3));
-		file << "}";
+		return LoadFromMemory(file.data.GetData(), file.data.GetSize());
+	}
 
-		memcpy(buffer, &node->GetLocalTransform().rotation, sizeof(LibMath::Quaternion));
-		file << "rotation={";
-		file.write(buffer, sizeof(LibMath::Quaternion));
-		file << "}";
+	bool World::LoadFromMemory(const char* data, size_t size)
+	{
+		LevelFormat::LevelReader reader(data, size);
+		if (reader.IsValid() == false)
+		{
+			return false;
+		}
 
-		memcpy(buffer, &node->GetLocalTransform().scale, sizeof(LibMath::Vector3));
-		file << "scale={";
-		file.write(buffer, sizeof(LibMath::Vector3));
-		file << "}";
+		LevelLookup lookup;
+		if (LoadNodes(reader, lookup) == false)
+		{
+			return false;
+		}
 
-		if (node->GetChildrenCount())
+		// creation : reflected calls share their buffers and creating a component can move every other of its type
+		const std::vector<LevelFormat::ComponentBlockView>& blocks = reader.GetComponentBlocks();
+		std::vector<ComponentBlockLoad> loads(blocks.size());
+		unsigned int recordCount = 0;
+		for (size_t index = 0; index < blocks.size(); index++)
 		{
-			file << ">\n";
+			if (CreateComponents(reader, blocks[index], lookup, loads[index]))
+			{
+				recordCount += blocks[index].header.count;
+			}
+		}
 
-			for (const SceneNode* child : node->GetChildren())
+		// parse : every record only writes its own component and the lookups are read only from here
+		if (recordCount <= RECORDS_PER_LOAD_TASK)
+		{
+			for (const ComponentBlockLoad& load : loads)
 			{
-				if (SaveNode(file, child) == false)
+				if (load.meta)
 				{
-					return false;
+					DecodeComponents(reader, load, lookup, 0, load.block->header.count);
 				}
 			}
-			file << "</node>\n";
 		}
 		else
 		{
-			file << "/>\n";
+			std::vector<std::future<void>> tasks;
+			for (const ComponentBlockLoad& load : loads)
+			{
+				if (load.meta == nullptr)
+				{
+					continue;
+				}
+
+				for (unsigned int first = 0; first < load.block->header.count; first += RECORDS_PER_LOAD_TASK)
+				{
+					const unsigned int last = std::min(first + RECORDS_PER_LOAD_TASK, load.block->header.count);
+					tasks.push_back(ThreadPool::GetDefaultThreadPool().AddTask([&reader, &load, &lookup, first, last]
+					{
+						DecodeComponents(reader, load, lookup, first, last);
+					}));
+				}
+			}
+
+			for (std::future<void>& task : tasks)
+			{
+				task.get();
+			}
 		}
 
-		return file.good();
-	}
+		// resources : the files the Constructor() hooks need are read and decoded on the pool
+		LoadComponentResources(loads);
 
-	bool World::SaveComponents(std::ofstream& file, const SerializeFunction& functions)
-	{
-		int qty = functions.GetQty();
-		if (qty == 0)
+		// construction : Constructor() hooks use the renderer, physics and sound apis, which are bound to this thread
+		for (const ComponentBlockLoad& load : loads)
 		{
-			return true;
+			if (load.meta)
+			{
+				ConstructComponents(load);
+			}
 		}
 
-		const char* Data = (char*)functions.GetData();
-		const Structure* MetaData = functions.GetMeta();
+		return true;
+	}
 
-		for (int index = 0; index < qty; index++)
+	bool World::LoadNodes(const LevelFormat::LevelReader& reader, LevelLookup& lookup)
+	{
+		const std::vector<LevelFormat::NodeRecord>& records = reader.GetNodes();
+		std::vector<SceneNode*> nodes(records.size());
+
+		for (size_t index = 0; index < records.size(); index++)
 		{
-			const char* current = Data + ((long long)index * (long long)MetaData->size);
+			const LevelFormat::NodeRecord& record = records[index];
 
-			StructureField isInUse = MetaData->FindField("isInUse");
-			if (*(bool*)isInUse.GetFrom(current) == false)
+			SceneNode* node = level->GetRoot();
+			if (index > 0)
 			{
-				continue;
+				if (record.parent < 0 || record.parent >= (int)index)
+				{
+					LOG(LOG_ERROR, "invalid parent in level node table", ELogChannel::CLOG_ECS);
+					return false;
+				}
+
+				node = SceneNode::CreateRoot();
+				node->ReParent(nodes[record.parent]);
 			}
 
-			file << "\n";
-			if (SaveStructure(file, current, MetaData) == false)
+			node->SetName(reader.GetStrings().Get(record.name));
+			node->SetPosition(record.position);
+			node->SetRotation(record.rotation);
+			node->SetScale(record.scale);
+			nodes[index] = node;
+
+			if (record.entity >= 0)
 			{
-				return false;
+				if (record.entity >= (int)lookup.entityLookup.size())
+				{
+					lookup.entityLookup.resize((size_t)record.entity + 1);
+				}
+				lookup.entityLookup[record.entity] = node->GetEntity()->GetHandle();
 			}
 		}
 
-		return file.good();
+		return true;
 	}
 
-	bool World::SaveStructure(std::ofstream& file, const void* structure, const Structure* metaData)
+	bool World::CreateComponents(const LevelFormat::LevelReader& reader, const LevelFormat::ComponentBlockView& block,
+	                             LevelLookup& lookup, ComponentBlockLoad& load)
 	{
-		file << metaData->name.text << "{";
+		const LevelFormat::StringTableView& strings = reader.GetStrings();
+
+		const Type* type = Type::Find(strings.Get(block.header.typeName));
+		if (!type || type->category != ETypeCategory::STRUCTURE)
+		{
+			std::string message("unknown component type in level : skipping ");
+			message.append(strings.Get(block.header.typeName));
+			LOG(LOG_WARNING, message, ELogChannel::CLOG_ECS);
+			return false;
+		}
 
-		for (StructureField field : metaData->GetAllFields())
+		const Structure* compMeta = (const Structure*)type;
+		load.functions = FindSerializeFunction(compMeta);
+		if (load.functions == nullptr)
 		{
-			if (field.flags.include(FieldFlag::TRANSIENT))
+			std::string message("type is not a registered component : skipping ");
+			message.append(compMeta->name.text);
+			LOG(LOG_WARNING, message, ELogChannel::CLOG_ECS);
+			return false;
+		}
+
+		load.block = &block;
+		load.layout = &LevelFormat::StructureLayout::Get(compMeta);
+
+		// same schema : records are read with the compiled ops, otherwise fields are matched by name and type once
+		load.isSameSchema = block.header.schemaHash == load.layout->schemaHash
+			&& block.header.stride == load.layout->stride;
+		if (load.isSameSchema == false)
+		{
+			for (const LevelFormat::FieldLayout& target : load.layout->fields)
 			{
-				continue;
+				for (const LevelFormat::FieldRecord& source : block.fields)
+				{
+					if (source.kind == target.kind && source.size == target.size
+						&& strings.Equals(source.name, target.name)
+						&& strings.Equals(source.typeName, target.type->name.text))
+					{
+						load.mapping.emplace_back(&source, &target);
+						break;
+					}
+				}
 			}
+		}
 
-			file << field.name->text << "=";
+		const Function* createFunction = compMeta->FindFunction("CreateComponent");
+		std::vector<int>& componentLookup = lookup.componentLookup[compMeta->name.hash];
 
-			void* data = field.GetFrom(structure);
-			if (field.flags.include(FieldFlag::POINTER)) // todo: test pointer extensivly (save & load)
+		load.indices.resize(block.header.count);
+		for (unsigned int index = 0; index < block.header.count; index++)
+		{
+			const char* comp = (const char*)createFunction->Call<void*>(nullptr);
+			load.indices[index] = (int)((comp - (const char*)load.functions->GetData()) / compMeta->size);
+
+			if (block.indices)
 			{
-				std::string message("attempt to serialize a pointer : dereferencing pointer for ");
-				message.append(metaData->name.text).append("::").append(field.name->text);
-				LOG(LOG_WARNING, message);
-				data = *(void**)data;
+				int savedIndex;
+				memcpy(&savedIndex, block.indices + (size_t)index * sizeof(int), sizeof(savedIndex));
+				if (savedIndex >= 0)
+				{
+					if (savedIndex >= (int)componentLookup.size())
+					{
+						componentLookup.resize((size_t)savedIndex + 1, (int)ComponentHandle::INVALID_VALUE);
+					}
+					componentLookup[savedIndex] = load.indices[index];
+				}
 			}
+		}
 
-			if (field.type->name.hash == ConstexprCustomHash("string")
-				|| field.type->name.hash == ConstexprCustomHash("std::string"))
-			{
-				std::string& str = *(std::string*)data;
+		load.meta = compMeta;
+		return true;
+	}
 
-				char buffer[sizeof(int)];
-				*(int*)buffer = (int)str.size();
+	void World::DecodeComponents(const LevelFormat::LevelReader& reader, const ComponentBlockLoad& load,
+	                             const LevelLookup& lookup, unsigned int first, unsigned int last)
+	{
+		const LevelFormat::StringTableView& strings = reader.GetStrings();
+		char* data = (char*)load.functions->GetData();
+
+		for (unsigned int index = first; index < last; index++)
+		{
+			const char* record = load.block->records + (size_t)index * load.block->header.stride;
+			char* comp = data + (long long)load.indices[index] * (long long)load.meta->size;
 
-				file.write(buffer, sizeof(int));
-				file << "{" << str << "}";
+			if (load.isSameSchema)
+			{
+				load.layout->ReadRecord(record, comp, strings, lookup);
+				continue;
 			}
-			else
+
+			for (auto [source, target] : load.mapping)
 			{
-				switch (field.type->category)
+				const char* value = record + source->recordOffset;
+				void* field = comp + target->instanceOffset;
+
+				switch (target->kind)
 				{
-				case ETypeCategory::ENUMERATION:
-				case ETypeCategory::PRIMITIVE:
-				case ETypeCategory::WRAPPER:
+				case LevelFormat::EFieldKind::STRING:
 					{
-						file << "{";
-						file.write((const char*)data, field.type->size);
-						file << "}";
+						unsigned int stringIndex;
+						memcpy(&stringIndex, value, sizeof(stringIndex));
+						*(std::string*)field = strings.Get(stringIndex);
 						break;
 					}
-				case ETypeCategory::STRUCTURE:
-					SaveStructure(file, data, (Structure*)field.type);
+				case LevelFormat::EFieldKind::ENTITY_HANDLE:
+				case LevelFormat::EFieldKind::COMPONENT_HANDLE:
+					lookup.Remap(target->kind, value, field);
 					break;
-				case ETypeCategory::POINTER:
-				case ETypeCategory::COLLECTION:
-					{
-						std::string message(
-							"attempt to serialize an unsupported data category : skipping serialization for ");
-						message.append(metaData->name.text).append("::").append(field.name->text);
-						LOG(LOG_WARNING, message);
-						break;
-					}
 				default:
-					{
-						std::string message(
-							"attempt to serialize an unknown data category : skipping serialization for ");
-						message.append(metaData->name.text).append("::").append(field.name->text);
-						LOG(LOG_WARNING, message);
-						break;
-					}
+					memcpy(field, value, source->size);
+					break;
 				}
 			}
 		}
+	}
 
-		file << "}";
+	void World::LoadComponentResources(const std::vector<ComponentBlockLoad>& loads)
+	{
+		// a LoadResources() hook only touches its own component and thread safe apis, and creates no component :
+		// the storages do not move until every task is done
+		std::vector<std::future<void>> tasks;
+		for (const ComponentBlockLoad& load : loads)
+		{
+			const Function* loadFunction = load.meta ? load.meta->FindFunction("LoadResources") : nullptr;
+			if (loadFunction == nullptr)
+			{
+				continue;
+			}
 
-		return file.good();
+			char* data = (char*)load.functions->GetData();
+			for (int index : load.indices)
+			{
+				char* comp = data + (long long)index * (long long)load.meta->size;
+				tasks.push_back(ThreadPool::GetDefaultThreadPool().AddTask([loadFunction, comp]
+				{
+					loadFunction->Invoke(comp);
+				}));
+			}
+		}
+
+		for (std::future<void>& task : tasks)
+		{
+			task.get();
+		}
 	}
 
-	bool World::Load(const char* fileName)
+	void World::ConstructComponents(const ComponentBlockLoad& load)
 	{
-		LevelFile file(fileName);
+		const Function* constructorFunction = load.meta->FindFunction("Constructor");
 
-		if (file.data.IsValid())
+		for (int index : load.indices)
 		{
-			if (LoadLevel(file) == false)
-			{
-				return false;
-			}
+			// a Constructor() can create components of its own type and move the storage
+			char* comp = (char*)load.functions->GetData() + (long long)index * (long long)load.meta->size;
 
-			if (LoadComponents(file) == false)
+			if (constructorFunction)
 			{
-				return false;
+				constructorFunction->Invoke(comp);
 			}
+
+			Entity::AddDetail(load.functions->GetEntityHandle(comp), ComponentHandle(index, load.meta->name.hash));
 		}
+	}
 
-		return true;
+	bool World::LoadLegacy(LevelFile& file)
+	{
+		if (LoadLegacyLevel(file) == false)
+		{
+			return false;
+		}
+
+		return LoadLegacyComponents(file);
 	}
 
-	bool World::LoadLevel(LevelFile& file)
+	bool World::LoadLegacyLevel(LevelFile& file)
 	{
 		SceneNode* currentNode = level->GetRoot();
 		std::stack<SceneNode*> currentBranch({nullptr});
@@ -310,7 +649,7 @@ namespace Core
 				currentNode = SceneNode::CreateRoot();
 			}
 
-			switch (LoadNode(file, currentNode))
+			switch (LoadLegacyNode(file, currentNode))
 			{
 			case EBranchManip::POP:
 				currentBranch.pop();
@@ -341,7 +680,7 @@ namespace Core
 	}
 
 	// return if node is completed (have no more children to load)
-	EBranchManip World::LoadNode(LevelFile& file, SceneNode* node)
+	EBranchManip World::LoadLegacyNode(LevelFile& file, SceneNode* node)
 	{
 		while (ReadWord(file))
 		{
@@ -394,22 +733,23 @@ namespace Core
 		return file.ReachEOF() == false;
 	}
 
-	bool World::LoadComponents(LevelFile& file)
+	bool World::LoadLegacyComponents(LevelFile& file)
 	{
 		while (ReadWord(file))
 		{
 			if (file.wordBuffer.size())
 			{
 				const Structure* compMeta = (Structure*)Type::Find(file.wordBuffer.c_str());
-				if (!compMeta)
+				const SerializeFunction* functions = compMeta ? FindSerializeFunction(compMeta) : nullptr;
+				if (!functions)
 				{
 					continue;
 				}
 
 				const Function* createFunction = compMeta->FindFunction("CreateComponent");
-				void* comp = *(void**)createFunction->Invoke(nullptr).Data;
+				void* comp = createFunction->Call<void*>(nullptr);
 
-				LoadStructure(file, comp, compMeta);
+				LoadLegacyStructure(file, comp, compMeta);
 
 				const Function* constructorFunction = compMeta->FindFunction("Constructor");
 				if (constructorFunction)
@@ -418,11 +758,10 @@ namespace Core
 				}
 
 
-				StructureField entityHandleField = compMeta->FindField("entityHandle");
-				EntityHandle entity = *(EntityHandle*)entityHandleField.GetFrom(comp);
+				EntityHandle entity = functions->GetEntityHandle(comp);
 
 				const Function* getHandleFunction = compMeta->FindFunction("GetHandle");
-				ComponentHandle component = *(ComponentHandle*)getHandleFunction->Invoke(comp).Data;
+				ComponentHandle component = getHandleFunction->Call<ComponentHandle>(comp);
 
 				Entity::AddDetail(entity, component);
 			}
@@ -430,7 +769,7 @@ namespace Core
 		return file.ReachEOF();
 	}
 
-	bool World::LoadStructure(LevelFile& file, void* structure, const Structure* metaData)
+	bool World::LoadLegacyStructure(LevelFile& file, void* structure, const Structure* metaData)
 	{
 		while (ReadWord(file)
 			&& file.lastLetter != '}')
@@ -458,7 +797,7 @@ namespace Core
 			}
 			else if (field.type->category == ETypeCategory::STRUCTURE)
 			{
-				LoadStructure(file, field.GetFrom(structure), (Structure*)field.type);
+				LoadLegacyStructure(file, field.GetFrom(structure), (Structure*)field.type);
 			}
 			else
 			{
@@ -528,9 +867,16 @@ namespace Core
 	void World::AddEntityLookup(LevelFile& file, const SceneNode* node)
 	{
 		EntityHandle oldValue = ReadEntityHandle(file);
-		EntityHandle newValue = node->GetEntity()->GetHandle();
+		if (oldValue.GetValue() < 0)
+		{
+			return;
+		}
 
-		file.entityLookup.emplace_back(oldValue, newValue);
+		if (oldValue.GetValue() >= (int)file.entityLookup.size())
+		{
+			file.entityLookup.resize((size_t)oldValue.GetValue() + 1);
+		}
+		file.entityLookup[oldValue.GetValue()] = node->GetEntity()->GetHandle();
 	}
 
 	EntityHandle World::LookupEntity(LevelFile& file)
@@ -540,14 +886,6 @@ namespace Core
 		EntityHandle oldValue = ReadEntityHandle(file);
 		file.ptr++; // skip '}'
 
-		for (Lookup<EntityHandle> lookup : file.entityLookup)
-		{
-			if (lookup.oldValue == oldValue)
-			{
-				return lookup.newValue;
-			}
-		}
-
-		return EntityHandle();
+		return file.LookupEntity(oldValue.GetValue());
 	}
 }
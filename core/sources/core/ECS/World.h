@@ -2,8 +2,10 @@
 
 #include <vector>
 #include <fstream>
+#include <unordered_map>
 
 #include "Handle.h"
+#include "LevelFormat.h"
 #include "../filesys/MemoryMappedFile.h"
 #include "Quaternion/Quaternion.h"
 #include "Vector/Vector3.h"
@@ -25,34 +27,43 @@ namespace Core
 	struct SerializeFunction
 	{
 		SerializeFunction(GetDataPtrFunctionPtr dataFunctionPtr, GetDataQtyFunctionPtr sizeFunctionPtr,
-		                  GetMetaDataFunctionPtr metaData) :
+		                  GetMetaDataFunctionPtr metaData, int entityHandleOffset, int isInUseOffset) :
 			GetData(dataFunctionPtr),
 			GetQty(sizeFunctionPtr),
-			GetMeta(metaData)
+			GetMeta(metaData),
+			entityHandleOffset(entityHandleOffset),
+			isInUseOffset(isInUseOffset)
 		{
 		}
 
+		const EntityHandle& GetEntityHandle(const void* component) const
+		{
+			return *(const EntityHandle*)((const char*)component + entityHandleOffset);
+		}
+		bool IsInUse(const void* component) const { return *(const bool*)((const char*)component + isInUseOffset); }
+
 		GetDataPtrFunctionPtr GetData;
 		GetDataQtyFunctionPtr GetQty;
 		GetMetaDataFunctionPtr GetMeta;
+
+		// resolved at compile time when the component type registers
+		int entityHandleOffset;
+		int isInUseOffset;
 	};
 
-	template <typename T>
-	struct Lookup
+	enum class EBranchManip { POP, PUSH, QUO };
+
+	struct LevelLookup
 	{
-		Lookup(T oldValue, T newValue) :
-			oldValue(oldValue),
-			newValue(newValue)
-		{
-		}
+		EntityHandle LookupEntity(int savedValue) const;
+		ComponentHandle LookupComponent(const ComponentHandle& saved) const;
+		void Remap(LevelFormat::EFieldKind kind, const char* savedValue, void* field) const; // handle fields only
 
-		T oldValue;
-		T newValue;
+		std::vector<EntityHandle> entityLookup; // indexed by saved entity value
+		std::unordered_map<long long, std::vector<int>> componentLookup; // per component type, indexed by saved component index
 	};
 
-	enum class EBranchManip { POP, PUSH, QUO };
-
-	struct LevelFile
+	struct LevelFile : public LevelLookup
 	{
 		LevelFile(const char* filePath) :
 			data(filePath),
@@ -70,11 +81,10 @@ namespace Core
 
 		char lastLetter;
 		std::string wordBuffer;
-
-		std::vector<Lookup<EntityHandle>> entityLookup;
-		std::vector<Lookup<ComponentHandle>> componentLookup;
 	};
 
+	struct ComponentBlockLoad;
+
 	class World
 	{
 	public:
@@ -86,6 +96,7 @@ namespace Core
 		static void Finalize();
 
 		static SceneGraph* GetLevel() { return level; }
+		static unsigned int GetLevelGeneration() { return levelGeneration; } // changes each time the level is replaced
 
 		static void RegisterComponentForBeginPlay(BeginPlayComponentFunctionPtr functionPtr);
 		static void Start();
@@ -98,8 +109,14 @@ namespace Core
 
 		static void RegisterComponentForSerialization(GetDataPtrFunctionPtr dataFunctionPtr,
 		                                              GetDataQtyFunctionPtr sizeFunctionPtr,
-		                                              GetMetaDataFunctionPtr metaData);
+		                                              GetMetaDataFunctionPtr metaData,
+		                                              int entityHandleOffset, int isInUseOffset);
+		static const SerializeFunction* FindSerializeFunction(const Structure* meta);
+
 		static bool Save(const char* fileName);
+		static void SaveToMemory(std::vector<char>& buffer);
+		static bool LoadFromMemory(const char* data, size_t size); // load in the current level
+		static bool ConvertLevel(const char* legacyFileName, const char* fileName);
 
 		static bool HasStarted() { return hasDoneBeginPlay; }
 		static bool IsInPlay() { return isInPlay; }
@@ -107,15 +124,26 @@ namespace Core
 	private:
 		static void UpdateAllComponent(float elapsedTime);
 
-		static bool SaveComponents(std::ofstream& file, const SerializeFunction& functions);
-		static bool SaveNode(std::ofstream& file, const SceneNode* node);
-		static bool SaveStructure(std::ofstream& file, const void* structure, const Structure* metaData);
+		static void SaveNode(std::vector<LevelFormat::NodeRecord>& nodes, const SceneNode* node, int parent,
+		                     LevelFormat::StringTable& strings);
+		static void SaveComponents(std::vector<char>& chunk, const SerializeFunction& functions,
+		                           LevelFormat::StringTable& strings);
 
 		static bool Load(const char* fileName);
-		static bool LoadLevel(LevelFile& file);
-		static bool LoadComponents(LevelFile& file);
-		static bool LoadStructure(LevelFile& file, void* data, const Structure* meta);
-		static EBranchManip LoadNode(LevelFile& file, SceneNode* node);
+		static bool LoadNodes(const LevelFormat::LevelReader& reader, LevelLookup& lookup);
+		static bool CreateComponents(const LevelFormat::LevelReader& reader, const LevelFormat::ComponentBlockView& block,
+		                             LevelLookup& lookup, ComponentBlockLoad& load);
+		static void DecodeComponents(const LevelFormat::LevelReader& reader, const ComponentBlockLoad& load,
+		                             const LevelLookup& lookup, unsigned int first, unsigned int last);
+		static void LoadComponentResources(const std::vector<ComponentBlockLoad>& loads);
+		static void ConstructComponents(const ComponentBlockLoad& load);
+
+		// legacy tag/word format, only kept to load (and convert) levels saved before LevelFormat
+		static bool LoadLegacy(LevelFile& file);
+		static bool LoadLegacyLevel(LevelFile& file);
+		static bool LoadLegacyComponents(LevelFile& file);
+		static bool LoadLegacyStructure(LevelFile& file, void* data, const Structure* meta);
+		static EBranchManip LoadLegacyNode(LevelFile& file, SceneNode* node);
 
 		static bool ReadWord(LevelFile& file);
 		static std::string ReadString(LevelFile& file);
@@ -126,9 +154,12 @@ namespace Core
 		static void AddEntityLookup(LevelFile& file, const SceneNode* node);
 		static EntityHandle LookupEntity(LevelFile& file);
 
+		static constexpr unsigned int RECORDS_PER_LOAD_TASK = 256;
+
 		inline static bool isInPlay = false;
 		inline static bool hasDoneBeginPlay = false;
 		inline static SceneGraph* level = nullptr;
+		inline static unsigned int levelGeneration = 0;
 		inline static std::vector<UpdateComponentFunctionPtr> updateComponentFunctions;
 		inline static std::vector<BeginPlayComponentFunctionPtr> beginPlayComponentFunctions;
 		inline static std::vector<SerializeFunction> serializaComponentFunctions;
@@ -0,0 +1,942 @@
+#include "WorldSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#include "Entity.h"
+#include "World.h"
+#include "../reflection/StructMeta.h"
+#include "../scenegraph/SceneGraph.h"
+
+namespace Core
+{
+	namespace
+	{
+		constexpr unsigned long long INVALID_KEY = ~0ull;
+
+		// a component handle as the delta stores it : the type and the (node, rank) key of the component it points to
+		struct ComponentReference
+		{
+			long long type;
+			unsigned long long key; // INVALID_KEY for an invalid handle
+		};
+
+		// (type, saved component index) to the key of the record
+		using ComponentKeys = std::unordered_map<long long, std::unordered_map<int, unsigned long long>>;
+
+		unsigned long long RecordKey(unsigned int node, unsigned int rank)
+		{
+			return (unsigned long long)node << 32 | rank;
+		}
+
+		void CollectNodes(SceneNode* node, std::vector<SceneNode*>& nodes)
+		{
+			nodes.push_back(node);
+			for (SceneNode* child : node->GetChildren())
+			{
+				CollectNodes(child, nodes);
+			}
+		}
+
+		std::unordered_map<int, unsigned int> NodePositions(const LevelFormat::LevelReader& reader)
+		{
+			std::unordered_map<int, unsigned int> positions;
+			const std::vector<LevelFormat::NodeRecord>& nodes = reader.GetNodes();
+			for (unsigned int position = 0; position < nodes.size(); position++)
+			{
+				positions.emplace(nodes[position].entity, position);
+			}
+			return positions;
+		}
+
+		int NodePosition(const std::unordered_map<int, unsigned int>& positions, const char* entityValue)
+		{
+			int entity;
+			memcpy(&entity, entityValue, sizeof(entity));
+
+			const auto it = positions.find(entity);
+			return it == positions.end() ? -1 : (int)it->second;
+		}
+
+		// key every record of the block by (node position, rank on the node)
+		bool IndexRecords(const LevelFormat::LevelReader& reader, const LevelFormat::ComponentBlockView& block,
+		                  const std::unordered_map<int, unsigned int>& positions,
+		                  std::unordered_map<unsigned long long, const char*>& records,
+		                  std::unordered_map<int, unsigned long long>* componentKeys = nullptr)
+		{
+			const LevelFormat::FieldRecord* entityField = nullptr;
+			for (const LevelFormat::FieldRecord& field : block.fields)
+			{
+				if (field.kind == LevelFormat::EFieldKind::ENTITY_HANDLE
+					&& reader.GetStrings().Equals(field.name, "entityHandle"))
+				{
+					entityField = &field;
+					break;
+				}
+			}
+
+			if (entityField == nullptr)
+			{
+				return false;
+			}
+
+			std::unordered_map<int, unsigned int> ranks;
+			for (unsigned int index = 0; index < block.header.count; index++)
+			{
+				const char* record = block.records + (size_t)index * block.header.stride;
+
+				const int node = NodePosition(positions, record + entityField->recordOffset);
+				if (node < 0)
+				{
+					return false;
+				}
+
+				const unsigned long long key = RecordKey(node, ranks[node]++);
+				records.emplace(key, record);
+
+				if (componentKeys && block.indices)
+				{
+					int savedIndex;
+					memcpy(&savedIndex, block.indices + (size_t)index * sizeof(int), sizeof(savedIndex));
+					componentKeys->emplace(savedIndex, key);
+				}
+			}
+
+			return true;
+		}
+
+		// the saved component handles of the snapshot point at components by their index when it was taken
+		bool IndexComponents(const LevelFormat::LevelReader& reader,
+		                     const std::unordered_map<int, unsigned int>& positions, ComponentKeys& keys)
+		{
+			std::unordered_map<unsigned long long, const char*> records;
+			for (const LevelFormat::ComponentBlockView& block : reader.GetComponentBlocks())
+			{
+				const Type* type = Type::Find(reader.GetStrings().Get(block.header.typeName));
+				if (!type)
+				{
+					return false;
+				}
+
+				records.clear();
+				if (IndexRecords(reader, block, positions, records, &keys[type->name.hash]) == false)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		ComponentReference ReferenceComponent(const ComponentKeys& keys, const char* savedValue)
+		{
+			int value;
+			long long type;
+			LevelFormat::ReadComponentHandle(savedValue, value, type);
+
+			const auto typeKeys = keys.find(type);
+			if (value < 0 || typeKeys == keys.end())
+			{
+				return {type, INVALID_KEY};
+			}
+
+			const auto key = typeKeys->second.find(value);
+			return {type, key == typeKeys->second.end() ? INVALID_KEY : key->second};
+		}
+
+		std::unordered_map<int, unsigned int> LivePositions(const std::vector<SceneNode*>& nodes)
+		{
+			std::unordered_map<int, unsigned int> positions;
+			for (unsigned int position = 0; position < nodes.size(); position++)
+			{
+				positions.emplace(nodes[position]->GetEntity()->GetHandle().GetValue(), position);
+			}
+			return positions;
+		}
+
+		// a live component handle keyed the same way as the snapshot records
+		ComponentReference ReferenceLiveComponent(const ComponentHandle& handle,
+		                                          const std::unordered_map<int, unsigned int>& positions)
+		{
+			const ComponentReference invalid{handle.GetType(), INVALID_KEY};
+
+			const Type* type = Type::Find(handle.GetType());
+			const SerializeFunction* functions = type && type->category == ETypeCategory::STRUCTURE
+				                                     ? World::FindSerializeFunction((const Structure*)type)
+				                                     : nullptr;
+			if (functions == nullptr || handle.IsNotValid() || handle.GetValue() >= functions->GetQty())
+			{
+				return invalid;
+			}
+
+			const Structure* meta = (const Structure*)type;
+			const char* comp = (const char*)functions->GetData() + (long long)handle.GetValue() * (long long)meta->size;
+			if (functions->IsInUse(comp) == false)
+			{
+				return invalid;
+			}
+
+			const EntityHandle entity = functions->GetEntityHandle(comp);
+			const auto position = positions.find(entity.GetValue());
+			if (position == positions.end())
+			{
+				return invalid;
+			}
+
+			unsigned int rank = 0;
+			for (const EntityDetail* detail : Entity::GetEntity(entity)->GetAllComponents())
+			{
+				const ComponentHandle other = detail->GetComponentHandle();
+				if (other.GetType() == handle.GetType() && other.GetValue() < handle.GetValue())
+				{
+					rank++;
+				}
+			}
+			return {handle.GetType(), RecordKey(position->second, rank)};
+		}
+
+		// live components of the type keyed the same way as the snapshot records
+		void IndexLiveComponents(const Structure* meta, const SerializeFunction* functions,
+		                         const std::unordered_map<int, unsigned int>& positions,
+		                         std::unordered_map<unsigned long long, int>& components)
+		{
+			const char* data = (const char*)functions->GetData();
+			std::unordered_map<int, unsigned int> ranks;
+
+			components.clear();
+			for (int index = 0; index < functions->GetQty(); index++)
+			{
+				const char* comp = data + (long long)index * (long long)meta->size;
+				if (functions->IsInUse(comp) == false)
+				{
+					continue;
+				}
+
+				const int node = NodePosition(positions, (const char*)&functions->GetEntityHandle(comp));
+				if (node >= 0)
+				{
+					components.emplace(RecordKey(node, ranks[node]++), index);
+				}
+			}
+		}
+	}
+
+	WorldSnapshot WorldSnapshot::Capture()
+	{
+		WorldSnapshot snapshot;
+		World::SaveToMemory(snapshot.data);
+		return snapshot;
+	}
+
+	bool WorldSnapshot::Restore() const
+	{
+		if (IsEmpty())
+		{
+			return false;
+		}
+
+		World::Initialize();
+		return World::LoadFromMemory(data.data(), data.size());
+	}
+
+	bool WorldSnapshot::Save(const char* fileName) const
+	{
+		std::ofstream file(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+		if (file.is_open() == false)
+		{
+			return false;
+		}
+
+		file.write(data.data(), data.size());
+		file.close();
+		return file.good();
+	}
+
+	WorldDelta WorldDelta::Diff(const WorldSnapshot& from, const WorldSnapshot& to)
+	{
+		WorldDelta delta;
+		delta.isStructural = true;
+
+		LevelFormat::LevelReader fromReader(from.GetData().data(), from.GetSize());
+		LevelFormat::LevelReader toReader(to.GetData().data(), to.GetSize());
+		if (fromReader.IsValid() == false || toReader.IsValid() == false)
+		{
+			return delta;
+		}
+
+		const LevelFormat::StringTableView& fromStrings = fromReader.GetStrings();
+		const LevelFormat::StringTableView& toStrings = toReader.GetStrings();
+
+		const std::vector<LevelFormat::NodeRecord>& fromNodes = fromReader.GetNodes();
+		const std::vector<LevelFormat::NodeRecord>& toNodes = toReader.GetNodes();
+		if (fromNodes.size() != toNodes.size())
+		{
+			return delta;
+		}
+
+		for (unsigned int node = 0; node < toNodes.size(); node++)
+		{
+			const LevelFormat::NodeRecord& before = fromNodes[node];
+			const LevelFormat::NodeRecord& after = toNodes[node];
+			if (before.parent != after.parent)
+			{
+				return delta;
+			}
+
+			std::string name = toStrings.Get(after.name);
+			if (fromStrings.Equals(before.name, name) == false
+				|| memcmp(&before.position, &after.position, sizeof(after.position)) != 0
+				|| memcmp(&before.rotation, &after.rotation, sizeof(after.rotation)) != 0
+				|| memcmp(&before.scale, &after.scale, sizeof(after.scale)) != 0)
+			{
+				delta.nodeChanges.push_back({
+					node, (unsigned int)delta.strings.size(), after.position, after.rotation, after.scale
+				});
+				delta.strings.push_back(std::move(name));
+			}
+		}
+
+		const std::vector<LevelFormat::ComponentBlockView>& fromBlocks = fromReader.GetComponentBlocks();
+		const std::vector<LevelFormat::ComponentBlockView>& toBlocks = toReader.GetComponentBlocks();
+		if (fromBlocks.size() != toBlocks.size())
+		{
+			return delta;
+		}
+
+		const std::unordered_map<int, unsigned int> fromPositions = NodePositions(fromReader);
+		const std::unordered_map<int, unsigned int> toPositions = NodePositions(toReader);
+
+		ComponentKeys fromComponents;
+		ComponentKeys toComponents;
+		if (IndexComponents(fromReader, fromPositions, fromComponents) == false
+			|| IndexComponents(toReader, toPositions, toComponents) == false)
+		{
+			return delta;
+		}
+
+		for (size_t block = 0; block < toBlocks.size(); block++)
+		{
+			const LevelFormat::ComponentBlockView& before = fromBlocks[block];
+			const LevelFormat::ComponentBlockView& after = toBlocks[block];
+
+			const std::string typeName = toStrings.Get(after.header.typeName);
+			const Type* type = Type::Find(typeName);
+			if (!type || type->category != ETypeCategory::STRUCTURE
+				|| fromStrings.Equals(before.header.typeName, typeName) == false
+				|| before.header.count != after.header.count
+				|| before.header.schemaHash != after.header.schemaHash)
+			{
+				return delta;
+			}
+
+			const Structure* meta = (const Structure*)type;
+			const LevelFormat::StructureLayout& layout = LevelFormat::StructureLayout::Get(meta);
+			if (layout.schemaHash != after.header.schemaHash)
+			{
+				return delta;
+			}
+
+			std::unordered_map<unsigned long long, const char*> fromRecords;
+			std::unordered_map<unsigned long long, const char*> toRecords;
+			if (IndexRecords(fromReader, before, fromPositions, fromRecords) == false
+				|| IndexRecords(toReader, after, toPositions, toRecords) == false)
+			{
+				return delta;
+			}
+
+			for (const auto& [key, record] : toRecords)
+			{
+				const auto previous = fromRecords.find(key);
+				if (previous == fromRecords.end())
+				{
+					return delta;
+				}
+
+				for (const LevelFormat::FieldLayout& field : layout.fields)
+				{
+					const char* oldValue = previous->second + field.recordOffset;
+					const char* newValue = record + field.recordOffset;
+					size_t value;
+
+					switch (field.kind)
+					{
+					case LevelFormat::EFieldKind::STRING:
+						{
+							unsigned int oldIndex;
+							unsigned int newIndex;
+							memcpy(&oldIndex, oldValue, sizeof(oldIndex));
+							memcpy(&newIndex, newValue, sizeof(newIndex));
+
+							std::string str = toStrings.Get(newIndex);
+							if (fromStrings.Equals(oldIndex, str))
+							{
+								continue;
+							}
+
+							value = delta.strings.size();
+							delta.strings.push_back(std::move(str));
+							break;
+						}
+					case LevelFormat::EFieldKind::ENTITY_HANDLE:
+						{
+							const int oldNode = NodePosition(fromPositions, oldValue);
+							const int newNode = NodePosition(toPositions, newValue);
+							if (oldNode == newNode)
+							{
+								continue;
+							}
+
+							value = delta.values.size();
+							LevelFormat::Append(delta.values, newNode);
+							break;
+						}
+					case LevelFormat::EFieldKind::COMPONENT_HANDLE:
+						{
+							const ComponentReference oldComponent = ReferenceComponent(fromComponents, oldValue);
+							const ComponentReference newComponent = ReferenceComponent(toComponents, newValue);
+							if (oldComponent.type == newComponent.type && oldComponent.key == newComponent.key)
+							{
+								continue;
+							}
+
+							value = delta.values.size();
+							LevelFormat::Append(delta.values, newComponent);
+							break;
+						}
+					default:
+						{
+							if (memcmp(oldValue, newValue, field.size) == 0)
+							{
+								continue;
+							}
+
+							value = delta.values.size();
+							delta.values.insert(delta.values.end(), newValue, newValue + field.size);
+							break;
+						}
+					}
+
+					delta.fieldChanges.push_back({
+						meta, (unsigned int)(key >> 32), (unsigned int)key, field.instanceOffset, field.kind, field.size,
+						value
+					});
+				}
+			}
+		}
+
+		delta.isStructural = false;
+		return delta;
+	}
+
+	NodeState NodeState::Capture(const SceneNode* node, const std::unordered_map<int, unsigned int>& positions)
+	{
+		NodeState state{
+			node->GetName(),
+			node->GetLocalTransform().position,
+			node->GetLocalTransform().rotation,
+			node->GetLocalTransform().scale,
+			{}
+		};
+
+		std::vector<ComponentHandle> handles;
+		for (const EntityDetail* detail : node->GetEntity()->GetAllComponents())
+		{
+			handles.push_back(detail->GetComponentHandle());
+		}
+
+		// the order of the ranks : by type, then by storage index
+		std::sort(handles.begin(), handles.end(), [](const ComponentHandle& a, const ComponentHandle& b)
+		{
+			return a.GetType() != b.GetType() ? a.GetType() < b.GetType() : a.GetValue() < b.GetValue();
+		});
+
+		for (const ComponentHandle& handle : handles)
+		{
+			const Type* type = Type::Find(handle.GetType());
+			const SerializeFunction* functions = type && type->category == ETypeCategory::STRUCTURE
+				                                     ? World::FindSerializeFunction((const Structure*)type)
+				                                     : nullptr;
+			if (functions == nullptr)
+			{
+				continue; // not saved in the snapshots either
+			}
+
+			ComponentState& component = state.components.emplace_back();
+			component.meta = (const Structure*)type;
+
+			const char* comp = (const char*)functions->GetData() + (long long)handle.GetValue() * (long long)
+				component.meta->size;
+			for (const LevelFormat::FieldLayout& field : LevelFormat::StructureLayout::Get(component.meta).fields)
+			{
+				const char* value = comp + field.instanceOffset;
+				switch (field.kind)
+				{
+				case LevelFormat::EFieldKind::STRING:
+					component.strings.push_back(*(const std::string*)value);
+					break;
+				case LevelFormat::EFieldKind::ENTITY_HANDLE:
+					LevelFormat::Append(component.values, NodePosition(positions, value));
+					break;
+				case LevelFormat::EFieldKind::COMPONENT_HANDLE:
+					LevelFormat::Append(component.values, ReferenceLiveComponent(*(const ComponentHandle*)value, positions));
+					break;
+				default:
+					component.values.insert(component.values.end(), value, value + field.size);
+					break;
+				}
+			}
+		}
+
+		return state;
+	}
+
+	bool WorldDelta::Diff(const unsigned int node, const NodeState& from, const NodeState& to, WorldDelta& delta)
+	{
+		if (from.components.size() != to.components.size())
+		{
+			delta.isStructural = true;
+			return true;
+		}
+
+		bool hasChanged = false;
+		if (from.name != to.name
+			|| memcmp(&from.position, &to.position, sizeof(to.position)) != 0
+			|| memcmp(&from.rotation, &to.rotation, sizeof(to.rotation)) != 0
+			|| memcmp(&from.scale, &to.scale, sizeof(to.scale)) != 0)
+		{
+			delta.nodeChanges.push_back({node, (unsigned int)delta.strings.size(), to.position, to.rotation, to.scale});
+			delta.strings.push_back(to.name);
+			hasChanged = true;
+		}
+
+		unsigned int rank = 0;
+		for (size_t index = 0; index < to.components.size(); index++)
+		{
+			const NodeState::ComponentState& before = from.components[index];
+			const NodeState::ComponentState& after = to.components[index];
+			if (before.meta != after.meta)
+			{
+				delta.isStructural = true;
+				return true;
+			}
+
+			rank = index > 0 && to.components[index - 1].meta == after.meta ? rank + 1 : 0;
+
+			size_t valueOffset = 0;
+			size_t stringIndex = 0;
+			for (const LevelFormat::FieldLayout& field : LevelFormat::StructureLayout::Get(after.meta).fields)
+			{
+				size_t value;
+				if (field.kind == LevelFormat::EFieldKind::STRING)
+				{
+					const std::string& str = after.strings[stringIndex];
+					if (before.strings[stringIndex++] == str)
+					{
+						continue;
+					}
+
+					value = delta.strings.size();
+					delta.strings.push_back(str);
+				}
+				else
+				{
+					const size_t size = field.kind == LevelFormat::EFieldKind::ENTITY_HANDLE ? sizeof(int)
+						                    : field.kind == LevelFormat::EFieldKind::COMPONENT_HANDLE ? sizeof(ComponentReference)
+						                    : field.size;
+					const char* newValue = after.values.data() + valueOffset;
+					const bool isSame = memcmp(before.values.data() + valueOffset, newValue, size) == 0;
+					valueOffset += size;
+					if (isSame)
+					{
+						continue;
+					}
+
+					value = delta.values.size();
+					delta.values.insert(delta.values.end(), newValue, newValue + size);
+				}
+
+				delta.fieldChanges.push_back({
+					after.meta, node, rank, field.instanceOffset, field.kind, field.size, value
+				});
+				hasChanged = true;
+			}
+		}
+
+		return hasChanged;
+	}
+
+	bool WorldDelta::Apply() const
+	{
+		if (isStructural)
+		{
+			return false;
+		}
+
+		std::vector<SceneNode*> nodes;
+		CollectNodes(World::GetLevel()->GetRoot(), nodes);
+
+		// resolve every change first : a delta that does not fit the world leaves it untouched
+		for (const NodeChange& change : nodeChanges)
+		{
+			if (change.node >= nodes.size())
+			{
+				return false;
+			}
+		}
+
+		const std::unordered_map<int, unsigned int> positions = LivePositions(nodes);
+
+		const Structure* meta = nullptr;
+		const SerializeFunction* functions = nullptr;
+		std::unordered_map<unsigned long long, int> components;
+		std::unordered_map<long long, std::unordered_map<unsigned long long, int>> handleTargets; // by type, when needed
+
+		struct FieldWrite
+		{
+			char* field;
+			ComponentHandle component; // COMPONENT_HANDLE fields
+		};
+		std::vector<FieldWrite> writes;
+		writes.reserve(fieldChanges.size());
+
+		for (const FieldChange& change : fieldChanges)
+		{
+			if (change.meta != meta)
+			{
+				meta = change.meta;
+				functions = World::FindSerializeFunction(meta);
+				if (functions == nullptr)
+				{
+					return false;
+				}
+
+				IndexLiveComponents(meta, functions, positions, components);
+			}
+
+			const auto component = components.find(RecordKey(change.node, change.rank));
+			if (component == components.end())
+			{
+				return false;
+			}
+
+			FieldWrite& write = writes.emplace_back();
+			write.field = (char*)functions->GetData() + (long long)component->second * (long long)meta->size
+				+ change.instanceOffset;
+
+			if (change.kind != LevelFormat::EFieldKind::COMPONENT_HANDLE)
+			{
+				continue;
+			}
+
+			ComponentReference reference;
+			memcpy(&reference, values.data() + change.value, sizeof(reference));
+			if (reference.key == INVALID_KEY)
+			{
+				continue; // written as an invalid handle
+			}
+
+			auto targets = handleTargets.find(reference.type);
+			if (targets == handleTargets.end())
+			{
+				const Type* type = Type::Find(reference.type);
+				const SerializeFunction* targetFunctions = type && type->category == ETypeCategory::STRUCTURE
+					                                           ? World::FindSerializeFunction((const Structure*)type)
+					                                           : nullptr;
+				if (targetFunctions == nullptr)
+				{
+					return false;
+				}
+
+				targets = handleTargets.emplace(reference.type, std::unordered_map<unsigned long long, int>()).first;
+				IndexLiveComponents((const Structure*)type, targetFunctions, positions, targets->second);
+			}
+
+			const auto target = targets->second.find(reference.key);
+			if (target == targets->second.end())
+			{
+				return false;
+			}
+
+			write.component = ComponentHandle(target->second, reference.type);
+		}
+
+		// write : nothing can fail from here
+		for (const NodeChange& change : nodeChanges)
+		{
+			SceneNode* node = nodes[change.node];
+			node->SetName(strings[change.name]);
+			node->SetPosition(change.position);
+			node->SetRotation(change.rotation);
+			node->SetScale(change.scale);
+		}
+
+		for (size_t index = 0; index < fieldChanges.size(); index++)
+		{
+			const FieldChange& change = fieldChanges[index];
+			char* field = writes[index].field;
+
+			switch (change.kind)
+			{
+			case LevelFormat::EFieldKind::STRING:
+				*(std::string*)field = strings[change.value];
+				break;
+			case LevelFormat::EFieldKind::ENTITY_HANDLE:
+				{
+					int node;
+					memcpy(&node, values.data() + change.value, sizeof(node));
+					*(EntityHandle*)field = node >= 0 && node < (int)nodes.size()
+						                        ? nodes[node]->GetEntity()->GetHandle()
+						                        : EntityHandle();
+					break;
+				}
+			case LevelFormat::EFieldKind::COMPONENT_HANDLE:
+				*(ComponentHandle*)field = writes[index].component;
+				break;
+			default:
+				memcpy(field, values.data() + change.value, change.size);
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	void WorldHistory::Reset()
+	{
+		base = WorldSnapshot::Capture();
+		baseDeltas.clear();
+		CaptureNodes();
+		touchedNodes.clear();
+		undoSteps.clear();
+		redoSteps.clear();
+	}
+
+	void WorldHistory::Touch(const SceneNode* node)
+	{
+		if (node && std::find(touchedNodes.begin(), touchedNodes.end(), node) == touchedNodes.end())
+		{
+			touchedNodes.push_back(node);
+		}
+	}
+
+	bool WorldHistory::Commit()
+	{
+		if (base.IsEmpty())
+		{
+			Reset();
+			return false;
+		}
+
+		std::vector<SceneNode*> liveNodes;
+		CollectNodes(World::GetLevel()->GetRoot(), liveNodes);
+
+		if (levelGeneration != World::GetLevelGeneration())
+		{
+			// reloaded without a commit, as play stopping restores the world as it was : only the nodes are new
+			nodePointers.assign(liveNodes.begin(), liveNodes.end());
+			levelGeneration = World::GetLevelGeneration();
+		}
+
+		if (std::equal(liveNodes.begin(), liveNodes.end(), nodePointers.begin(), nodePointers.end()) == false)
+		{
+			return CommitStructural();
+		}
+
+		const std::unordered_map<int, unsigned int> positions = LivePositions(liveNodes);
+
+		Step step;
+		for (const SceneNode* touched : touchedNodes)
+		{
+			// the touched node of a previous level is not in the world anymore
+			const auto it = std::find(nodePointers.begin(), nodePointers.end(), touched);
+			if (it == nodePointers.end())
+			{
+				continue;
+			}
+
+			const unsigned int node = (unsigned int)(it - nodePointers.begin());
+			NodeState state = NodeState::Capture(touched, positions);
+			if (WorldDelta::Diff(node, nodes[node], state, step.redo) == false)
+			{
+				continue;
+			}
+			if (step.redo.IsStructural())
+			{
+				return CommitStructural();
+			}
+
+			WorldDelta::Diff(node, state, nodes[node], step.undo);
+			step.before.emplace_back(node, nodes[node]);
+			step.after.emplace_back(node, std::move(state));
+		}
+		touchedNodes.clear();
+
+		if (step.redo.IsEmpty())
+		{
+			return false;
+		}
+
+		for (auto& [node, state] : step.after)
+		{
+			nodes[node] = state;
+		}
+		AddBaseDelta(step.redo);
+
+		PushUndoStep(std::move(step));
+		return true;
+	}
+
+	bool WorldHistory::CommitStructural()
+	{
+		Step step;
+		step.isStructural = true;
+		step.beforeBase = std::move(base);
+		step.beforeDeltas = std::move(baseDeltas);
+
+		base = WorldSnapshot::Capture();
+		baseDeltas.clear();
+		step.afterWorld = base;
+
+		CaptureNodes();
+		touchedNodes.clear();
+
+		PushUndoStep(std::move(step));
+		return true;
+	}
+
+	bool WorldHistory::Undo()
+	{
+		if (CanUndo() == false)
+		{
+			return false;
+		}
+
+		Step& step = undoSteps.back();
+		if (step.isStructural)
+		{
+			if (RestoreBase(step.beforeBase, step.beforeDeltas) == false)
+			{
+				return false;
+			}
+
+			base = step.beforeBase;
+			baseDeltas = step.beforeDeltas;
+			CaptureNodes();
+		}
+		else
+		{
+			if (step.undo.Apply() == false)
+			{
+				return false;
+			}
+
+			for (const auto& [node, state] : step.before)
+			{
+				nodes[node] = state;
+			}
+			AddBaseDelta(step.undo);
+		}
+		touchedNodes.clear();
+
+		redoSteps.push_back(std::move(step));
+		undoSteps.pop_back();
+		return true;
+	}
+
+	bool WorldHistory::Redo()
+	{
+		if (CanRedo() == false)
+		{
+			return false;
+		}
+
+		Step& step = redoSteps.back();
+		if (step.isStructural)
+		{
+			if (RestoreBase(step.afterWorld, {}) == false)
+			{
+				return false;
+			}
+
+			base = step.afterWorld;
+			baseDeltas.clear();
+			CaptureNodes();
+		}
+		else
+		{
+			if (step.redo.Apply() == false)
+			{
+				return false;
+			}
+
+			for (const auto& [node, state] : step.after)
+			{
+				nodes[node] = state;
+			}
+			AddBaseDelta(step.redo);
+		}
+		touchedNodes.clear();
+
+		undoSteps.push_back(std::move(step));
+		redoSteps.pop_back();
+		return true;
+	}
+
+	bool WorldHistory::RestoreBase(const WorldSnapshot& snapshot, const std::vector<WorldDelta>& deltas)
+	{
+		if (snapshot.Restore() == false)
+		{
+			return false;
+		}
+
+		for (const WorldDelta& delta : deltas)
+		{
+			if (delta.Apply() == false)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void WorldHistory::AddBaseDelta(const WorldDelta& delta)
+	{
+		// a structural undo replays them : past a point capturing the world again is cheaper
+		if (baseDeltas.size() >= maxSteps)
+		{
+			base = WorldSnapshot::Capture();
+			baseDeltas.clear();
+			return;
+		}
+
+		baseDeltas.push_back(delta);
+	}
+
+	void WorldHistory::CaptureNodes()
+	{
+		std::vector<SceneNode*> liveNodes;
+		CollectNodes(World::GetLevel()->GetRoot(), liveNodes);
+		const std::unordered_map<int, unsigned int> positions = LivePositions(liveNodes);
+
+		nodes.clear();
+		nodes.reserve(liveNodes.size());
+		for (const SceneNode* node : liveNodes)
+		{
+			nodes.push_back(NodeState::Capture(node, positions));
+		}
+
+		nodePointers.assign(liveNodes.begin(), liveNodes.end());
+		levelGeneration = World::GetLevelGeneration();
+	}
+
+	void WorldHistory::PushUndoStep(Step&& step)
+	{
+		undoSteps.push_back(std::move(step));
+		if (undoSteps.size() > maxSteps)
+		{
+			undoSteps.pop_front();
+		}
+		redoSteps.clear();
+	}
+}
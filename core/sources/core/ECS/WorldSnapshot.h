@@ -0,0 +1,150 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "LevelFormat.h"
+
+namespace Core
+{
+	class SceneNode;
+	class Structure;
+
+	// In memory image of the world, in the binary level format
+	class WorldSnapshot
+	{
+	public:
+		static WorldSnapshot Capture();
+
+		bool Restore() const; // reload the whole world from the snapshot
+		bool Save(const char* fileName) const;
+
+		bool IsEmpty() const { return data.empty(); }
+		size_t GetSize() const { return data.size(); }
+		const std::vector<char>& GetData() const { return data; }
+
+	private:
+		std::vector<char> data;
+	};
+
+	// Live state of a node and of its serialized components, with the handles stored the way the deltas store them
+	struct NodeState
+	{
+		struct ComponentState
+		{
+			const Structure* meta;
+			std::vector<char> values; // the fields of the layout in order, STRING fields excluded
+			std::vector<std::string> strings; // the STRING fields in order
+		};
+
+		// positions : entity value to pre-order node position
+		static NodeState Capture(const SceneNode* node, const std::unordered_map<int, unsigned int>& positions);
+
+		std::string name;
+		LibMath::Vector3 position;
+		LibMath::Quaternion rotation;
+		LibMath::Vector3 scale;
+		std::vector<ComponentState> components; // grouped by type, each type in the order of its storage
+	};
+
+	// Reflected fields and node transforms that differ between two snapshots of the same world.
+	// Nodes are identified by their pre-order position and components by (node, type, rank on the node)
+	// so a delta stays valid after the world has been reloaded from a snapshot.
+	class WorldDelta
+	{
+	public:
+		static WorldDelta Diff(const WorldSnapshot& from, const WorldSnapshot& to);
+		// append the changes of one node, return false if there is none
+		static bool Diff(unsigned int node, const NodeState& from, const NodeState& to, WorldDelta& delta);
+
+		// Nodes or components were created or destroyed : the delta cannot be applied, restore the snapshot instead
+		bool IsStructural() const { return isStructural; }
+		bool IsEmpty() const { return isStructural == false && nodeChanges.empty() && fieldChanges.empty(); }
+
+		bool Apply() const; // patch the live world in place, or leave it untouched and return false if the delta does not fit it
+
+	private:
+		struct NodeChange
+		{
+			unsigned int node;
+			unsigned int name; // index in strings
+			LibMath::Vector3 position;
+			LibMath::Quaternion rotation;
+			LibMath::Vector3 scale;
+		};
+
+		struct FieldChange
+		{
+			const Structure* meta;
+			unsigned int node;
+			unsigned int rank;
+			int instanceOffset;
+			LevelFormat::EFieldKind kind;
+			unsigned int size;
+			size_t value; // offset in values, index in strings for STRING fields. ENTITY_HANDLE values are an int node position,
+			              // COMPONENT_HANDLE values the type and (node, rank) key of the component
+		};
+
+		std::vector<NodeChange> nodeChanges;
+		std::vector<FieldChange> fieldChanges;
+		std::vector<char> values;
+		std::vector<std::string> strings;
+		bool isStructural = false;
+	};
+
+	// Undo / redo stack of world deltas.
+	// A commit only captures the nodes touched since the previous one : the rest of the world is known from the last
+	// commit, undo or redo. Creating or destroying nodes or components makes a structural step, which captures
+	// the whole world.
+	class WorldHistory
+	{
+	public:
+		explicit WorldHistory(size_t maxSteps = 64) : maxSteps(maxSteps) {}
+
+		void Reset(); // forget every step, the current world becomes the base state
+		void Touch(const SceneNode* node); // the node or its components may have been edited
+		bool Commit(); // record the changes made since the last commit, return false if there is none
+
+		bool Undo();
+		bool Redo();
+
+		bool CanUndo() const { return undoSteps.empty() == false; }
+		bool CanRedo() const { return redoSteps.empty() == false; }
+
+	private:
+		struct Step
+		{
+			WorldDelta undo;
+			WorldDelta redo;
+			std::vector<std::pair<unsigned int, NodeState>> before; // the changed nodes
+			std::vector<std::pair<unsigned int, NodeState>> after;
+
+			// structural steps : the world before is the base with its deltas applied
+			bool isStructural = false;
+			WorldSnapshot beforeBase;
+			std::vector<WorldDelta> beforeDeltas;
+			WorldSnapshot afterWorld;
+		};
+
+		bool CommitStructural();
+		bool RestoreBase(const WorldSnapshot& snapshot, const std::vector<WorldDelta>& deltas);
+		void AddBaseDelta(const WorldDelta& delta);
+		void CaptureNodes(); // the whole live world
+		void PushUndoStep(Step&& step);
+
+		size_t maxSteps;
+		std::vector<NodeState> nodes; // the world at the last commit, undo or redo, by pre-order position
+		std::vector<const SceneNode*> nodePointers; // same order, to detect nodes created or destroyed
+		std::vector<const SceneNode*> touchedNodes;
+		unsigned int levelGeneration = 0;
+
+		WorldSnapshot base; // the last full capture
+		std::vector<WorldDelta> baseDeltas; // applied to the world since base was captured
+
+		std::deque<Step> undoSteps;
+		std::vector<Step> redoSteps;
+	};
+}
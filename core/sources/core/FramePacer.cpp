@@ -0,0 +1,121 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX // std::min and std::max below
+#include <Windows.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+namespace Core
+{
+	FramePacer::~FramePacer()
+	{
+#ifdef _WIN32
+		if (timer)
+		{
+			CloseHandle(timer);
+		}
+#endif
+	}
+
+	void FramePacer::SetTargetRate(const float framesPerSecond)
+	{
+		if (framesPerSecond == targetRate)
+		{
+			return;
+		}
+
+		targetRate = framesPerSecond;
+		period = framesPerSecond > 0.f
+			? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond))
+			: Clock::duration::zero();
+
+		// the new rate applies from now, not from a deadline set for the previous one
+		deadline = std::min(deadline, Clock::now() + period);
+	}
+
+	float FramePacer::WaitNextFrame()
+	{
+		Clock::time_point now = Clock::now();
+		const Clock::time_point waitStart = now;
+
+		if (period > Clock::duration::zero())
+		{
+			while (deadline - now > spinMargin)
+			{
+				const Clock::duration request = deadline - now - spinMargin;
+				Sleep(request);
+
+				const Clock::time_point woken = Clock::now();
+				const Clock::duration lateness = (woken - now) - request;
+				now = woken;
+
+				// grows at once after a late wake up, shrinks slowly so one lucky sleep does not cause a miss
+				if (lateness > spinMargin)
+				{
+					spinMargin = std::min(lateness, MAX_SPIN_MARGIN);
+				}
+				else
+				{
+					spinMargin -= (spinMargin - lateness) / 16;
+				}
+				spinMargin = std::max(spinMargin, MIN_SPIN_MARGIN);
+			}
+
+			while (now < deadline)
+			{
+				std::this_thread::yield();
+				now = Clock::now();
+			}
+
+			// next budget counted from the deadline so the rate does not drift, unless a long frame put us behind
+			deadline = now - deadline < period ? deadline + period : now + period;
+		}
+
+		lastWaitTime = std::chrono::duration<float>(now - waitStart).count();
+
+		const float elapsed = std::chrono::duration<float>(now - lastFrame).count();
+		lastFrame = now;
+		return elapsed;
+	}
+
+	void FramePacer::Restart()
+	{
+		lastFrame = Clock::now();
+		deadline = lastFrame + period;
+	}
+
+	void FramePacer::Sleep(const Clock::duration duration)
+	{
+#ifdef _WIN32
+		// Sleep() is rounded to the scheduler tick, up to 15.6 ms, the high resolution timer is not
+		if (hasTriedTimer == false)
+		{
+			// fails before Windows 10 1803, sleep_for is used then
+			timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+			hasTriedTimer = true;
+		}
+
+		if (timer)
+		{
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -std::chrono::duration_cast<std::chrono::duration<long long, std::ratio<1, 10000000>>>(
+				duration).count(); // relative, in 100 ns
+
+			if (SetWaitableTimer(timer, &dueTime, 0, nullptr, nullptr, FALSE))
+			{
+				WaitForSingleObject(timer, INFINITE);
+				return;
+			}
+		}
+#endif
+		std::this_thread::sleep_for(duration);
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+
+namespace Core
+{
+	// Holds the frames to a target rate on the steady clock. The remaining budget is slept, except for the
+	// last spinMargin which is spun : the margin follows how late the sleeps of this machine wake up.
+	class FramePacer
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		FramePacer() = default;
+		FramePacer(const FramePacer&) = delete;
+		FramePacer(FramePacer&&) = delete;
+		~FramePacer();
+
+		FramePacer& operator=(const FramePacer&) = delete;
+		FramePacer& operator=(FramePacer&&) = delete;
+
+		void SetTargetRate(float framesPerSecond); // <= 0 is uncapped
+		[[nodiscard]] float GetTargetRate() const { return targetRate; }
+
+		// waits until the budget of the frame is spent, returns the seconds since the previous call
+		float WaitNextFrame();
+		void Restart(); // the next frame is counted from now
+		[[nodiscard]] Clock::time_point GetFrameTime() const { return lastFrame; } // when the last wait ended
+
+		[[nodiscard]] float GetLastWaitTime() const { return lastWaitTime; } // seconds
+		[[nodiscard]] float GetSpinMargin() const { return std::chrono::duration<float>(spinMargin).count(); }
+
+	private:
+		void Sleep(Clock::duration duration);
+
+		static constexpr Clock::duration MIN_SPIN_MARGIN = std::chrono::microseconds(200);
+		static constexpr Clock::duration MAX_SPIN_MARGIN = std::chrono::milliseconds(4);
+
+		float targetRate = 0.f;
+		Clock::duration period = Clock::duration::zero();
+		Clock::duration spinMargin = std::chrono::milliseconds(1);
+
+		Clock::time_point deadline = Clock::now(); // end of the current frame budget
+		Clock::time_point lastFrame = Clock::now();
+		float lastWaitTime = 0.f;
+
+		void* timer = nullptr; // high resolution waitable timer on Windows, sleep_for otherwise
+		bool hasTriedTimer = false;
+	};
+}
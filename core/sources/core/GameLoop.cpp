@@ -1,96 +1,329 @@
 #include "GameLoop.h"
-#include <chrono>
 
 
 #include "TimerManager.h"
 #include "../../../physic/sources/physic/PhysicsManager.h"
-#include "../../../render/sources/imgui/UIDebugWindow.h"
-#include "../../../sound/sources/sound/SoundManager.h"
-#include "InputManager/DefaultInputManager.h"
+#include "DebugWindow/Profiler.h"
+#include "ECS/Event.h"
 #include "ECS/World.h"
+#include "InputManager/DefaultInputManager.h"
+#include "filesys/Config.h"
 #include "scenegraph/SceneGraph.h"
 
 namespace Core
 {
 	bool GameLoop::isPause = true;
 
-	GameLoop::GameLoop() : app(1600, 900, "Clone Engine")
-	{
-	}
-
-	void GameLoop::ProcessInputs()
+	GameLoop::GameLoop(GameLoopFrontend* frontend) : frontend(frontend)
 	{
-		GLFW::GLFWPollEvents();
-		DefaultInputManager::ProcessInputs();
 	}
 
 	void GameLoop::UpdateGameplay(const float deltaTime)
 	{
 		TimerManager::GetTimerManager().Tick(deltaTime);
 		World::UpdateAll(deltaTime);
-		Sound::SoundManager::Update(deltaTime);
 	}
 
-	void GameLoop::UpdatePhysics(const float delta)
+	void GameLoop::FixedUpdate(const float step)
 	{
-		Physics::Advance(delta);
+		World::GetLevel()->StorePreviousTransforms();
+
+		if (isAsyncPhysics)
+		{
+			PROFILE_ZONE("Physics");
+			Physics::EndAdvance(); // the step kicked by the previous FixedUpdate
+
+			// while no step is in flight, so the actors moved by gameplay start this one where gameplay put them
+			World::GetLevel()->UpdateAll();
+			Physics::BeginAdvance(step);
+		}
+		else
+		{
+			PROFILE_ZONE("Physics");
+			UpdatePhysics(step);
+		}
+
+		{
+			PROFILE_ZONE("Events");
+			EventBus::DispatchAll(); // contacts of the physics step above
+		}
+
+		{
+			PROFILE_ZONE("Gameplay");
+			UpdateGameplay(step);
+		}
+
+		{
+			PROFILE_ZONE("Update transforms");
+			World::GetLevel()->UpdateAll(); // the next step stores clean transforms
+		}
 	}
 
-	void GameLoop::Render(const float deltaTime) const
+	void GameLoop::UpdatePhysics(const float delta)
 	{
-		app.DrawFrame(deltaTime);
+		Physics::Advance(delta);
 	}
 
-	void GameLoop::Run()
+	void GameLoop::Run(const int maxFrames)
 	{
-		auto start = std::chrono::system_clock::now();
 		float lag = 0.0;
 
 #ifdef _SHIPPING
 		isPause = false;
 #endif
 
-		while (isRunning)
+		PROFILE_THREAD("Main");
+
+		if (IsHeadless())
+		{
+			// nobody to press play
+			isPause = false;
+			if (World::HasStarted() == false)
+			{
+				World::Start();
+			}
+			BeginInputSession();
+		}
+
+		framePacer.Restart(); // not counting the loading done before Run
+
+		for (int frame = 0; isRunning && (maxFrames <= 0 || frame < maxFrames); frame++)
 		{
 			if (needsWorldReload)
 			{
+				if (frontend)
+				{
+					frontend->WaitRender();
+				}
+				Physics::EndAdvance();
 				World::Stop();
+				EndInputSession();
+
+				// skip the reset if another level was opened since play started
+				if (playSnapshot.IsEmpty() == false && playSnapshotGeneration == World::GetLevelGeneration())
+				{
+					playSnapshot.Restore();
+				}
+				playSnapshot = WorldSnapshot();
+
 				needsWorldReload = false;
 			}
 
-			START_BENCHMARK("Frame time");
+			PROFILE_FRAME();
+
+			if (IsHeadless())
+			{
+				RunHeadlessFrame();
+			}
+			else
+			{
+				RunFrame(lag);
+			}
+		}
+		PROFILE_FRAME(); // aggregates the last frame
+
+		Physics::EndAdvance();
+		EndInputSession(); // closed while playing
+	}
 
-			auto current = std::chrono::system_clock::now();
-			elapsedTime = std::chrono::duration<float>(current - start).count();
-			start = current;
+	void GameLoop::RunFrame(float& lag)
+	{
+		{
+			PROFILE_ZONE("Frame pacing");
+			const bool isIdle = frontend->IsActive() == false;
+			framePacer.SetTargetRate(isIdle ? BACKGROUND_FPS : isPause ? PAUSED_FPS : targetFrameRate);
+			elapsedTime = framePacer.WaitNextFrame();
+		}
 
-			ProcessInputs();
+		PROFILE_ZONE("Frame time");
 
-			if (!isPause)
-			{
-				lag += elapsedTime;
+		Config::UpdateWatchedFiles(elapsedTime); // before anything reads the configs this frame
+
+		frontend->PollInputs();
 
-				short loopCount = 0;
-				while (lag >= S_PER_FRAME)
+		if (!isPause)
+		{
+			lag += elapsedTime;
+			const InputClock::time_point frameTime = framePacer.GetFrameTime();
+
+			short loopCount = 0;
+			while (lag >= fixedStep)
+			{
+				lag -= fixedStep;
+				if (loopCount < MAX_FRAME_SKIP)
 				{
-					if (loopCount < MAX_FRAME_SKIP)
-					{
-						UpdatePhysics(S_PER_FRAME);
-						loopCount++;
-					}
-					lag -= S_PER_FRAME;
+					// the simulation is lag behind the frame time once this step is done, it sees the inputs up to there
+					const auto stepEnd = std::chrono::duration_cast<InputClock::duration>(std::chrono::duration<float>(lag));
+					ProcessStepInputs(frameTime - stepEnd);
+
+					FixedUpdate(fixedStep);
+					loopCount++;
 				}
+			}
 
-				UpdateGameplay(elapsedTime);
+			// the rendered transforms are this far between the last two steps
+			interpolationAlpha = lag / fixedStep;
 
-				UpdateAnimation(elapsedTime);
-			}
+			frontend->Update(elapsedTime);
+			UpdateAnimation(elapsedTime);
+		}
+		else
+		{
+			frontend->ProcessInputs(InputClock::now());
+			interpolationAlpha = 1.f;
+			Physics::EndAdvance(); // the editor moves the actors while paused
+		}
 
-			// Deep clean world transform
+		{
+			PROFILE_ZONE("Update transforms");
+			// Deep clean world transform, for the edits made outside of the simulation steps
 			World::GetLevel()->UpdateAll();
+		}
 
-			Render(elapsedTime);
-			STOP_BENCHMARK("Frame time");
+		{
+			PROFILE_ZONE("Render");
+			frontend->Render(elapsedTime, isPipelinedRendering);
+		}
+	}
+
+	void GameLoop::RunHeadlessFrame()
+	{
+		// as fast as possible and independent from the wall clock, the same run gives the same steps
+		PROFILE_ZONE("Frame time");
+
+		elapsedTime = fixedStep;
+		interpolationAlpha = 1.f;
+
+		ProcessStepInputs(InputClock::now());
+		if (isRunning == false)
+		{
+			return; // end of the replayed inputs
+		}
+
+		FixedUpdate(fixedStep);
+		UpdateAnimation(fixedStep);
+	}
+
+	void GameLoop::ProcessStepInputs(const InputClock::time_point until) const
+	{
+		static std::vector<InputRecording::Action> actions;
+
+		if (inputMode == EInputMode::REPLAY)
+		{
+			if (inputRecording.ReadStep(actions))
+			{
+				DefaultInputManager::ReplayInputs(actions);
+				return;
+			}
+
+			LOGF(LOG_INFO, ELogChannel::CLOG_GENERAL, "Input replay done after %u steps", inputRecording.GetStepCount());
+			SetInputMode(EInputMode::LIVE);
+			if (IsHeadless())
+			{
+				Stop();
+				return;
+			}
+		}
+
+		if (frontend)
+		{
+			frontend->ProcessInputs(until);
+		}
+
+		if (inputMode == EInputMode::RECORD)
+		{
+			DefaultInputManager::RecordInputs(actions);
+			inputRecording.AddStep(actions);
+		}
+	}
+
+	bool GameLoop::CanChangeInputMode()
+	{
+		return World::HasStarted() == false;
+	}
+
+	bool GameLoop::RecordInputs(const char* fileName)
+	{
+		if (CanChangeInputMode() == false)
+		{
+			LOG(LOG_WARNING, "Cannot record the inputs while playing, stop first", ELogChannel::CLOG_GENERAL);
+			return false;
+		}
+
+		SetInputMode(EInputMode::RECORD);
+		inputRecordingFile = fileName;
+		inputRecording.Clear(fixedStep);
+		return true;
+	}
+
+	bool GameLoop::ReplayInputs(const char* fileName)
+	{
+		if (CanChangeInputMode() == false)
+		{
+			LOG(LOG_WARNING, "Cannot replay the inputs while playing, stop first", ELogChannel::CLOG_GENERAL);
+			return false;
+		}
+
+		if (inputRecording.Load(fileName) == false)
+		{
+			LOGF(LOG_WARNING, ELogChannel::CLOG_GENERAL, "Could not load the input recording %s", fileName);
+			return false;
+		}
+
+		SetInputMode(EInputMode::REPLAY);
+		return true;
+	}
+
+	bool GameLoop::UseLiveInputs()
+	{
+		if (CanChangeInputMode() == false)
+		{
+			LOG(LOG_WARNING, "Cannot switch to the live inputs while playing, stop first", ELogChannel::CLOG_GENERAL);
+			return false;
+		}
+
+		SetInputMode(EInputMode::LIVE);
+		return true;
+	}
+
+	void GameLoop::SetSimulationRate(const float stepsPerSecond)
+	{
+		configuredStep = 1.f / stepsPerSecond;
+		if (inputMode != EInputMode::REPLAY)
+		{
+			fixedStep = configuredStep;
+		}
+	}
+
+	void GameLoop::SetInputMode(const EInputMode mode)
+	{
+		inputMode = mode;
+		// the same steps give the same session
+		fixedStep = mode == EInputMode::REPLAY ? inputRecording.GetFixedStep() : configuredStep;
+	}
+
+	void GameLoop::BeginInputSession()
+	{
+		if (inputMode == EInputMode::RECORD)
+		{
+			inputRecording.Clear(fixedStep);
+		}
+		else if (inputMode == EInputMode::REPLAY)
+		{
+			inputRecording.Rewind();
+		}
+	}
+
+	void GameLoop::EndInputSession()
+	{
+		if (inputMode == EInputMode::RECORD && inputRecording.GetStepCount() > 0)
+		{
+			if (inputRecording.Save(inputRecordingFile.c_str()))
+			{
+				LOGF(LOG_INFO, ELogChannel::CLOG_GENERAL, "%u input steps recorded to %s", inputRecording.GetStepCount(),
+				     inputRecordingFile);
+			}
+			inputRecording.Clear(fixedStep);
 		}
 	}
 
@@ -104,7 +337,12 @@ namespace Core
 			if (World::HasStarted())
 				World::UnPause();
 			else
+			{
+				playSnapshot = WorldSnapshot::Capture();
+				playSnapshotGeneration = World::GetLevelGeneration();
 				World::Start();
+				BeginInputSession();
+			}
 		}
 		else
 		{
@@ -2,50 +2,115 @@
 
 #include <string>
 
-#include "../../../render/sources/render/RenderInclude.h"
+#include "FramePacer.h"
+#include "GameLoopFrontend.h"
+#include "InputManager/InputRecording.h"
+#include "ECS/WorldSnapshot.h"
 
 constexpr float MAX_FPS = 240;
-constexpr float S_PER_FRAME = 1000 / MAX_FPS / 1000;
+constexpr float S_PER_FRAME = 1000 / MAX_FPS / 1000; // default simulation step
 constexpr short MAX_FRAME_SKIP = 10;
+constexpr float PAUSED_FPS = 60; // editor paused, the UI is still used
+constexpr float BACKGROUND_FPS = 10; // window unfocused or minimized
 
 namespace Core
 {
 	class GameLoop
 	{
 	public:
-		GameLoop();
+		// without frontend the loop is headless : no window, inputs, audio nor rendering, and deterministic,
+		// every frame is exactly one simulation step and the world plays from the start
+		explicit GameLoop(GameLoopFrontend* frontend = nullptr);
 		virtual ~GameLoop() = default;
 
-		static void ProcessInputs();
-
 		static void UpdateGameplay(float deltaTime);
 
 		static void UpdatePhysics(float delta);
 
+		// one simulation step : physics, events, gameplay and scene graph at the fixed rate
+		static void FixedUpdate(float step);
+
 		static void UpdateAnimation(const float)
 		{
 		}
 
-		void Render(float deltaTime) const;
+		void Run(int maxFrames = 0); // until Stop() when 0
 
-		void Run();
+		[[nodiscard]] bool IsHeadless() const { return frontend == nullptr; }
 
 		static void Stop() { isRunning = false; }
 		static void TogglePause();
 		static bool IsPaused() { return isPause; }
 		static void StopWorld();
 
-
-		[[nodiscard]] Render::RenderApplication GetApp() const { return app; }
+		// renders frame N on the render thread while frame N+1 is simulated, one frame of latency
+		static void SetPipelinedRendering(const bool value) { isPipelinedRendering = value; }
+		static bool IsPipelinedRendering() { return isPipelinedRendering; }
+
+		// a step simulates the physics on the workers while gameplay runs against the results of the previous one,
+		// which are fetched at the start of the next step : the physics answer one step later
+		static void SetAsyncPhysics(const bool value) { isAsyncPhysics = value; }
+		static bool IsAsyncPhysics() { return isAsyncPhysics; }
+
+		// gameplay and physics run at this rate whatever the frame rate, rendering interpolates between the last two steps
+		// a replay steps at its recorded rate, this one is back when it ends or the mode changes
+		static void SetSimulationRate(float stepsPerSecond);
+		static float GetFixedStep() { return fixedStep; }
+		static float GetInterpolationAlpha() { return interpolationAlpha; }
+
+		// frame rate while playing with the window focused, <= 0 is uncapped
+		static void SetTargetFrameRate(const float framesPerSecond) { targetFrameRate = framesPerSecond; }
+		static float GetTargetFrameRate() { return targetFrameRate; }
+
+		// the inputs of each step of the next play session, written to fileName when it stops
+		static bool RecordInputs(const char* fileName);
+		// the next play session steps with the recorded inputs, at the recorded rate, then goes back to the live ones.
+		// Headless, the loop stops at the end of the recording.
+		static bool ReplayInputs(const char* fileName);
+		static bool UseLiveInputs();
+		// the input mode, and the rate of a replay, only change between play sessions : false while the world is started
+		static bool CanChangeInputMode();
+		static bool IsRecordingInputs() { return inputMode == EInputMode::RECORD; }
+		static bool IsReplayingInputs() { return inputMode == EInputMode::REPLAY; }
+		static unsigned int GetRecordedStepCount() { return inputRecording.GetStepCount(); }
 
 
 	private:
+		enum class EInputMode
+		{
+			LIVE,
+			RECORD,
+			REPLAY,
+		};
+
 		inline static bool isRunning = true;
 		static bool isPause;
 		inline static float elapsedTime = 0.f;
+		inline static bool isPipelinedRendering = false;
+		inline static bool isAsyncPhysics = false;
+		inline static float fixedStep = S_PER_FRAME;
+		inline static float configuredStep = S_PER_FRAME; // of SetSimulationRate, fixedStep outside of a replay
+		inline static float interpolationAlpha = 1.f; // in [0, 1], 1 renders the last simulation step
+		inline static float targetFrameRate = MAX_FPS;
 
-		Render::RenderApplication app;
+		void RunFrame(float& lag);
+		void RunHeadlessFrame();
+		void ProcessStepInputs(InputClock::time_point until) const;
+
+		static void SetInputMode(EInputMode mode); // and the step of the mode
+		static void BeginInputSession(); // play starts
+		static void EndInputSession(); // play stops
+
+		FramePacer framePacer;
+
+		GameLoopFrontend* frontend = nullptr; // not owned
 
 		inline bool static needsWorldReload = false;
+		inline static WorldSnapshot playSnapshot; // level state before play, restored by StopWorld()
+		inline static unsigned int playSnapshotGeneration = 0;
+
+		inline static EInputMode inputMode = EInputMode::LIVE;
+		inline static InputRecording inputRecording;
+		inline static std::string inputRecordingFile;
 	};
 }
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "InputManager/InputEventRing.h"
+
+namespace Core
+{
+	// What the game loop drives around the simulation : window, inputs, audio and rendering.
+	// Implemented by the executables linking the renderer, a GameLoop without frontend runs headless.
+	class GameLoopFrontend
+	{
+	public:
+		virtual ~GameLoopFrontend() = default;
+
+		virtual void PollInputs() = 0; // once per frame : window events into the input ring, mouse moves
+		virtual void ProcessInputs(InputClock::time_point until) = 0; // the actions received up to until
+		virtual void Update(float deltaTime) = 0; // once per frame while playing, audio
+		virtual void Render(float deltaTime, bool isPipelined) = 0;
+		virtual void WaitRender() = 0; // before changes the frame in flight must not see
+		[[nodiscard]] virtual bool IsActive() const = 0; // false lowers the frame rate, e.g. window unfocused
+	};
+}
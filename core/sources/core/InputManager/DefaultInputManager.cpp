@@ -4,8 +4,6 @@
 
 namespace Core
 {
-	InputManager<EActionEnum> DefaultInputManager::defaultInputManager;
-
 	void DefaultInputManager::Init(GLFWwindow* window)
 	{
 		defaultInputManager.InitInputManager(window);
@@ -1,5 +1,6 @@
 #pragma once
 #include "InputManager.h"
+#include "InputRecording.h"
 
 enum class EActionEnum
 {
@@ -41,10 +42,38 @@ namespace Core
 		static void GetMousePosition(double* xPos, double* yPos) { defaultInputManager.GetMousePosition(xPos, yPos); }
 
 		static void ProcessInputs() { defaultInputManager.Update(); }
+		static void ProcessInputs(const InputClock::time_point until) { defaultInputManager.UpdateActions(until); }
+		static void ProcessMouse() { defaultInputManager.UpdateRanges(); }
+
+		static void RecordInputs(std::vector<InputRecording::Action>& actions) // changes of the last ProcessInputs
+		{
+			actions.clear();
+			for (const InputEvent<EActionEnum>& change : defaultInputManager.GetLastChanges())
+			{
+				actions.push_back({static_cast<unsigned char>(change.action), static_cast<unsigned char>(change.state)});
+			}
+		}
+
+		static void ReplayInputs(const std::vector<InputRecording::Action>& actions) // in place of ProcessInputs
+		{
+			static std::vector<InputEvent<EActionEnum>> changes;
+			changes.clear();
+			for (const InputRecording::Action& action : actions)
+			{
+				if (action.action < static_cast<unsigned char>(EActionEnum::NO_ACTION)
+					&& action.state <= static_cast<unsigned char>(EActionState::HOLD))
+				{
+					changes.push_back({static_cast<EActionEnum>(action.action), static_cast<EActionState>(action.state),
+					                   InputClock::now()});
+				}
+			}
+			defaultInputManager.ReplayActions(changes);
+		}
 
 	private:
 		DefaultInputManager() = default;
 
-		static InputManager<EActionEnum> defaultInputManager;
+		// defined here rather than with Init, the headless builds replay inputs without linking the window
+		inline static InputManager<EActionEnum> defaultInputManager;
 	};
 }
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace Core
+{
+	enum class EActionState;
+
+	using InputClock = std::chrono::steady_clock;
+
+	template <typename ActionEnum>
+	struct InputEvent
+	{
+		ActionEnum action;
+		EActionState state; // PRESSED or RELEASED
+		InputClock::time_point time; // when the callback received it
+	};
+
+	// Single producer single consumer ring without lock : the input callbacks push from the thread polling the window,
+	// the game loop pops, neither waits for the other. Full, the newest events are dropped and counted.
+	template <typename ActionEnum, size_t Capacity = 256>
+	class InputEventRing
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "InputEventRing : Capacity must be a power of two");
+
+	public:
+		bool Push(const InputEvent<ActionEnum>& event)
+		{
+			const size_t tail = pushPos.load(std::memory_order_relaxed);
+			if (tail - popPos.load(std::memory_order_acquire) == Capacity)
+			{
+				droppedCount.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			events[tail & (Capacity - 1)] = event;
+			pushPos.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// oldest event not popped yet, nullptr when empty, valid until Pop()
+		[[nodiscard]] const InputEvent<ActionEnum>* Front() const
+		{
+			const size_t head = popPos.load(std::memory_order_relaxed);
+			if (head == pushPos.load(std::memory_order_acquire))
+			{
+				return nullptr;
+			}
+			return &events[head & (Capacity - 1)];
+		}
+
+		void Pop() { popPos.store(popPos.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+		[[nodiscard]] size_t GetDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+
+	private:
+		InputEvent<ActionEnum> events[Capacity]{};
+
+		// own cache lines, the producer and the consumer each write one
+		alignas(64) std::atomic<size_t> pushPos{0};
+		alignas(64) std::atomic<size_t> popPos{0};
+		std::atomic<size_t> droppedCount{0};
+	};
+}
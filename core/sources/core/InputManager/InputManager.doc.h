@@ -1,7 +1,9 @@
 #pragma once
 #include "core/CLog.h"
-#include <queue>
 #include <unordered_map>
+#include <vector>
+
+#include "InputEventRing.h"
 
 namespace Core
 {
@@ -25,7 +27,7 @@ namespace Core
 	template<typename ActionEnum>
 	class InputManager
 	{
-		using InputQueue = std::queue<std::pair<ActionEnum, EActionState>>;
+		using InputQueue = InputEventRing<ActionEnum>;
 
 	public:
 		InputManager() = delete;
@@ -38,10 +40,38 @@ namespace Core
 		InputManager& operator=(InputManager&& other) = delete;
 
         /**
-		 * Update keyboard and mouse inputs.
+		 * Update keyboard and mouse inputs with everything received so far.
 		 */
 		void Update();
 
+        /**
+		 * Applies the actions received up to the given time, then broadcasts their delegates.
+		 * Called before each simulation step with the time the step ends, so every step sees the inputs of its own time.
+		 * Events received later stay in the ring for the next call.
+		 *
+		 * @param until - Latest timestamp applied.
+		 */
+		void UpdateActions(InputClock::time_point until);
+
+        /**
+		 * Updates the mouse move and scroll since the previous call, once per frame.
+		 */
+		void UpdateRanges();
+
+        /**
+		 * Same as UpdateActions but applies the given changes instead of the received ones, to replay a recording.
+		 *
+		 * @param changes - Action state changes of the replayed step.
+		 */
+		void ReplayActions(const std::vector<InputEvent<ActionEnum>>& changes);
+
+        /**
+		 * Returns the changes applied by the last UpdateActions or ReplayActions call, to record them.
+		 *
+		 * @return Action state changes of the last update.
+		 */
+		[[nodiscard]] const std::vector<InputEvent<ActionEnum>>& GetLastChanges() const { return lastChanges; }
+
         /**
 		 * Displays the mouse cursor on the screen. Or hide it if it's already displayed.
 		 */
@@ -89,6 +119,22 @@ namespace Core
 			return currentState[static_cast<int>(action)];
 		}
 
+        /**
+		 * Returns when the current state of the specified action was received by the callback.
+		 * Finer than the frame, for the gameplay that needs to know when in the frame an input happened.
+		 *
+		 * @param action - ActionEnum action
+		 * @return Timestamp of the last state change of the action.
+		 */
+		[[nodiscard]] InputClock::time_point GetStateTime(ActionEnum action) const { return stateTime[static_cast<int>(action)]; }
+
+        /**
+		 * Returns the number of events lost because the ring was full.
+		 *
+		 * @return Dropped event count since the creation of the InputManager.
+		 */
+		[[nodiscard]] size_t GetDroppedEventCount() const { return pendingChange.GetDroppedCount(); }
+
         /**
 		 * Finds and returns the first GLFW input bound to the specified ActionEnum action.
 		 * Returns GLFW_KEY_UNKNOWN if no input was found.
@@ -191,7 +237,8 @@ namespace Core
 		static InputManager* GetManager(GLFWwindow* window);
 
         /**
-		 * Adds the specified GLFW Input linked ActionEnum to the pendingChange InputQueue for it to be processed later.
+		 * Adds the specified GLFW Input linked ActionEnum to the pendingChange InputQueue for it to be processed later,
+		 * timestamped with the time of the callback. Unbound inputs are ignored.
 		 * 
 		 * @param window - GLFW window linked to the triggered input
 		 * @param glfwInput - Triggered GLFW input
@@ -253,9 +300,12 @@ namespace Core
 		void UpdateOldState();
 
         /**
-		 * Apply all the pendingChange InputQueue to the corresponding inputs.
+		 * Apply the pendingChange InputQueue events received up to the given time to the corresponding inputs.
+		 * Stops at the second event of a same action, so a press and a release in the same update do not hide the press.
+		 *
+		 * @param until - Latest timestamp applied.
 		 */
-		void UpdateNewState();
+		void UpdateNewState(InputClock::time_point until);
 
         /**
 		 * Updates the mouse scrolling and position variables.
@@ -278,6 +328,11 @@ namespace Core
 		 */
 		EActionState	currentState[static_cast<int>(ActionEnum::NO_ACTION)]{};
 
+        /**
+		 * Array of timestamps of the last state change for each action of the given ActionEnum.
+		 */
+		InputClock::time_point	stateTime[static_cast<int>(ActionEnum::NO_ACTION)]{};
+
         /**
 		 * Current mouse scroll.
 		 */
@@ -294,10 +349,15 @@ namespace Core
 		double		currentMouseHorizontalMove = .0;
 
         /**
-		 * Actions queue waiting to be processed and applied.
+		 * Timestamped actions waiting to be processed and applied, lock free single producer single consumer ring.
 		 */
 		InputQueue	pendingChange;
 
+        /**
+		 * Changes applied by the last update, cleared by the next one.
+		 */
+		std::vector<InputEvent<ActionEnum>>	lastChanges;
+
         /**
 		 * Amount of mouse scrolling waiting to be applied.
 		 */
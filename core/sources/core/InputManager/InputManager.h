@@ -1,8 +1,10 @@
 #pragma once
 #include "../CLog.h"
 #include "../Delegate.h"
-#include <queue>
 #include <unordered_map>
+#include <vector>
+
+#include "InputEventRing.h"
 
 #include "../../../../render/sources/glfw/GLFWEncapsulation.h"
 
@@ -25,7 +27,7 @@ namespace Core
 	template <typename ActionEnum>
 	class InputManager
 	{
-		using InputQueue = std::queue<std::pair<ActionEnum, EActionState>>;
+		using InputQueue = InputEventRing<ActionEnum>;
 
 	public:
 		InputManager() = default;
@@ -39,7 +41,16 @@ namespace Core
 
 		void InitInputManager(GLFWwindow* w);
 
-		void Update();
+		void Update(); // everything received so far
+
+		// the actions received up to until then their delegates, lets each simulation step see the inputs of its own time
+		void UpdateActions(InputClock::time_point until);
+		void UpdateRanges(); // mouse move and scroll since the previous call
+
+		// like UpdateActions with these changes instead of the received ones, to replay a recording
+		void ReplayActions(const std::vector<InputEvent<ActionEnum>>& changes);
+		// changes applied by the last UpdateActions, to record them
+		[[nodiscard]] const std::vector<InputEvent<ActionEnum>>& GetLastChanges() const { return lastChanges; }
 
 		void ToggleMouseCapture();
 		[[nodiscard]] bool IsMouseCaptured() const { return isMouseCaptured; }
@@ -58,6 +69,14 @@ namespace Core
 			return currentState[static_cast<int>(action)];
 		}
 
+		// when the current state of the action was received, finer than the frame for the gameplay needing it
+		[[nodiscard]] InputClock::time_point GetStateTime(ActionEnum action) const
+		{
+			return stateTime[static_cast<int>(action)];
+		}
+
+		[[nodiscard]] size_t GetDroppedEventCount() const { return pendingChange.GetDroppedCount(); }
+
 		[[nodiscard]] int FindFirstBoundInput(ActionEnum action) const;
 		[[nodiscard]] ActionEnum GetBoundAction(int glfwInput) const { return actions[glfwInput]; }
 		bool Bind(int glfwInput, ActionEnum action);
@@ -93,7 +112,7 @@ namespace Core
 		static void MouseScrollCallback(GLFWwindow* window, double xOffset, double yOffset);
 
 		void UpdateOldState();
-		void UpdateNewState();
+		void UpdateNewState(InputClock::time_point until);
 		void UpdateRangeState();
 		void BroadcastDelegates();
 
@@ -104,11 +123,13 @@ namespace Core
 		OnKeyAction onReleasedDelegates[static_cast<int>(ActionEnum::NO_ACTION)]{};
 
 		EActionState currentState[static_cast<int>(ActionEnum::NO_ACTION)]{};
+		InputClock::time_point stateTime[static_cast<int>(ActionEnum::NO_ACTION)]{};
 		double currentMouseScroll = .0;
 		double currentMouseVerticalMove = .0;
 		double currentMouseHorizontalMove = .0;
 
-		InputQueue pendingChange;
+		InputQueue pendingChange; // timestamped, filled by the callbacks
+		std::vector<InputEvent<ActionEnum>> lastChanges;
 		double pendingMouseScroll = 0;
 		double mouseOldVerticalPosition = 0;
 		double mouseOldHorizontalPosition = 0;
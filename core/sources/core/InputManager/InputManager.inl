@@ -26,16 +26,42 @@ namespace Core
 
 	template<typename ActionEnum>
 	void InputManager<ActionEnum>::Update()
+	{
+		UpdateActions(InputClock::now());
+		UpdateRanges();
+	}
+
+	template<typename ActionEnum>
+	void InputManager<ActionEnum>::UpdateActions(const InputClock::time_point until)
 	{
 		UpdateOldState(); // compute hold and free state
 
-		UpdateNewState(); // compute press and release state
+		UpdateNewState(until); // compute press and release state
 
-		UpdateRangeState(); // compute mouse move and mouse scroll value
+		BroadcastDelegates();
+	}
+
+	template<typename ActionEnum>
+	void InputManager<ActionEnum>::ReplayActions(const std::vector<InputEvent<ActionEnum>>& changes)
+	{
+		UpdateOldState();
+
+		for (const InputEvent<ActionEnum>& change : changes)
+		{
+			currentState[static_cast<int>(change.action)] = change.state;
+			stateTime[static_cast<int>(change.action)] = change.time;
+		}
+		lastChanges = changes;
 
 		BroadcastDelegates();
 	}
 
+	template<typename ActionEnum>
+	void InputManager<ActionEnum>::UpdateRanges()
+	{
+		UpdateRangeState(); // compute mouse move and mouse scroll value
+	}
+
 	template<typename ActionEnum>
 	void InputManager<ActionEnum>::ToggleMouseCapture()
 	{
@@ -225,11 +251,17 @@ namespace Core
 
 		InputManager* manager = GetManager(window);
 
+		if (manager == nullptr || manager->actions[glfwInput] == ActionEnum::NO_ACTION)
+		{
+			return;
+		}
+
 		ActionEnum action = manager->actions[glfwInput];
 
 		EActionState state = glfwAction == GLFW::GetGLFWPress() ? EActionState::PRESSED : EActionState::RELEASED;
 
-		manager->pendingChange.emplace(action, state);
+		// stamped here rather than when processed, the gameplay knows when it happened within the frame
+		manager->pendingChange.Push({action, state, InputClock::now()});
 	}
 
 	template<typename ActionEnum>
@@ -272,13 +304,26 @@ namespace Core
 	}
 
 	template<typename ActionEnum>
-	void InputManager<ActionEnum>::UpdateNewState()
+	void InputManager<ActionEnum>::UpdateNewState(const InputClock::time_point until)
 	{
-		while (!pendingChange.empty())
+		bool hasChanged[static_cast<int>(ActionEnum::NO_ACTION)]{};
+		lastChanges.clear();
+
+		while (const InputEvent<ActionEnum>* event = pendingChange.Front())
 		{
-			std::pair<ActionEnum, EActionState> pair = pendingChange.front();
-			currentState[static_cast<int>(pair.first)] = pair.second;
-			pendingChange.pop();
+			const int action = static_cast<int>(event->action);
+
+			// later events wait for the next update, a press and a release in the same update would hide the press
+			if (event->time > until || hasChanged[action])
+			{
+				break;
+			}
+
+			currentState[action] = event->state;
+			stateTime[action] = event->time;
+			hasChanged[action] = true;
+			lastChanges.push_back(*event);
+			pendingChange.Pop();
 		}
 	}
 
@@ -0,0 +1,125 @@
+#include "InputRecording.h"
+
+#include <cstring>
+#include <fstream>
+
+#include "core/CLog.h"
+
+namespace Core
+{
+	namespace
+	{
+		constexpr char MAGIC[4] = {'C', 'E', 'I', 'R'};
+		constexpr unsigned int VERSION = 1;
+
+		struct Header
+		{
+			char magic[4];
+			unsigned int version;
+			float fixedStep;
+			unsigned int stepCount;
+			unsigned int size; // of the steps
+		};
+	}
+
+	void InputRecording::Clear(const float step)
+	{
+		steps.clear();
+		stepCount = 0;
+		fixedStep = step;
+		readPos = 0;
+	}
+
+	void InputRecording::AddStep(const std::vector<Action>& actions)
+	{
+		// one change per action and per step, so the count fits in a byte
+		steps.push_back(static_cast<unsigned char>(actions.size()));
+		for (const Action& action : actions)
+		{
+			steps.push_back(action.action);
+			steps.push_back(action.state);
+		}
+		stepCount++;
+	}
+
+	void InputRecording::Rewind()
+	{
+		readPos = 0;
+	}
+
+	bool InputRecording::ReadStep(std::vector<Action>& actions)
+	{
+		actions.clear();
+		if (readPos >= steps.size())
+		{
+			return false;
+		}
+
+		const size_t count = steps[readPos++];
+		if (readPos + count * 2 > steps.size())
+		{
+			readPos = steps.size();
+			return false;
+		}
+
+		for (size_t i = 0; i < count; i++, readPos += 2)
+		{
+			actions.push_back({steps[readPos], steps[readPos + 1]});
+		}
+		return true;
+	}
+
+	bool InputRecording::Save(const char* fileName) const
+	{
+		std::ofstream file(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+		if (file.is_open() == false)
+		{
+			LOGF(LOG_WARNING, ELogChannel::CLOG_GENERAL, "Could not write the input recording %s", fileName);
+			return false;
+		}
+
+		Header header{};
+		memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.fixedStep = fixedStep;
+		header.stepCount = stepCount;
+		header.size = static_cast<unsigned int>(steps.size());
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(steps.data()), static_cast<std::streamsize>(steps.size()));
+		file.close();
+		return file.good();
+	}
+
+	bool InputRecording::Load(const char* fileName)
+	{
+		std::ifstream file(fileName, std::ios::in | std::ios::binary);
+		if (file.is_open() == false)
+		{
+			LOGF(LOG_WARNING, ELogChannel::CLOG_GENERAL, "Could not open the input recording %s", fileName);
+			return false;
+		}
+
+		Header header{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (file.good() == false || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+			|| header.fixedStep <= 0.f)
+		{
+			LOGF(LOG_WARNING, ELogChannel::CLOG_GENERAL, "%s is not an input recording", fileName);
+			return false;
+		}
+
+		Clear(header.fixedStep);
+		steps.resize(header.size);
+		file.read(reinterpret_cast<char*>(steps.data()), static_cast<std::streamsize>(steps.size()));
+		if (file.gcount() != static_cast<std::streamsize>(steps.size()))
+		{
+			LOGF(LOG_WARNING, ELogChannel::CLOG_GENERAL, "Input recording %s is truncated", fileName);
+			Clear(header.fixedStep);
+			return false;
+		}
+
+		stepCount = header.stepCount;
+		return true;
+	}
+}
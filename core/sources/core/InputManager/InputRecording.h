@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Core
+{
+	// The actions of a play session, one record per simulation step : the changes applied before the step.
+	// The steps are fixed, so replaying them from the same level gives the same session.
+	class InputRecording
+	{
+	public:
+		struct Action
+		{
+			unsigned char action;
+			unsigned char state; // EActionState
+		};
+
+		void Clear(float step); // starts a new recording at this simulation step
+		void AddStep(const std::vector<Action>& actions);
+
+		void Rewind();
+		bool ReadStep(std::vector<Action>& actions); // false past the last step
+
+		bool Save(const char* fileName) const;
+		bool Load(const char* fileName);
+
+		[[nodiscard]] float GetFixedStep() const { return fixedStep; }
+		[[nodiscard]] unsigned int GetStepCount() const { return stepCount; }
+
+	private:
+		// per step : the action count then the actions, most steps are a single 0 byte
+		std::vector<unsigned char> steps;
+		unsigned int stepCount = 0;
+		float fixedStep = 0.f;
+		size_t readPos = 0;
+	};
+}
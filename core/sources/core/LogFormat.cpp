@@ -0,0 +1,213 @@
+#include "LogFormat.h"
+
+#include <cstdio>
+
+namespace Core::LogFormat
+{
+	namespace
+	{
+		template <typename T>
+		bool ReadValue(T& value, const char*& ptr, const char* endPtr)
+		{
+			if ((size_t)(endPtr - ptr) < sizeof(T))
+			{
+				return false;
+			}
+
+			memcpy(&value, ptr, sizeof(T));
+			ptr += sizeof(T);
+			return true;
+		}
+
+		template <typename T>
+		void AppendFormatted(std::string& out, const std::string& spec, T value)
+		{
+			char buffer[128];
+			const int length = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+			if (length < 0)
+			{
+				return;
+			}
+
+			if ((size_t)length < sizeof(buffer))
+			{
+				out.append(buffer, length);
+				return;
+			}
+
+			const size_t offset = out.size();
+			out.resize(offset + length + 1);
+			snprintf(&out[offset], (size_t)length + 1, spec.c_str(), value);
+			out.resize(offset + length);
+		}
+
+		bool IsFloatConversion(char conversion)
+		{
+			return conversion && strchr("fFeEgGaA", conversion) != nullptr;
+		}
+
+		bool IsIntegerConversion(char conversion)
+		{
+			return conversion && strchr("diouxX", conversion) != nullptr;
+		}
+
+		void AppendInteger(std::string& out, std::string spec, char conversion, unsigned long long bits, bool isSigned)
+		{
+			if (conversion == 'c')
+			{
+				AppendFormatted(out, spec.append(1, 'c'), (int)bits);
+			}
+			else if (IsFloatConversion(conversion))
+			{
+				AppendFormatted(out, spec.append(1, conversion), isSigned ? (double)(long long)bits : (double)bits);
+			}
+			else if (conversion == 'd' || conversion == 'i' || (IsIntegerConversion(conversion) == false && isSigned))
+			{
+				AppendFormatted(out, spec.append("lld"), (long long)bits);
+			}
+			else
+			{
+				AppendFormatted(out, spec.append("ll").append(1, IsIntegerConversion(conversion) ? conversion : 'u'), bits);
+			}
+		}
+	}
+
+	void Arguments::AddString(const char* str, size_t length)
+	{
+		if (size + 1 + sizeof(unsigned short) > ARGUMENTS_CAPACITY)
+		{
+			size = ARGUMENTS_CAPACITY;
+			return;
+		}
+
+		const size_t available = ARGUMENTS_CAPACITY - size - 1 - sizeof(unsigned short);
+		const unsigned short stored = (unsigned short)(length < available ? length : available);
+
+		data[size] = (char)EArgument::STRING;
+		memcpy(data + size + 1, &stored, sizeof(stored));
+		memcpy(data + size + 1 + sizeof(stored), str, stored);
+		size += (unsigned short)(1 + sizeof(stored) + stored);
+	}
+
+	std::string Render(const char* format, const char* arguments, size_t size)
+	{
+		std::string out;
+		const char* ptr = arguments;
+		const char* endPtr = arguments + size;
+
+		while (*format != '\0')
+		{
+			if (*format != '%')
+			{
+				const char* next = strchr(format, '%');
+				const size_t length = next ? (size_t)(next - format) : strlen(format);
+				out.append(format, length);
+				format += length;
+				continue;
+			}
+
+			if (format[1] == '%')
+			{
+				out.push_back('%');
+				format += 2;
+				continue;
+			}
+
+			// %[flags][width][.precision][length]conversion, the length is replaced by the captured type
+			const char* specBegin = format++;
+			while (*format != '\0' && strchr("-+ #0", *format))
+			{
+				format++;
+			}
+			while (*format >= '0' && *format <= '9')
+			{
+				format++;
+			}
+			if (*format == '.')
+			{
+				format++;
+				while (*format >= '0' && *format <= '9')
+				{
+					format++;
+				}
+			}
+			const std::string spec(specBegin, format);
+			while (*format != '\0' && strchr("hljztL", *format))
+			{
+				format++;
+			}
+
+			const char conversion = *format;
+			if (conversion == '\0')
+			{
+				out.append(spec);
+				break;
+			}
+			format++;
+
+			unsigned char type;
+			if (ReadValue(type, ptr, endPtr) == false)
+			{
+				out.push_back('?');
+				continue;
+			}
+
+			switch ((EArgument)type)
+			{
+			case EArgument::INT:
+			case EArgument::UNSIGNED:
+			case EArgument::POINTER:
+				{
+					unsigned long long bits;
+					if (ReadValue(bits, ptr, endPtr) == false)
+					{
+						out.push_back('?');
+					}
+					else if ((EArgument)type == EArgument::POINTER && conversion == 'p')
+					{
+						AppendFormatted(out, spec + 'p', (void*)(size_t)bits);
+					}
+					else
+					{
+						AppendInteger(out, spec, conversion, bits, (EArgument)type == EArgument::INT);
+					}
+					break;
+				}
+			case EArgument::FLOAT:
+				{
+					double value;
+					if (ReadValue(value, ptr, endPtr) == false)
+					{
+						out.push_back('?');
+					}
+					else
+					{
+						AppendFormatted(out, spec + (IsFloatConversion(conversion) ? conversion : 'g'), value);
+					}
+					break;
+				}
+			case EArgument::STRING:
+				{
+					unsigned short length;
+					if (ReadValue(length, ptr, endPtr) == false || (size_t)(endPtr - ptr) < length)
+					{
+						out.push_back('?');
+						ptr = endPtr;
+						break;
+					}
+
+					const std::string str(ptr, length);
+					ptr += length;
+					AppendFormatted(out, spec + 's', str.c_str());
+					break;
+				}
+			default:
+				out.push_back('?');
+				ptr = endPtr; // unknown type : the remaining arguments cannot be located
+				break;
+			}
+		}
+
+		return out;
+	}
+}
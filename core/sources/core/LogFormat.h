@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace Core
+{
+	// Binary log layout (native endianness) :
+	//   FileHeader
+	//   records { ERecord, payload }
+	// A call site is described once by a SITE record, the MESSAGE records refer to it by id.
+	// Shared by CLog and the logdecoder tool, so it must not depend on the rest of the engine.
+	namespace LogFormat
+	{
+		constexpr char MAGIC[4] = {'C', 'E', 'L', 'G'};
+		constexpr unsigned int VERSION = 1;
+		constexpr const char* FILE_EXTENSION = ".clog";
+
+		// indexed by ELogLevel and ELogChannel
+		constexpr const char* LEVEL_NAMES[] = {"Debug", "Info", "Warning", "Error"};
+		constexpr const char* CHANNEL_NAMES[] = {
+			"General", "Editor", "Render", "Network", "Physics", "Vulkan General", "Vulkan Validation",
+			"Vulkan Performance", "ECS", "Script", "Sound", "Reflection", "Model"
+		};
+		constexpr unsigned int LEVEL_COUNT = sizeof(LEVEL_NAMES) / sizeof(LEVEL_NAMES[0]);
+		constexpr unsigned int CHANNEL_COUNT = sizeof(CHANNEL_NAMES) / sizeof(CHANNEL_NAMES[0]);
+
+		struct FileHeader
+		{
+			char magic[4];
+			unsigned int version;
+			long long tickNumerator; // a timestamp tick lasts tickNumerator / tickDenominator seconds
+			long long tickDenominator; // since the system clock epoch
+		};
+
+		enum class ERecord : unsigned char
+		{
+			SITE = 1, // unsigned int id, int line, unsigned short fileLength, file, unsigned short formatLength, format
+			MESSAGE = 2, // unsigned int site, unsigned char level, unsigned char channel, long long ticks, unsigned short size, arguments[size]
+		};
+
+		enum class EArgument : unsigned char
+		{
+			INT, // long long
+			UNSIGNED, // unsigned long long
+			FLOAT, // double
+			STRING, // unsigned short length, chars (not null terminated)
+			POINTER, // unsigned long long
+		};
+
+		constexpr size_t ARGUMENTS_CAPACITY = 128;
+
+		// printf arguments captured as { EArgument, value } without formatting them
+		struct Arguments
+		{
+			template <typename ... Args>
+			void Add(const Args& ... args) { (AddOne(args), ...); }
+
+			unsigned short size = 0;
+			char data[ARGUMENTS_CAPACITY];
+
+		private:
+			template <typename T>
+			void AddOne(const T& value);
+
+			template <typename T>
+			void AddValue(EArgument type, T value);
+
+			void AddString(const char* str, size_t length);
+		};
+
+		// printf style rendering of captured arguments, "?" stands for a missing or truncated argument
+		std::string Render(const char* format, const char* arguments, size_t size);
+
+		template <typename T>
+		void Arguments::AddOne(const T& value)
+		{
+			using Decayed = std::decay_t<T>;
+
+			if constexpr (std::is_same_v<Decayed, std::string>)
+			{
+				AddString(value.data(), value.size());
+			}
+			else if constexpr (std::is_same_v<Decayed, const char*> || std::is_same_v<Decayed, char*>)
+			{
+				const char* str = value; // arrays decay here
+				AddString(str, str ? strlen(str) : 0);
+			}
+			else if constexpr (std::is_floating_point_v<Decayed>)
+			{
+				AddValue(EArgument::FLOAT, (double)value);
+			}
+			else if constexpr (std::is_enum_v<Decayed> || (std::is_integral_v<Decayed> && std::is_signed_v<Decayed>))
+			{
+				AddValue(EArgument::INT, (long long)value);
+			}
+			else if constexpr (std::is_integral_v<Decayed>)
+			{
+				AddValue(EArgument::UNSIGNED, (unsigned long long)value);
+			}
+			else if constexpr (std::is_pointer_v<Decayed>)
+			{
+				AddValue(EArgument::POINTER, (unsigned long long)(size_t)value);
+			}
+			else
+			{
+				static_assert(std::is_pointer_v<Decayed>, "unsupported log argument type");
+			}
+		}
+
+		template <typename T>
+		void Arguments::AddValue(EArgument type, T value)
+		{
+			if (size + 1 + sizeof(T) > ARGUMENTS_CAPACITY)
+			{
+				size = ARGUMENTS_CAPACITY; // stop there, the next arguments would be read out of order
+				return;
+			}
+
+			data[size] = (char)type;
+			memcpy(data + size + 1, &value, sizeof(T));
+			size += (unsigned short)(1 + sizeof(T));
+		}
+	}
+}
@@ -1,10 +1,19 @@
 #include "ThreadPool.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "CLog.h"
+#include "DebugWindow/Profiler.h"
 
 namespace Core
 {
-	ThreadPool ThreadPool::defaultThreadPool(EPoolSize::HARDWARE_MINUS_ONE);
+	ThreadPool& ThreadPool::GetDefaultThreadPool()
+	{
+		static ThreadPool defaultThreadPool(EPoolSize::HARDWARE_MINUS_ONE);
+
+		return defaultThreadPool;
+	}
 
 	ThreadPool::ThreadPool(const EPoolSize poolSize)
 	{
@@ -17,6 +26,9 @@ namespace Core
 		case EPoolSize::HARDWARE_MINUS_ONE:
 			size = static_cast<int>(std::thread::hardware_concurrency()) - 1;
 			break;
+		default:
+			size = static_cast<int>(poolSize); // explicit thread count
+			break;
 		}
 
 		size = std::max(size, 1);
@@ -25,7 +37,7 @@ namespace Core
 
 		for (int threadIndex = 0; threadIndex < size; threadIndex++)
 		{
-			threads.emplace_back(&ThreadPool::Work, this);
+			threads.emplace_back(&ThreadPool::Work, this, threadIndex);
 		}
 
 		LOG(LOG_INFO, "A new thread pool was created.");
@@ -47,8 +59,71 @@ namespace Core
 		threads.clear();
 	}
 
-	void ThreadPool::Work()
+	void ThreadPool::AddJob(Task job, const bool isUrgent)
 	{
+		{
+			std::lock_guard<std::mutex> lock{poolMutex};
+			if (isUrgent)
+			{
+				pendingTasks.push_front(std::move(job));
+			}
+			else
+			{
+				pendingTasks.push_back(std::move(job));
+			}
+		}
+
+		poolCondVar.notify_one();
+	}
+
+	void ThreadPool::ParallelFor(const size_t count, const size_t batchSize,
+	                             const std::function<void(size_t, size_t)>& body)
+	{
+		const size_t batchCount = (count + batchSize - 1) / batchSize;
+		if (batchCount <= 1)
+		{
+			if (count > 0)
+			{
+				body(0, count);
+			}
+			return;
+		}
+
+		struct Batches
+		{
+			std::atomic<size_t> next{0};
+			std::atomic<size_t> doneCount{0};
+		};
+
+		// shared : a job started after the caller returned finds no batch left, it must not touch the stack
+		const auto batches = std::make_shared<Batches>();
+		const auto runBatches = [batches, batchCount, batchSize, count, &body]
+		{
+			for (size_t batch = batches->next.fetch_add(1); batch < batchCount; batch = batches->next.fetch_add(1))
+			{
+				body(batch * batchSize, std::min(count, (batch + 1) * batchSize));
+				batches->doneCount.fetch_add(1, std::memory_order_release);
+			}
+		};
+
+		const size_t helperCount = std::min(batchCount - 1, threads.size());
+		for (size_t i = 0; i < helperCount; i++)
+		{
+			AddJob(runBatches, true);
+		}
+
+		runBatches();
+
+		while (batches->doneCount.load(std::memory_order_acquire) < batchCount)
+		{
+			std::this_thread::yield(); // the last batches taken by the workers
+		}
+	}
+
+	void ThreadPool::Work(const int threadIndex)
+	{
+		PROFILE_THREAD("Worker " + std::to_string(threadIndex));
+
 		std::unique_lock<std::mutex> lock{ poolMutex, std::defer_lock };
 
         while (true)
@@ -65,10 +140,11 @@ namespace Core
 			}
 
 			Task task = std::move(pendingTasks.front());
-			pendingTasks.pop();
+			pendingTasks.pop_front();
 
 			lock.unlock();
 
+			PROFILE_ZONE("Task");
 			task();
 		}
 	}
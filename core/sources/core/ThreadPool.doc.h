@@ -1,6 +1,7 @@
 #pragma once
+#include <condition_variable>
 #include <thread>
-#include <queue>
+#include <deque>
 #include <functional>
 #include <mutex>
 
@@ -53,6 +54,25 @@ namespace Core
 		template<class Callable, class ...Args>
 		auto	AddTask(Callable&& function, Args&& ...args);
 
+        /**
+		 * Add a job to the pending tasks, without the future and the shared state of AddTask.
+		 * For the many short tasks of a frame whose caller tracks the completion itself, like the PhysX tasks.
+		 * 
+		 * @param job - Function to be executed by a thread
+		 * @param isUrgent - If true, the job runs before the already pending tasks. The frame waits for urgent jobs, asset loads do not.
+		 */
+		void	AddJob(Task job, bool isUrgent = false);
+
+		/**
+		 * Calls body on consecutive ranges covering [0, count), spread over the caller and the pool threads.
+		 * The caller runs batches too and returns once every batch ran, so it is never stuck behind long tasks.
+		 * A single batch runs on the caller without touching the pool.
+		 * @param count - Number of elements
+		 * @param batchSize - Number of elements given to body at once
+		 * @param body - Called with the begin and end indices of a range, from several threads at the same time
+		 */
+		void	ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& body);
+
 	private:
         /**
 		 * Function executed by each thread until the thread is killed.
@@ -83,8 +103,9 @@ namespace Core
 
         /**
 		 * Pending tasks queue. Whenever a thread execute a new task, it is removed from the queue.
+		 * Urgent jobs are added at the front.
 		 */
-		std::queue<Task>			pendingTasks;
+		std::deque<Task>			pendingTasks;
 	};
 }
 
@@ -1,6 +1,7 @@
 #pragma once
+#include <condition_variable>
 #include <thread>
-#include <queue>
+#include <deque>
 #include <functional>
 #include <mutex>
 
@@ -32,17 +33,26 @@ namespace Core
 		template<class Callable, class ...Args>
 		auto	AddTask(Callable&& function, Args&& ...args);
 
-		static ThreadPool defaultThreadPool;
+		// no future, for the many short tasks whose caller tracks the completion itself.
+		// Urgent jobs run before the pending tasks : the frame waits for them, asset loads do not.
+		void	AddJob(Task job, bool isUrgent = false);
+
+		// body(begin, end) over [0, count) in batches of batchSize, run by the caller and urgent jobs, returns once all ran.
+		// The caller keeps taking batches, so it never waits on workers busy with something else.
+		void	ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)>& body);
+
+		// created on first use : its workers log and register with the profiler as they start
+		static ThreadPool& GetDefaultThreadPool();
 
 	private:
-		void	Work();
+		void	Work(int threadIndex);
 
 		std::mutex				poolMutex;
 		std::condition_variable	poolCondVar;
 		bool					isStop = false;
 
 		std::vector<std::thread>	threads;
-		std::queue<Task>			pendingTasks;
+		std::deque<Task>			pendingTasks;
 	};
 }
 
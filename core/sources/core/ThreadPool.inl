@@ -12,7 +12,7 @@ namespace Core
 
 		{
 			std::lock_guard<std::mutex> lock{ poolMutex };
-			pendingTasks.emplace([wrapper] { (*wrapper)(); });
+			pendingTasks.emplace_back([wrapper] { (*wrapper)(); });
 		}
 
 		poolCondVar.notify_one();
@@ -1,48 +1,138 @@
 #include "TimerManager.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace Core
 {
-    Timer::Timer(std::function<void()> otherFunction, const float otherInterval, const int otherLoop) :
-        loop(otherLoop), interval(otherInterval), timeRemaining(otherInterval), function(std::move(otherFunction))
-    {}
-
-    bool Timer::Tick(const float delta)
+    TimerHandle TimerManager::_internal_CreateTimer(std::function<void()> function, const float interval, const int loop)
     {
-        timeRemaining -= delta;
+        int slot;
+        if (freeSlots.empty())
+        {
+            slot = (int)timers.size();
+            timers.emplace_back();
+        }
+        else
+        {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        Timer& timer = timers[slot];
+        timer.function = std::move(function);
+        timer.loop = loop;
+        timer.interval = interval;
+        timer.isActive = true;
 
-        while (timeRemaining <= 0)
+        Schedule({currentTime + interval, slot, timer.generation});
+        return {slot, timer.generation};
+    }
+
+    bool TimerManager::CancelTimer(const TimerHandle handle)
+    {
+        if (IsActive(handle) == false)
         {
-            function();
-            timeRemaining += interval;
-            loop--;
+            return false;
+        }
 
-            if (loop == 0)
+        Release(handle.GetValue());
+        return true;
+    }
+
+    bool TimerManager::IsActive(const TimerHandle handle) const
+    {
+        return handle.IsValid() && (size_t)handle.GetValue() < timers.size()
+            && timers[handle.GetValue()].isActive && timers[handle.GetValue()].generation == handle.GetGeneration();
+    }
+
+    void TimerManager::CancelAll()
+    {
+        for (int slot = 0; slot < (int)timers.size(); slot++)
+        {
+            if (timers[slot].isActive)
             {
-                return true;
+                Release(slot);
             }
         }
+        heap.clear();
+        pending.clear();
+    }
 
-        return false;
+    void TimerManager::Schedule(const ScheduledTimer& scheduled)
+    {
+        if (isTicking)
+        {
+            pending.push_back(scheduled);
+            return;
+        }
+
+        heap.push_back(scheduled);
+        std::push_heap(heap.begin(), heap.end());
     }
 
-    void TimerManager::_internal_CreateTimer(const std::function<void()>& function, const float interval, const int loop)
+    void TimerManager::Release(const int slot)
     {
-        timers.emplace_back(function, interval, loop);
+        Timer& timer = timers[slot];
+        timer.function = nullptr; // free the captures now, not when the slot is reused
+        timer.isActive = false;
+        timer.generation++;
+        freeSlots.push_back(slot);
     }
 
     void TimerManager::Tick(const float delta)
     {
-        for (auto it = timers.begin(); it != timers.end();)
+        currentTime += delta;
+        isTicking = true;
+
+        while (heap.empty() == false && heap.front().dueTime <= currentTime)
         {
-            if (it->Tick(delta))
+            const ScheduledTimer scheduled = heap.front();
+            std::pop_heap(heap.begin(), heap.end());
+            heap.pop_back();
+
+            if (timers[scheduled.slot].generation != scheduled.generation)
+            {
+                continue; // cancelled
+            }
+
+            // moved out while it runs : the callback may cancel its own timer or create timers that grow the vector
+            std::function<void()> function = std::move(timers[scheduled.slot].function);
+            function();
+
+            Timer& timer = timers[scheduled.slot];
+            if (timer.generation != scheduled.generation)
+            {
+                continue; // cancelled by its own callback
+            }
+            timer.function = std::move(function);
+
+            timer.loop--;
+            if (timer.loop == 0)
             {
-                it = timers.erase(it);
+                Release(scheduled.slot);
+                continue;
+            }
+
+            // late timers catch up within this Tick like before, unless they would never leave the loop
+            const ScheduledTimer next{scheduled.dueTime + timer.interval, scheduled.slot, scheduled.generation};
+            if (timer.interval > 0.f)
+            {
+                heap.push_back(next);
+                std::push_heap(heap.begin(), heap.end());
             }
             else
-                ++it;
+            {
+                pending.push_back(next);
+            }
         }
+
+        isTicking = false;
+        for (const ScheduledTimer& scheduled : pending)
+        {
+            Schedule(scheduled);
+        }
+        pending.clear();
     }
 
     TimerManager& TimerManager::GetTimerManager()
@@ -51,5 +141,3 @@ namespace Core
         return timerManager;
     }
 }
-
-
@@ -5,19 +5,39 @@
 
 namespace Core
 {
-    struct Timer
+    class TimerHandle
     {
-        Timer(std::function<void()> otherFunction, float otherInterval, int otherLoop);
+    public:
+        TimerHandle() = default;
+        TimerHandle(int value, unsigned int generation) : value(value), generation(generation) {}
+
+        bool operator==(const TimerHandle& rhs) const { return value == rhs.value && generation == rhs.generation; }
+        bool operator!=(const TimerHandle& rhs) const { return !(*this == rhs); }
+
+        bool IsValid() const { return value > -1; } // the timer may have finished since, see TimerManager::IsActive
+        bool IsNotValid() const { return value < 0; }
+        int GetValue() const { return value; }
+        unsigned int GetGeneration() const { return generation; }
 
-        bool    Tick(float delta);
+        static const int INVALID_VALUE = -1;
 
-        int     loop;
-        float   interval;
-        float   timeRemaining;
+    private:
+        int value = TimerHandle::INVALID_VALUE;
+        unsigned int generation = 0;
+    };
 
+    struct Timer
+    {
         std::function<void()>   function;
+
+        int     loop = 0; // remaining calls, <= 0 is infinite
+        float   interval = 0.f;
+        unsigned int generation = 0; // incremented each time the slot is released, invalidates the handles
+        bool    isActive = false;
     };
 
+    // Timers are kept in a min-heap sorted by due time, so a Tick only touches the timers that fire.
+    // Creating a timer is O(log n), cancelling it is O(1) : the slot is released and its heap entry is dropped when it surfaces.
     class TimerManager
     {
     public:
@@ -28,26 +48,53 @@ namespace Core
         TimerManager& operator=(const TimerManager&) = delete;
         TimerManager& operator=(TimerManager&&) = delete;
 
-        CORE_EXPORT void    _internal_CreateTimer(const std::function<void()>& function, float interval, int loop = -1);
+        CORE_EXPORT TimerHandle _internal_CreateTimer(std::function<void()> function, float interval, int loop = -1);
+
+        // returns false if the timer already finished or was cancelled
+        CORE_EXPORT bool    CancelTimer(TimerHandle handle);
+        CORE_EXPORT bool    IsActive(TimerHandle handle) const;
+        CORE_EXPORT void    CancelAll();
 
         CORE_EXPORT void    Tick(float delta);
 
+        [[nodiscard]] size_t    GetActiveCount() const { return timers.size() - freeSlots.size(); }
+
         CORE_EXPORT static TimerManager&    GetTimerManager();
 
     private:
+        struct ScheduledTimer
+        {
+            double          dueTime;
+            int             slot;
+            unsigned int    generation; // stale when it differs from the slot generation
+
+            // std heaps are max-heaps
+            bool operator<(const ScheduledTimer& rhs) const { return dueTime > rhs.dueTime; }
+        };
+
         TimerManager() = default;
 
-        std::vector<Timer>  timers;
+        void    Schedule(const ScheduledTimer& scheduled);
+        void    Release(int slot);
+
+        std::vector<Timer>  timers; // slots, indexed by the handles
+        std::vector<int>    freeSlots;
+
+        std::vector<ScheduledTimer> heap;
+        std::vector<ScheduledTimer> pending; // scheduled during Tick, pushed once it is over so they cannot fire in the same Tick
+
+        double  currentTime = 0.0; // seconds, double so long sessions do not drift
+        bool    isTicking = false;
     };
 }
 
 #define ID_TM(x) x
 #define GET_MACRO_TM(_1, _2, _3, _4, NAME, ...) NAME
 /*
- * CreateTimer(Function, Object, IntervalSeconds, LoopCount(optional))
+ * CreateTimer(Function, Object, IntervalSeconds, LoopCount(optional)), returns a TimerHandle for CancelTimer
  * LoopCount <= 0 means infinite number of loops
  */
 #define CreateTimer(...) ID_TM(GET_MACRO_TM(__VA_ARGS__, CreateTimer3, CreateTimer2)(__VA_ARGS__))
 
 #define CreateTimer3(FUNCTION, OBJECT, INTERVAL, LOOP) _internal_CreateTimer(std::bind(FUNCTION, OBJECT), INTERVAL, LOOP)
-#define CreateTimer2(FUNCTION, OBJECT, INTERVAL) _internal_CreateTimer(std::bind(FUNCTION, OBJECT), INTERVAL)
\ No newline at end of file
+#define CreateTimer2(FUNCTION, OBJECT, INTERVAL) _internal_CreateTimer(std::bind(FUNCTION, OBJECT), INTERVAL)
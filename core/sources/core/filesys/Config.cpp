@@ -4,20 +4,135 @@
 #include "ErrorManager.h"
 #include "core/reflection/StructMeta.h"
 
+#include <algorithm>
 #include <string>
 #include <cstdlib>
+#include <filesystem>
+#include <mutex>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONFIG_USE_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
 
 #define CPP_MAX_NAME_LENGHT 255ul// todo: move to appropriate location
 #define ERROR_BUFFER_SIZE 256ul// todo: move to appropriate location
 #define INVALID_CHAR '\200' // first value beyond ascii table // todo: move to appropriate location
-#define not !
 #define is ==
 #define isnot !=
+#ifdef _MSC_VER // alternative tokens elsewhere
+#define not !
 #define and &&
 #define or ||
+#endif
 
 namespace Core
 {
+    namespace
+    {
+        bool IsSpace(char c)
+        {
+            return c is ' ' or (c >= '\t' and c <= '\r'); // ' ', '\t', '\n', '\v', '\f', '\r'
+        }
+
+#ifdef CONFIG_USE_SSE2
+        constexpr ptrdiff_t SIMD_WIDTH = 16;
+
+        int FirstSetBit(int mask)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, (unsigned long)mask);
+            return (int)index;
+#else
+            return __builtin_ctz((unsigned int)mask);
+#endif
+        }
+
+        int SpaceMask(__m128i chunk)
+        {
+            const __m128i isBlank = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '));
+            const __m128i isControl = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('\t' - 1)),
+                                                    _mm_cmplt_epi8(chunk, _mm_set1_epi8('\r' + 1)));
+            return _mm_movemask_epi8(_mm_or_si128(isBlank, isControl));
+        }
+#endif
+
+        // first character of [ptr, endPtr) that is not a white space, endPtr if none
+        const char* FindNonSpace(const char* ptr, const char* endPtr)
+        {
+#ifdef CONFIG_USE_SSE2
+            while (endPtr - ptr >= SIMD_WIDTH)
+            {
+                int mask = ~SpaceMask(_mm_loadu_si128((const __m128i*)ptr)) & 0xFFFF;
+                if (mask != 0)
+                {
+                    return ptr + FirstSetBit(mask);
+                }
+                ptr += SIMD_WIDTH;
+            }
+#endif
+            while (ptr < endPtr and IsSpace(*ptr))
+            {
+                ptr++;
+            }
+            return ptr;
+        }
+
+        // first occurrence of a or b in [ptr, endPtr), endPtr if none
+        const char* FindEither(const char* ptr, const char* endPtr, char a, char b)
+        {
+#ifdef CONFIG_USE_SSE2
+            const __m128i first = _mm_set1_epi8(a);
+            const __m128i second = _mm_set1_epi8(b);
+            while (endPtr - ptr >= SIMD_WIDTH)
+            {
+                __m128i chunk = _mm_loadu_si128((const __m128i*)ptr);
+                int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, first), _mm_cmpeq_epi8(chunk, second)));
+                if (mask != 0)
+                {
+                    return ptr + FirstSetBit(mask);
+                }
+                ptr += SIMD_WIDTH;
+            }
+#endif
+            while (ptr < endPtr and *ptr isnot a and *ptr isnot b)
+            {
+                ptr++;
+            }
+            return ptr;
+        }
+
+        unsigned int CountLines(const char* ptr, const char* endPtr)
+        {
+            unsigned int count = 0;
+#ifdef CONFIG_USE_SSE2
+            const __m128i lineFeed = _mm_set1_epi8('\n');
+            while (endPtr - ptr >= SIMD_WIDTH)
+            {
+                int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)ptr), lineFeed));
+                while (mask != 0)
+                {
+                    mask &= mask - 1;
+                    count++;
+                }
+                ptr += SIMD_WIDTH;
+            }
+#endif
+            while (ptr < endPtr)
+            {
+                if (*ptr++ is '\n')
+                {
+                    count++;
+                }
+            }
+            return count;
+        }
+    }
+
     void Config::Parse(const char* filePath, void* out, const Structure* metaData)
     {
         ParseMemory memory(filePath);
@@ -51,6 +166,88 @@ namespace Core
     }
 
 
+    void Config::Watch(const char* filePath, void* out, const Structure* metaData, std::function<void()> onReload)
+    {
+        Parse(filePath, out, metaData);
+
+        long long writeTime = GetLastWriteTime(filePath);
+        watchedFiles.push_back({filePath, out, metaData, std::move(onReload), writeTime, writeTime});
+    }
+
+
+    void Config::Unwatch(const void* out)
+    {
+        watchedFiles.erase(std::remove_if(watchedFiles.begin(), watchedFiles.end(),
+            [out](const WatchedFile& watched) { return watched.out is out; }), watchedFiles.end());
+    }
+
+
+    void Config::UpdateWatchedFiles(float deltaTime)
+    {
+        watchTimer += deltaTime;
+        if (watchTimer < WATCH_INTERVAL or watchedFiles.empty())
+        {
+            return;
+        }
+        watchTimer = 0.f;
+
+        for (WatchedFile& watched : watchedFiles)
+        {
+            long long writeTime = GetLastWriteTime(watched.filePath.c_str());
+
+            if (writeTime is watched.lastWriteTime)
+            {
+                continue;
+            }
+
+            if (writeTime isnot watched.pendingWriteTime) // still being written, check again next interval
+            {
+                watched.pendingWriteTime = writeTime;
+                continue;
+            }
+
+            watched.lastWriteTime = writeTime;
+            Parse(watched.filePath.c_str(), watched.out, watched.metaData);
+
+            LOG(LOG_INFO, CLog::FormatString("config reloaded : %s", watched.filePath.c_str()));
+
+            if (watched.onReload)
+            {
+                watched.onReload();
+            }
+        }
+    }
+
+
+    long long Config::GetLastWriteTime(const char* filePath)
+    {
+        std::error_code error;
+        std::filesystem::file_time_type time = std::filesystem::last_write_time(filePath, error);
+
+        return error ? 0 : (long long)time.time_since_epoch().count();
+    }
+
+
+    const Config::FieldCache& Config::GetFieldCache(const Structure* metaData)
+    {
+        static std::mutex cacheMutex;
+        static std::unordered_map<const Structure*, FieldCache> caches;
+
+        std::lock_guard<std::mutex> lock(cacheMutex);
+
+        auto [it, inserted] = caches.try_emplace(metaData);
+        if (inserted)
+        {
+            for (StructureField field : metaData->GetAllFields())
+            {
+                it->second.emplace(field.name->hash, field); // first match wins, like Structure::FindField()
+            }
+        }
+
+        return it->second;
+    }
+
+
     void Config::LogError(ParseMemory* memory, EError error)
     {
         char buf[ERROR_BUFFER_SIZE];
@@ -201,9 +398,10 @@ namespace Core
     {
         CopyWordToMemory(memory);
 
-        StructureField field = metaData->FindField(memory->buffer);
+        const FieldCache& fields = GetFieldCache(metaData);
+        auto it = fields.find(CustomHash(memory->buffer));
 
-        if (field.IsValid() == false)
+        if (it is fields.end())
         {
             LogError(memory, EError::NAME_MISMATCH);
             return StructureField();
@@ -211,7 +409,7 @@ namespace Core
 
         SkipToNextSignificant(memory);
 
-        return field;
+        return it->second;
     }
 
 
@@ -597,47 +795,46 @@ namespace Core
 
     void Config::SkipToNextSignificant(ParseMemory* memory)
     {
-        while (memory->ptr < memory->endPtr)
+        while (true)
         {
-            switch (*memory->ptr)
+            memory->ptr = FindNonSpace(memory->ptr, memory->endPtr);
+
+            if (memory->endPtr - memory->ptr < 2
+                or *memory->ptr isnot '/')
             {
-            case '/':
-                if (*(memory->ptr + 1) is '/')
-                {
-                    memory->ptr += 2;
-                    SkipToNextLine(memory);
-                }
-                else if (*(memory->ptr + 1) is '*')
+                return;
+            }
+
+            if (*(memory->ptr + 1) is '/')
+            {
+                memory->ptr += 2;
+                SkipToNextLine(memory);
+            }
+            else if (*(memory->ptr + 1) is '*')
+            {
+                memory->ptr += 2;
+                SkipComment(memory);
+                if (memory->ptr < memory->endPtr)
                 {
-                    memory->ptr += 2;
-                    SkipComment(memory);
+                    memory->ptr++; // skip '/'
                 }
-                break;
-            case '\n':
-            case '\f':
-            case '\r':
-            case '\t':
-            case '\v':
-            case ' ':
-                break;
-            default:
+            }
+            else
+            {
                 return;
             }
-
-            memory->ptr++;
         }
     }
 
 
     void Config::SkipToNextLine(ParseMemory* memory)
     {
-        while (memory->ptr < memory->endPtr
-            and *memory->ptr isnot '\n')
+        memory->ptr = FindEither(memory->ptr, memory->endPtr, '\n', '\n');
+
+        if (memory->ptr < memory->endPtr)
         {
             memory->ptr++;
         }
-
-        memory->ptr++;
     }
 
 
@@ -645,38 +842,54 @@ namespace Core
     {
         while (memory->ptr < memory->endPtr)
         {
-            if (*memory->ptr is '*'
+            memory->ptr = FindEither(memory->ptr, memory->endPtr, '*', '*');
+
+            if (memory->endPtr - memory->ptr >= 2
                 and *(memory->ptr + 1) is '/')
             {
                 memory->ptr += 1;
                 return;
             }
 
-            memory->ptr++;
+            if (memory->ptr < memory->endPtr)
+            {
+                memory->ptr++;
+            }
         }
     }
 
 
     void Config::SkipToCommandEnd(ParseMemory* memory)
     {
-        while (memory->ptr < memory->endPtr
-            and *memory->ptr isnot ';')
+        while (memory->ptr < memory->endPtr)
         {
-            if (*memory->ptr is '/')
+            memory->ptr = FindEither(memory->ptr, memory->endPtr, ';', '/');
+
+            if (memory->ptr >= memory->endPtr
+                or *memory->ptr is ';')
             {
-                if (*(memory->ptr + 1) is '/')
-                {
-                    memory->ptr += 2;
-                    SkipToNextLine(memory);
-                }
-                else if (*(memory->ptr + 1) is '*')
-                {
-                    memory->ptr += 2;
-                    SkipComment(memory);
-                }
+                return;
             }
 
-            memory->ptr++;
+            if (memory->endPtr - memory->ptr >= 2
+                and *(memory->ptr + 1) is '/')
+            {
+                memory->ptr += 2;
+                SkipToNextLine(memory);
+                continue;
+            }
+
+            if (memory->endPtr - memory->ptr >= 2
+                and *(memory->ptr + 1) is '*')
+            {
+                memory->ptr += 2;
+                SkipComment(memory);
+            }
+
+            if (memory->ptr < memory->endPtr)
+            {
+                memory->ptr++;
+            }
         }
     }
 
@@ -684,18 +897,14 @@ namespace Core
     void Config::SkipToNextCommand(ParseMemory* memory)
     {
         SkipToCommandEnd(memory);
-        memory->ptr++; // skip ';'
-        SkipToNextSignificant(memory);
-
-        while (memory->cmdptr < memory->ptr)
+        if (memory->ptr < memory->endPtr)
         {
-            if (*memory->cmdptr is '\n')
-            {
-                memory->cmdLine++;
-            }
-
-            memory->cmdptr++;
+            memory->ptr++; // skip ';'
         }
+        SkipToNextSignificant(memory);
+
+        memory->cmdLine += CountLines(memory->cmdptr, memory->ptr);
+        memory->cmdptr = memory->ptr;
     }
 
 
@@ -715,14 +924,7 @@ namespace Core
 
         SkipToNextSignificant(this);
 
-        while (cmdptr < ptr)
-        {
-            if (*cmdptr is '\n')
-            {
-                cmdLine++;
-            }
-
-            cmdptr++;
-        }
+        cmdLine += CountLines(cmdptr, ptr);
+        cmdptr = ptr;
     }
 }
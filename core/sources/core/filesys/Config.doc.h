@@ -1,7 +1,13 @@
 #pragma once
 
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "../Constant.h"
 #include "MemoryMappedFile.h"
+#include "core/reflection/StructureField.h"
 
 namespace Core
 {
@@ -43,7 +49,78 @@ namespace Core
 		*/
 		static void Parse(const char* filePath, void* out, const class Structure* metaData);
 
+		/**
+		* Parse a config file into an object and keep the object up to date when the file
+		* is modified on disk.
+		*
+		* @param filePath	Path of the config source file.
+		* @param out		Reference to the object where the config will be store. This
+		* 					object need to have reflection data and to outlive the watch.
+		* @param onReload	Optional callback called after each reload.
+		*/
+		template<typename T>
+		static void Watch(const char* filePath, T& out, std::function<void()> onReload = nullptr) { Watch(filePath, &out, T::MetaData, std::move(onReload)); }
+		/**
+		* Parse a config file into an object and keep the object up to date when the file
+		* is modified on disk.
+		*
+		* @param filePath	Path of the config source file.
+		* @param out		Object where the config will be store.
+		* @param metaData	Reflection data of the object where the config will be store.
+		* @param onReload	Optional callback called after each reload.
+		*/
+		static void Watch(const char* filePath, void* out, const Structure* metaData, std::function<void()> onReload = nullptr);
+		/**
+		* Stop watching every config file parsed into the given object.
+		*
+		* @param out		Object given to Watch().
+		*/
+		static void Unwatch(const void* out);
+
+		/**
+		* Check the watched files every WATCH_INTERVAL seconds and re-parse the ones that
+		* changed. A change is applied once the file modification time stayed the same for
+		* a whole interval so a file still being saved is not read. Must be called at a
+		* point of the frame where no other thread reads the watched objects.
+		*
+		* @param deltaTime	Time elapsed since the last call, in seconds.
+		*/
+		static void UpdateWatchedFiles(float deltaTime);
+
 	private:
+		struct WatchedFile
+		{
+			std::string filePath;
+			void* out;
+			const Structure* metaData;
+			std::function<void()> onReload;
+			/** modification time of the file when it was last parsed */
+			long long lastWriteTime;
+			/** modification time seen at the last check, the change is applied when it is seen twice */
+			long long pendingWriteTime;
+		};
+
+		using FieldCache = std::unordered_map<long long, StructureField>;
+
+		/** seconds between two checks of the watched files */
+		static constexpr float WATCH_INTERVAL = 0.5f;
+
+		inline static std::vector<WatchedFile> watchedFiles;
+		inline static float watchTimer = 0.f;
+
+		/**
+		* @param filePath	Path of the file.
+		* @return			Last modification time of the file, 0 if it cannot be read.
+		*/
+		static long long GetLastWriteTime(const char* filePath);
+		/**
+		* Fields of a structure (bases included) indexed by the hash of their name. Built on
+		* first use and kept for the lifetime of the program.
+		*
+		* @param metaData	Reflection data of the structure.
+		* @return			Field lookup table of the structure.
+		*/
+		static const FieldCache& GetFieldCache(const Structure* metaData);
 
 		struct ParseMemory
 		{
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "../Constant.h"
 #include "MemoryMappedFile.h"
 #include "core/reflection/StructureField.h"
@@ -23,7 +28,33 @@ namespace Core
 		static void Parse(const char* filePath, T& out) { Parse(filePath, &out, T::MetaData); }
 		static void Parse(const char* filePath, void* out, const class Structure* metaData);
 
+		template<typename T>
+		static void Watch(const char* filePath, T& out, std::function<void()> onReload = nullptr) { Watch(filePath, &out, T::MetaData, std::move(onReload)); }
+		static void Watch(const char* filePath, void* out, const Structure* metaData, std::function<void()> onReload = nullptr);
+		static void Unwatch(const void* out);
+
+		static void UpdateWatchedFiles(float deltaTime); // re-parse the watched files that changed, call at a safe point of the frame
+
 	private:
+		struct WatchedFile
+		{
+			std::string filePath;
+			void* out;
+			const Structure* metaData;
+			std::function<void()> onReload;
+			long long lastWriteTime;
+			long long pendingWriteTime; // a change is applied once the file stopped changing for one interval
+		};
+
+		using FieldCache = std::unordered_map<long long, StructureField>;
+
+		static constexpr float WATCH_INTERVAL = 0.5f; // seconds between two checks of the watched files
+
+		inline static std::vector<WatchedFile> watchedFiles;
+		inline static float watchTimer = 0.f;
+
+		static long long GetLastWriteTime(const char* filePath);
+		static const FieldCache& GetFieldCache(const Structure* metaData); // field lookup by name hash, built once per structure
 
 		struct ParseMemory
 		{
@@ -46,8 +77,8 @@ namespace Core
 
 		static StructureField ParseField(ParseMemory* memory, const Structure* metaData);
 		static const struct Type* ParseFieldType(ParseMemory* memory);
-		static const Type* Config::ParseUnsignedType(ParseMemory* memory);
-		static const Type* Config::ParseCustomType(ParseMemory* memory);
+		static const Type* ParseUnsignedType(ParseMemory* memory);
+		static const Type* ParseCustomType(ParseMemory* memory);
 		static StructureField ParseFieldName(ParseMemory* memory, const Structure* metaData);
 
 		static void ParseValue(ParseMemory* memory, StructureField field, void* out);
@@ -1,13 +1,23 @@
 #include "MemoryMappedFile.h"
 
 #include <filesystem>
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "core/CLog.h"
 
 namespace Core
 {
+#ifdef _WIN32
 	MemoryMappedFile::MemoryMappedFile(const char* path) :
 		m_fileHandle(INVALID_HANDLE_VALUE),
 		m_mappingHandle(NULL),
@@ -77,4 +87,62 @@ namespace Core
 			buf, (sizeof(buf) / sizeof(wchar_t)), NULL);
 		LOG(LOG_ERROR, buf); // tolog: use channel for in/out
 	}
+#else
+	// the mapping outlives the descriptor : m_fileHandle and m_mappingHandle stay null
+	MemoryMappedFile::MemoryMappedFile(const char* path) :
+		m_fileHandle(nullptr),
+		m_mappingHandle(nullptr),
+		m_fileView(nullptr)
+	{
+		const int descriptor = open(path, O_RDONLY);
+		if (descriptor == -1)
+		{
+			ManageError();
+			return;
+		}
+
+		struct stat status {};
+		if (fstat(descriptor, &status) == -1)
+		{
+			ManageError();
+			close(descriptor);
+			return;
+		}
+
+		if (status.st_size == 0) // cannot be mapped, like on Windows
+		{
+			LOG(LOG_ERROR, std::string("cannot map the empty file ") + path); // tolog: use channel for in/out
+			close(descriptor);
+			return;
+		}
+
+		void* view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		close(descriptor);
+		if (view == MAP_FAILED)
+		{
+			ManageError();
+			return;
+		}
+
+		m_fileView = view;
+		m_data = (char const*)m_fileView;
+		m_size = (size_t)status.st_size;
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		if (m_fileView != nullptr)
+			munmap(m_fileView, m_size);
+	}
+
+	bool Core::MemoryMappedFile::IsValid() const
+	{
+		return m_fileView != nullptr;
+	}
+
+	void MemoryMappedFile::ManageError()
+	{
+		LOG(LOG_ERROR, strerror(errno)); // tolog: use channel for in/out
+	}
+#endif
 }
@@ -24,7 +24,7 @@ namespace Core
 
     const Constant* Enumeration::FindConstant(const char* pName) const
     {
-        long long hash = ConstexprCustomHash(pName); // todo : switch to CustomHash when ConstexprCustomHash and CustomHash are equivalent
+        long long hash = CustomHash(pName);
         for(const Constant& constant : m_constants)
             if (constant.name.hash == hash)
                 return &constant;
@@ -1,53 +1,96 @@
 #include "FuncMeta.h"
 
+#include "../CLog.h"
+
 namespace Core
 {
 	Function::Function(const std::string & pName, const std::string & pType, bool pIsStatic) :
 		name(pName),
-		type((Type*)GetHashWithoutConst(pType)),
+		typeHash(GetHashWithoutConst(pType)),
 		isStatic(pIsStatic)
 	{}
 
 	Function::Function(const std::string& pName, const std::string& pType, std::initializer_list<Parameter> pParams, bool pIsStatic) :
 		name(pName.c_str()),
-		type((Type*)GetHashWithoutConst(pType)),
+		typeHash(GetHashWithoutConst(pType)),
 		m_parameters(std::move(pParams)),
 		isStatic(pIsStatic)
 	{}
 
-	Result Function::Invoke(void* ref) const
+	void Function::Resolve()
 	{
-		InvokeImpl(ref);
+		type = Type::Find(typeHash);
 
-		return Result(buffer, type);
+		for (Parameter& parameter : m_parameters)
+		{
+			*(const Type**)&parameter.type = Type::Find(parameter.typeHash); // todo: log error parameter type without meta
+		}
 	}
 
-	const Function& Function::SetParam(const std::string& paramName, const void* value) const
+	Result Function::Invoke(void* ref, void* const* args, void* result) const
 	{
-		for (const Parameter& param : m_parameters)
+#ifndef _SHIPPING
+		CheckArguments(args);
+#endif
+		InvokeImpl(ref, args, result);
+
+		return Result(result, type);
+	}
+
+	int Function::FindParameter(const char* pName) const
+	{
+		long long hash = CustomHash(pName);
+		for (int i = 0; i < (int)m_parameters.size(); i++)
 		{
-			if (param.name.hash == ConstexprCustomHash(paramName.c_str()))
+			if (m_parameters[i].name.hash == hash)
 			{
-				memcpy(buffer + param.offset, value, param.type->size);
-				return *this;
+				return i;
 			}
 		}
 
-		// todo: log error param not found
-		return *this;
+		return -1;
 	}
 
-	void* Function::GetParamValue(const std::string& paramName) const
+#ifndef _SHIPPING
+	// the pack of Invoke has no length : only a missing argument can be seen
+	void Function::CheckArguments(void* const* args) const
 	{
-		for (const Parameter& param : m_parameters)
+		for (size_t i = 0; i < m_parameters.size(); i++)
 		{
-			if (param.name.hash == ConstexprCustomHash(paramName.c_str()))
+			if (args == nullptr || args[i] == nullptr)
 			{
-				return buffer + param.offset;
+				ASSERT(false, "missing argument " + m_parameters[i].name.text + " in call to " + name.text);
+				return;
 			}
 		}
+	}
 
-		// todo: log error param not found
-		return nullptr;
+	void Function::CheckCall(const size_t* argumentSizes, size_t argumentCount, size_t resultSize) const
+	{
+		if (argumentCount != m_parameters.size())
+		{
+			ASSERT(false, name.text + " takes " + std::to_string(m_parameters.size()) + " arguments, called with "
+				+ std::to_string(argumentCount));
+			return;
+		}
+
+		for (size_t i = 0; i < argumentCount; i++)
+		{
+			const Type* parameterType = m_parameters[i].type; // null for the types without meta, not checked
+			if (parameterType != nullptr && parameterType->size != (int)argumentSizes[i])
+			{
+				ASSERT(false, "argument " + m_parameters[i].name.text + " of " + name.text + " is not a " + parameterType->name.text);
+			}
+		}
+
+		if (resultSize != 0 && typeHash == ConstexprCustomHash("void"))
+		{
+			ASSERT(false, name.text + " returns void, called for a value");
+		}
+		else if (resultSize != 0 && type != nullptr && type->size != (int)resultSize)
+		{
+			ASSERT(false, name.text + " returns a " + type->name.text + ", called for another type");
+		}
 	}
+#endif
 }
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <new>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "BlackMagic.h"
@@ -23,15 +26,21 @@ namespace Core
 	{
 		Parameter(const std::string& pType, const std::string& pName) :
 			name(pName.c_str()),
-			type((Type*)GetHashWithoutConst(pType)),
-			offset(-1)
-		{}
+			typeHash(GetHashWithoutConst(pType)),
+			type(nullptr)
+		{} // type is resolved with the owning function
 
 		const Name name;
+		const long long typeHash;
 		const Type* const type;
-		const int offset;
 	};
 
+	// Reflected functions are invoked with a caller provided argument pack (one pointer per parameter, in declaration order)
+	// and a caller provided result storage (raw memory of MetaData->size bytes, the returned value is constructed in place).
+	// A null result storage discards the returned value.
+	// Nothing is shared between calls : invocation is reentrant and thread-safe.
+	// Outside shipping builds the arguments are checked against the parameters (count and size, for Call), the result
+	// against the return type.
 	struct Function
 	{
 	public:
@@ -39,37 +48,93 @@ namespace Core
 		Function(const std::string& pName, const std::string& pType, bool pIsStatic = false);
 		Function(const std::string& pName, const std::string& pType, std::initializer_list<Parameter> pParams, bool pIsStatic = false);
 
-		Result Invoke(void* ref) const;
-		const Function& SetParam(const std::string& paramName, const void* value) const;
+		Result Invoke(void* ref, void* const* args = nullptr, void* result = nullptr) const;
 
-		template<typename V>
-		const Function& SetParamValue(const std::string& paramName, V value) const
-		{
-			return SetParam(paramName, &value);
-		}
+		// typed call : Call<void*>(nullptr, handle) is roughly the cost of a virtual call
+		template<typename R = void, typename... A>
+		R Call(void* ref, A&&... arguments) const;
+
+		ArrayView<Parameter> GetParameters() const { return m_parameters; }
+		int FindParameter(const char* pName) const; // slot of the parameter in the argument pack, -1 if not found
 
 		const Name name;
-		const Type* type;
+		const long long typeHash;
+		const Type* type = nullptr;
 		const bool isStatic; // todo: better (use flags ???)
 
 	protected:
-		virtual void InvokeImpl(void* ref) const = 0; // todo: use lambda ??
-		void* GetParamValue(const std::string& paramName) const;
+		virtual void InvokeImpl(void* ref, void* const* args, void* result) const = 0;
+
+		// call f with args converted to Params, construct the returned value in result
+		template<typename... Params, typename F>
+		static void Forward(F&& f, void* const* args, void* result)
+		{
+			ForwardImpl<Params...>(f, args, result, std::index_sequence_for<Params...>());
+		}
 
 	private:
-		friend void InitStructureReflection(class Structure* type);
-		friend void InitFunctionReflection();
-		friend void InitReflection();
+		friend class Structure;
 
-		std::vector<Parameter> m_parameters;
+		void Resolve(); // called once by the owning structure
 
-		inline static char* bufferData;
+#ifndef _SHIPPING
+		void CheckArguments(void* const* args) const;
+		void CheckCall(const size_t* argumentSizes, size_t argumentCount, size_t resultSize) const; // resultSize 0 : void
+#endif
 
-	protected:
+		template<typename P>
+		static decltype(auto) CastArgument(void* arg)
+		{
+			if constexpr (std::is_rvalue_reference_v<P>)
+				return std::move(*(std::remove_reference_t<P>*)arg);
+			else
+				return *(std::remove_reference_t<P>*)arg;
+		}
 
-		inline static char* const& buffer = bufferData;
+		template<typename... Params, typename F, size_t... I>
+		static void ForwardImpl(F& f, void* const* args, void* result, std::index_sequence<I...>)
+		{
+			(void)args;
+			using R = decltype(f(CastArgument<Params>(args[I])...));
+
+			if constexpr (std::is_void_v<R>)
+				f(CastArgument<Params>(args[I])...);
+			else if (result == nullptr)
+				(void)f(CastArgument<Params>(args[I])...);
+			else
+				new (result) std::decay_t<R>(f(CastArgument<Params>(args[I])...));
+		}
 
+		std::vector<Parameter> m_parameters;
 	};
+
+	template<typename R, typename... A>
+	R Function::Call(void* ref, A&&... arguments) const
+	{
+		void* args[sizeof...(A) + 1] = { (void*)&arguments..., nullptr };
+
+		if constexpr (std::is_void_v<R>)
+		{
+#ifndef _SHIPPING
+			const size_t argumentSizes[sizeof...(A) + 1] = { sizeof(std::decay_t<A>)..., 0 };
+			CheckCall(argumentSizes, sizeof...(A), 0);
+#endif
+			InvokeImpl(ref, args, nullptr);
+		}
+		else
+		{
+#ifndef _SHIPPING
+			const size_t argumentSizes[sizeof...(A) + 1] = { sizeof(std::decay_t<A>)..., 0 };
+			CheckCall(argumentSizes, sizeof...(A), sizeof(R));
+#endif
+			alignas(R) char storage[sizeof(R)];
+			InvokeImpl(ref, args, storage);
+
+			R value = std::move(*(R*)storage);
+			((R*)storage)->~R();
+			return value;
+		}
+	}
 }
 
 
@@ -95,7 +160,6 @@ namespace Core
 #define _UNPACK(__parameter_type__, __parameter_name__) __parameter_type__ __parameter_name__
 #define _UNPACK_TYPE(__parameter_type__, __parameter_name__) __parameter_type__
 #define _PARAMETER(__parameter_type__, __parameter_name__) Core::Parameter(STRINGYFY(__parameter_type__), STRINGYFY(__parameter_name__))
-#define _USE_PARAMETER(__parameter_type__, __parameter_name__) *(__parameter_type__*)GetParamValue(STRINGYFY(__parameter_name__))
 
 
 
@@ -109,6 +173,8 @@ namespace Core
 #define _STATIC_META_FUNCTION(...)
 #define _FUNCTION_META_FUNCTION(__return_type__, __function_name__, ...) __function_name__
 #define _GENERAL_META_FUNCTION(...)
+#define _FIELD_DESCRIPTOR_FUNCTION(...)
+#define _BASE_DESCRIPTOR_FUNCTION(...)
 
 
 
@@ -121,6 +187,8 @@ namespace Core
 #define _STATIC_META_PRIVATE_FUNCTION(...)
 #define _FUNCTION_META_PRIVATE_FUNCTION(__return_type__, __function_name__, ...) __function_name__
 #define _GENERAL_META_PRIVATE_FUNCTION(...)
+#define _FIELD_DESCRIPTOR_PRIVATE_FUNCTION(...)
+#define _BASE_DESCRIPTOR_PRIVATE_FUNCTION(...)
 
 
 
@@ -133,16 +201,11 @@ template<class T> struct CAT(__function_name__, Function) : public Core::Functio
 	Core::Function(STRINGYFY(__function_name__), STRINGYFY(__return_type__), { IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(UNFOLD_PARAMETER)(_PARAMETER, __VA_ARGS__)) () }) /*\n*/\
 	{} /*\n*/\
  /*\n*/\
-	void InvokeImpl(void* ref) const override /*\n*/\
+	void InvokeImpl(void* ref, void* const* args, void* result) const override /*\n*/\
 	{ /*\n*/\
-		if constexpr (std::is_same_v<std::invoke_result_t<decltype(&__struct_name__::__function_name__), __struct_name__, IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(UNFOLD_PARAMETER)(_UNPACK_TYPE, __VA_ARGS__)) ()>, void>) /*\n*/\
-		{ /*\n*/\
-			((__struct_name__*)ref)->__function_name__(IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(UNFOLD_PARAMETER)(_USE_PARAMETER, __VA_ARGS__)) ()); /*\n*/\
-		} /*\n*/\
-		else /*\n*/\
-		{ /*\n*/\
-			*(__return_type__*)buffer = ((__struct_name__*)ref)->__function_name__(IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(UNFOLD_PARAMETER)(_USE_PARAMETER, __VA_ARGS__)) ()); /*\n*/\
-		} /*\n*/\
+		Forward<IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(UNFOLD_PARAMETER)(_UNPACK_TYPE, __VA_ARGS__)) ()>( /*\n*/\
+			[ref](auto&&... values) -> decltype(auto) { return ((__struct_name__*)ref)->__function_name__(std::forward<decltype(values)>(values)...); }, /*\n*/\
+			args, result); /*\n*/\
 	} /*\n*/\
 };
 
@@ -158,6 +221,8 @@ template<class T> struct CAT(__function_name__, Function) : public Core::Functio
 #define _STATIC_META_OPERATOR(...)
 #define _FUNCTION_META_OPERATOR(...)
 #define _GENERAL_META_OPERATOR(...)
+#define _FIELD_DESCRIPTOR_OPERATOR(...)
+#define _BASE_DESCRIPTOR_OPERATOR(...)
 
 
 
@@ -1,8 +1,9 @@
 #pragma once
 
 // std
-#include <vector>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "../Flag.h"
 
@@ -11,10 +12,9 @@
 typedef char char_32[32];
 typedef char char_256[256];
 
-namespace Core // todo : have reflection figure out at compile time. (consteval)
+namespace Core
 {
-    long long CustomHash(const char* str);
-    constexpr long long ConstexprCustomHash(const char* str) // todo: make ConstexprCustomHash and CustomHash equivalent (warning: pointer(*))
+    constexpr long long ConstexprCustomHash(const char* str)
     {
         const int MAX_CHAR = 7;
 
@@ -54,14 +54,11 @@ namespace Core // todo : have reflection figure out at compile time. (consteval)
         return hash;
     }
 
-    long long GetHashWithoutConst(std::string type); // todo: find cleaner way to name/use this function
-
-
+    // same hash as ConstexprCustomHash, for names only known at runtime
+    inline long long CustomHash(const char* str) { return ConstexprCustomHash(str); }
+    inline long long CustomHash(const std::string& str) { return ConstexprCustomHash(str.c_str()); }
 
-    void InitReflection(); // Finish setuping value into const variable. This cannot be avoid because the order of static instanciation cannot be controlled
-    void InitReflectionOf(const struct Type* type);
-    void InitStructureReflection(class Structure* type);
-    void InitFunctionReflection();
+    long long GetHashWithoutConst(std::string type); // todo: find cleaner way to name/use this function
 
 
 
@@ -94,7 +91,7 @@ namespace Core // todo : have reflection figure out at compile time. (consteval)
     {
         Name(const std::string& pName) :
             text(pName),
-            hash(ConstexprCustomHash(pName.c_str()))
+            hash(CustomHash(pName))
         {}
 
         bool operator==(const Name& other) const { return hash == other.hash; }
@@ -114,6 +111,7 @@ namespace Core // todo : have reflection figure out at compile time. (consteval)
             step(step)
         {
             TypeDataBase.emplace_back(this);
+            GetTypeIndex().emplace(name.hash, this); // first registered type wins, like a linear search
         }
 
         bool operator==(const Type& other) const { return name == other.name; }
@@ -128,12 +126,12 @@ namespace Core // todo : have reflection figure out at compile time. (consteval)
         static const Type* Find(long long type);
         static const Type* Find(const Name& name) { return Find(name.hash); }
         static const Type* Find(const char* name) { return Find(ConstexprCustomHash(name)); }
-        static const Type* Find(const std::string& name) { return Find(ConstexprCustomHash(name.c_str())); } // todo : switch to CustomHash when ConstexprCustomHash and CustomHash are equivalent
+        static const Type* Find(const std::string& name) { return Find(CustomHash(name)); }
 
         static const Type NO_TYPE;
 
     private:
-        friend void Core::InitReflection(); // so Core::InitReflection() can access Type::TypeDataBase
+        static std::unordered_map<long long, Type*>& GetTypeIndex(); // function static : types register during static initialization
 
         inline static std::vector<Type*> TypeDataBase;
 
@@ -156,13 +154,14 @@ namespace Core // todo : have reflection figure out at compile time. (consteval)
     {
         Field(const std::string& pName, const std::string& pType, int pOffset, FieldFlag pFlags = FieldFlag::NONE) :
             name(pName),
-            type((Type*)ConstexprCustomHash(pType.c_str())),
+            typeHash(CustomHash(pType)),
             offset(pOffset),
             flags(pFlags)
-        {} // type will be change from hash to pointer in InitRefelction().
+        {} // type is resolved from typeHash the first time the owning structure is used
 
         const Name name;
-        const Type* const type;
+        const long long typeHash;
+        const Type* const type = nullptr;
         const int offset;
         const FieldFlag flags;
     };
@@ -17,7 +17,7 @@ namespace Core
     {
         if (m_alreadyExist) return *this;
 
-        m_struct->m_bases.emplace_back(pType, pOffset); // base will be change from hash to pointer in InitRefelction().
+        m_struct->m_bases.emplace_back(pType, pOffset); // base type is resolved on first use of the structure
 
         return *this;
     }
@@ -94,8 +94,65 @@ namespace Core
         return *this;
     }
 
+    const Type* Structure::ResolveType(long long pHash)
+    {
+        const Type* type = Type::Find(pHash);
+
+        if (type && type->category == ETypeCategory::STRUCTURE)
+            ((const Structure*)type)->Resolve(); // nested structure must know its step
+
+        return type;
+    }
+
+    void Structure::Resolve() const
+    {
+        std::call_once(m_resolveFlag, [this]() { ((Structure*)this)->ResolveTypes(); });
+    }
+
+    void Structure::ResolveTypes()
+    {
+        int maxStep = step;
+
+        for (StructureBase& base : m_bases)
+        {
+            const Type* typeFound = ResolveType(base.typeHash);
+            *(const Type**)&base.type = typeFound;
+
+            if (typeFound && maxStep < typeFound->step) // todo: deal with Type::Find() return nullptr
+                maxStep = typeFound->step;
+        }
+
+        for (Field& field : m_fields)
+        {
+            const Type* typeFound = ResolveType(field.typeHash);
+            *(const Type**)&field.type = typeFound;
+
+            if (typeFound && maxStep < typeFound->step) // todo: deal with Type::Find() return nullptr
+                maxStep = typeFound->step;
+        }
+
+        for (StaticField& field : m_staticFields)
+        {
+            *(const Type**)&field.type = Type::Find(field.typeHash);
+        }
+
+        *(int*)&step = maxStep;
+
+        for (Function* function : m_functions)
+        {
+            function->Resolve();
+        }
+
+        if (m_constructor)
+        {
+            m_constructor->Resolve();
+        }
+    }
+
     StructureField Structure::FindField(long long pHash) const
     {
+        Resolve();
+
         for(const Field& field : m_fields)
             if (field.name.hash == pHash)
                 return StructureField(field, 0);
@@ -118,6 +175,8 @@ namespace Core
 
     const StaticField* Structure::FindStaticField(long long pHash) const
     {
+        Resolve();
+
         for (const StaticField& field : m_staticFields)
             if (field.name.hash == pHash)
                 return &field;
@@ -140,6 +199,8 @@ namespace Core
 
     const Function* Structure::FindFunction(long long pHash) const
     {
+        Resolve();
+
         for (const Function* function : m_functions)
             if (function->name.hash == pHash)
                 return function;
@@ -162,6 +223,8 @@ namespace Core
 
     bool Structure::Inherit(long long pHash) const
     {
+        Resolve();
+
         if (name.hash == pHash)
         {
             return true;
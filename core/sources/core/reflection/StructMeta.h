@@ -1,5 +1,8 @@
 #pragma once
 
+#include <mutex>
+#include <type_traits>
+
 #include "FuncMeta.h"
 #include "StructureField.h"
 
@@ -48,24 +51,27 @@ namespace Core
 
         const std::string& GetName() const { return name.text; }
 
-        ArrayView<StructureBase> GetBases() const { return m_bases; }
-        bool Inherit(const char* pName) const { return Inherit(ConstexprCustomHash(pName)); } // todo : switch to CustomHash when ConstexprCustomHash and CustomHash are equivalent
+        ArrayView<StructureBase> GetBases() const { Resolve(); return m_bases; }
+        bool Inherit(const char* pName) const { return Inherit(CustomHash(pName)); }
 
-        StructureField FindField(const char* pName) const { return FindField(ConstexprCustomHash(pName)); } // todo : switch to CustomHash when ConstexprCustomHash and CustomHash are equivalent
+        StructureField FindField(const char* pName) const { return FindField(CustomHash(pName)); }
         //ArrayView<Field> GetFields() const { return ArrayView (m_fields); } // todo : remove if no usage is found
-        FieldIterable GetAllFields() const { return FieldIterable(this); }
+        FieldIterable GetAllFields() const { Resolve(); return FieldIterable(this); }
 
-        const StaticField* FindStaticField(const char* pName) const { return FindStaticField(ConstexprCustomHash(pName)); }
+        const StaticField* FindStaticField(const char* pName) const { return FindStaticField(CustomHash(pName)); }
 
-        void* New() const { return *(void**)m_constructor->Invoke(nullptr).Data; }
-        const Function* FindFunction(const char* pName) const { return FindFunction(ConstexprCustomHash(pName)); } // todo : switch to CustomHash when ConstexprCustomHash and CustomHash are equivalent
+        void* New() const { Resolve(); return m_constructor->Call<void*>(nullptr); }
+        const Function* FindFunction(const char* pName) const { return FindFunction(CustomHash(pName)); }
 
         //ArrayView<const Function*> GetFunctions() const { return ArrayView(m_functions); }
 
     private:
         friend StructBuilder;
         friend FieldIterator;
-        friend void InitStructureReflection(class Structure* type);
+
+        void Resolve() const; // turn the type hashes of bases, fields and functions into types, once
+        void ResolveTypes();
+        static const Type* ResolveType(long long pHash);
 
         bool Inherit(long long pHash) const;
         StructureField FindField(long long pHash) const;
@@ -78,7 +84,53 @@ namespace Core
         std::vector<Function*> m_functions;
         Function* m_constructor;
 
+        mutable std::once_flag m_resolveFlag;
     };
+
+
+
+    struct FieldNotFound {};
+
+    // Compile time description of a reflected field, generated by the STRUCT macro
+    template<typename S, typename F, F S::* Member, long long NameHash>
+    struct FieldDescriptor
+    {
+        using StructType = S;
+        using FieldType = F;
+
+        static constexpr F S::* member = Member;
+        static constexpr long long nameHash = NameHash;
+
+        static F& Get(S& instance) { return instance.*Member; }
+        static const F& Get(const S& instance) { return instance.*Member; }
+        static int Offset() { return (int)(long long)&(((S*)0)->*Member); }
+    };
+
+    template<typename S, long long NameHash, typename = void>
+    struct HasFieldDescriptors : std::false_type {};
+
+    template<typename S, long long NameHash>
+    struct HasFieldDescriptors<S, NameHash, std::void_t<decltype(S::template FindFieldDescriptor<NameHash>())>> : std::true_type {};
+
+    template<typename S, long long NameHash>
+    constexpr auto FindFieldDescriptorIn()
+    {
+        if constexpr (HasFieldDescriptors<S, NameHash>::value)
+            return S::template FindFieldDescriptor<NameHash>();
+        else
+            return FieldNotFound();
+    }
+
+    template<typename S, long long NameHash>
+    constexpr bool IsFieldFound = !std::is_same_v<decltype(FindFieldDescriptorIn<S, NameHash>()), FieldNotFound>;
+
+    // Resolve a field at compile time : Core::FindField<Light, Core::ConstexprCustomHash("red")>().Get(light)
+    template<typename S, long long NameHash>
+    constexpr auto FindField()
+    {
+        static_assert(IsFieldFound<S, NameHash>, "no reflected field with this name");
+        return FindFieldDescriptorIn<S, NameHash>();
+    }
 }
 
 #define CHOOSE_AND_UNFOLD(choice, first, ...)\
@@ -126,6 +178,8 @@ namespace Core
 #define _STATIC_META_FIELD(...)
 #define _FUNCTION_META_FIELD(...)
 #define _GENERAL_META_FIELD(...)
+#define _FIELD_DESCRIPTOR_FIELD(...) __VA_ARGS__
+#define _BASE_DESCRIPTOR_FIELD(...)
 
 #define PRIVATE_FIELD(__field_type__, __field_name__, ...) _PRIVATE_FIELD(__field_type__, __field_name__, __VA_ARGS__)
 #define _BASE_PRIVATE_FIELD(...)
@@ -136,6 +190,8 @@ namespace Core
 #define _STATIC_META_PRIVATE_FIELD(...)
 #define _FUNCTION_META_PRIVATE_FIELD(...)
 #define _GENERAL_META_PRIVATE_FIELD(...)
+#define _FIELD_DESCRIPTOR_PRIVATE_FIELD(...) __VA_ARGS__
+#define _BASE_DESCRIPTOR_PRIVATE_FIELD(...)
 
 #define _FIELD_META_BODY(__struct_name__, __field_type__, __field_name__, ...)\
     IF_ELSE(HAS_ARGS(__VA_ARGS__))\
@@ -145,6 +201,13 @@ namespace Core
 
 
 
+#define _FIELD_DESCRIPTOR_BODY(__struct_name__, __field_type__, __field_name__, ...)\
+    if constexpr (__name_hash__ == Core::ConstexprCustomHash(STRINGYFY(__field_name__)))/*\n*/\
+        return Core::FieldDescriptor<__struct_name__, decltype(__struct_name__::__field_name__), &__struct_name__::__field_name__, __name_hash__>();/*\n*/\
+    else
+
+
+
 #define STATIC_FIELD(__field_type__, __field_name__, ...) _STATIC_FIELD(__field_type__, __field_name__, __VA_ARGS__)
 #define _BASE_STATIC_FIELD(...)
 #define _DATA_STATIC_FIELD(__field_type__, __field_name__, ...)\
@@ -158,6 +221,8 @@ namespace Core
 #define _STATIC_META_STATIC_FIELD(__field_type__, __field_name__, ...) __field_type__, __field_name__
 #define _FUNCTION_META_STATIC_FIELD(...)
 #define _GENERAL_META_STATIC_FIELD(...)
+#define _FIELD_DESCRIPTOR_STATIC_FIELD(...)
+#define _BASE_DESCRIPTOR_STATIC_FIELD(...)
 
 #define _STATIC_META_BODY(__struct_name__, __field_type__, __field_name__) .AddStaticField(STRINGYFY(__field_type__), STRINGYFY(__field_name__), &__struct_name__::__field_name__)
 
@@ -172,6 +237,8 @@ namespace Core
 #define _STATIC_META_BASE(...)
 #define _FUNCTION_META_BASE(...)
 #define _GENERAL_META_BASE(...)
+#define _FIELD_DESCRIPTOR_BASE(...)
+#define _BASE_DESCRIPTOR_BASE(__base_type__, ...) __base_type__
 
 
 
@@ -184,6 +251,8 @@ namespace Core
 #define _STATIC_META_OTHER_BASE(...)
 #define _FUNCTION_META_OTHER_BASE(...)
 #define _GENERAL_META_OTHER_BASE(...)
+#define _FIELD_DESCRIPTOR_OTHER_BASE(...)
+#define _BASE_DESCRIPTOR_OTHER_BASE(__base_type__, ...) __base_type__
 
 
 
@@ -196,6 +265,8 @@ namespace Core
 #define _STATIC_META_BASE2(...)
 #define _FUNCTION_META_BASE2(...)
 #define _GENERAL_META_BASE2(...)
+#define _FIELD_DESCRIPTOR_BASE2(...)
+#define _BASE_DESCRIPTOR_BASE2(__base_type__, ...) __base_type__
 
 #define CRTP_BASE(__struct_name__, __base_type__) _CRTP_BASE(__struct_name__, __base_type__)
 #define _BASE_CRTP_BASE(__struct_name__, __base_type__) : public __base_type__<__struct_name__>
@@ -206,6 +277,8 @@ namespace Core
 #define _STATIC_META_CRTP_BASE(...)
 #define _FUNCTION_META_CRTP_BASE(...)
 #define _GENERAL_META_CRTP_BASE(...)
+#define _FIELD_DESCRIPTOR_CRTP_BASE(...)
+#define _BASE_DESCRIPTOR_CRTP_BASE(__struct_name__, __base_type__) __base_type__<__struct_name__>
 
 
 
@@ -220,6 +293,13 @@ namespace Core
 
 
 
+#define _BASE_DESCRIPTOR_BODY(__struct_name__, __base_type__)\
+    if constexpr (Core::IsFieldFound<__base_type__, __name_hash__>)/*\n*/\
+        return Core::FindFieldDescriptorIn<__base_type__, __name_hash__>();/*\n*/\
+    else
+
+
+
 #define SUPPLEMENT(__supplement_base__, __supplement_data__, __supplement_meta__) _SUPPLEMENT(__supplement_base__, __supplement_data__, __supplement_meta__)
 #define _BASE_SUPPLEMENT(__supplement_base__, __supplement_data__, __supplement_meta__) __supplement_base__
 #define _DATA_SUPPLEMENT(__supplement_base__, __supplement_data__, __supplement_meta__) __supplement_data__
@@ -229,6 +309,8 @@ namespace Core
 #define _STATIC_META_SUPPLEMENT(...)
 #define _FUNCTION_META_SUPPLEMENT(...)
 #define _GENERAL_META_SUPPLEMENT(__supplement_base__, __supplement_data__, __supplement_meta__) __supplement_meta__
+#define _FIELD_DESCRIPTOR_SUPPLEMENT(...)
+#define _BASE_DESCRIPTOR_SUPPLEMENT(...)
 
 
 
@@ -245,8 +327,9 @@ struct __struct_name__ EVAL(IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(CHOOSE_AND_UN
 private:/*\n*/\
     struct ConstructorObject : public Core::Function {/*\n*/\
         ConstructorObject() : Function("Constructor", "void*") {}/*\n*/\
-        void InvokeImpl(void*) const override {/*\n*/\
-            *(void**)buffer = new __struct_name__();/*\n*/\
+        void InvokeImpl(void*, void* const*, void* result) const override {/*\n*/\
+            if (result != nullptr) /* nobody would own the new object otherwise *//*\n*/\
+                new (result) void*(new __struct_name__());/*\n*/\
         }/*\n*/\
     };/*\n*/\
     EVAL(IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(ADD_AND_UNFOLD)(__struct_name__, _FUNC, __VA_ARGS__)) (/*inside else*/))\
@@ -254,6 +337,13 @@ private:/*\n*/\
 public:/*\n*/\
     friend Core::Structure* Reflection::CAT(__struct_name__, Meta)(); /*\n*/\
     inline static const Core::Structure* const MetaData = Reflection::CAT(__struct_name__, Meta)(); /*\n*/\
+/*\n*/\
+    template<long long __name_hash__> static constexpr auto FindFieldDescriptor()/*\n*/\
+    {/*\n*/\
+        EVAL(IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(ADD_AND_UNFOLD)(__struct_name__, _FIELD_DESCRIPTOR, __VA_ARGS__)) (/*inside else*/))\
+        EVAL(IF_ELSE(HAS_ARGS(__VA_ARGS__)) (DEFER2(ADD_AND_UNFOLD)(__struct_name__, _BASE_DESCRIPTOR, __VA_ARGS__)) (/*inside else*/))\
+        return Core::FieldNotFound();/*\n*/\
+    }/*\n*/\
 };/*\n*/\
 /*\n*/\
 inline Core::Structure* Reflection::CAT(__struct_name__, Meta)()/*\n*/\
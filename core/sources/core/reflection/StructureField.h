@@ -74,9 +74,9 @@ namespace Core
         StaticField() = delete;
         StaticField(const std::string& pName, const std::string& pType, void* pData) :
             name(pName),
-            type((Type*)ConstexprCustomHash(pType.c_str())),
+            typeHash(CustomHash(pType)),
             data(pData)
-        {} // type will be change from hash to pointer in InitRefelction().
+        {} // type is resolved from typeHash the first time the owning structure is used
 
         void* Get() const
         {
@@ -103,6 +103,7 @@ namespace Core
         bool IsValid() { return type; }
 
         const Name name = nullptr;
+        const long long typeHash = 0;
         const Type* const type = nullptr;
         void* const data = nullptr;
     };
@@ -113,16 +114,19 @@ namespace Core
     struct StructureBase
     {
         StructureBase(const std::string& pType, int pOffset) :
-            type((Type*)ConstexprCustomHash(pType.c_str())),
+            typeHash(CustomHash(pType)),
+            type(nullptr),
             offset(pOffset)
-        {} // type will be change from hash to pointer in InitRefelction().
+        {} // type is resolved from typeHash the first time the owning structure is used
 
+        const long long typeHash;
         const Type* const type;
         const int offset;
 
     private:
         friend FieldIterator;
         StructureBase(const Type* pType, int pOffset) : // todo: remove (use in FieldIterator::ChangeType())
+            typeHash(pType->name.hash),
             type(pType),
             offset(pOffset)
         {}
@@ -115,6 +115,16 @@ namespace ReflectionTest
 		FIELD(short, court),
 		FIELD(DiaB, diab)
 	);
+
+	// function invocation
+	STRUCT(Counter,
+		FIELD(int, count),
+		FUNCTION(void, Increase, int, amount),
+		FUNCTION(int, GetCount)
+	);
+
+	void Counter::Increase(int amount) { count += amount; }
+	int Counter::GetCount() { return count; }
 }
 
 
@@ -371,15 +381,64 @@ namespace Core
 		}
 	}
 
+	void CheckCompileTimeField()
+	{
+		static_assert(IsFieldFound<Light, ConstexprCustomHash("green")>, "ERROR : compile time FindField(...) test failed");
+		static_assert(IsFieldFound<Fourth, ConstexprCustomHash("f")>, "ERROR : compile time FindField(...) inheritance test failed");
+		static_assert(IsFieldFound<Test, ConstexprCustomHash("random")> == false, "ERROR : compile time FindField(...) found non-existing field");
+		static_assert(std::is_same_v<decltype(FindField<Full, ConstexprCustomHash("third")>())::FieldType, Third>, "ERROR : compile time FindField(...) type test failed");
+
+		Fourth fourth;
+		fourth.l = 42;
+		if (FindField<Fourth, ConstexprCustomHash("l")>().Get(fourth) != 42)
+		{
+			std::cout << "ERROR : compile time FieldDescriptor::Get(...) test failed" << std::endl;
+		}
+
+		if (FindField<Fourth, ConstexprCustomHash("s")>().Offset() != Fourth::MetaData->FindField("s").offset)
+		{
+			std::cout << "ERROR : compile time FieldDescriptor::Offset(...) test failed" << std::endl;
+		}
+	}
+
 	void CheckFunction()
 	{
-		// todo: todo
+		Counter counter;
+		counter.count = 1;
+
+		const Function* increase = Counter::MetaData->FindFunction("Increase");
+		const Function* getCount = Counter::MetaData->FindFunction("GetCount");
+
+		increase->Call(&counter, 41);
+		if (counter.count != 42)
+		{
+			std::cout << "ERROR : Function::Call(...) test failed" << std::endl;
+		}
+
+		if (getCount->Call<int>(&counter) != 42)
+		{
+			std::cout << "ERROR : Function::Call(...) result test failed" << std::endl;
+		}
+
+		int amount = -2;
+		void* args[] = { &amount };
+		increase->Invoke(&counter, args);
+
+		int result = 0;
+		getCount->Invoke(&counter, nullptr, &result);
+		if (result != 40)
+		{
+			std::cout << "ERROR : Function::Invoke(...) test failed" << std::endl;
+		}
+
+		if (increase->FindParameter("amount") != 0 || increase->FindParameter("random") != -1)
+		{
+			std::cout << "ERROR : Function::FindParameter(...) test failed" << std::endl;
+		}
 	}
 
 	void NonRegressionReflectionTest()
 	{
-		Core::InitReflection();
-
 		CheckSize();
 
 		if (Test::MetaData->FindField("random").IsValid())
@@ -391,6 +450,7 @@ namespace Core
 		CheckFieldCount();
 		CheckDefault();
 		CheckFieldAccess();
+		CheckCompileTimeField();
 
 		CheckFunction();
 
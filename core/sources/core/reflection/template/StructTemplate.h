@@ -79,16 +79,11 @@ namespace Core
                 Function("GetValue", "int")
             {}
 
-            void InvokeImpl(void* ref) const override
+            void InvokeImpl(void* ref, void* const* args, void* result) const override
             {
-                if constexpr (std::is_same<std::invoke_result_t<decltype(&StructTemplate::GetValue), StructTemplate>, void>::value)
-                {
-                    ((StructTemplate*)ref)->GetValue();
-                }
-                else
-                {
-                    *(int*)buffer = ((StructTemplate*)ref)->GetValue();
-                }
+                Forward<>(
+                    [ref](auto&&... values) -> decltype(auto) { return ((StructTemplate*)ref)->GetValue(std::forward<decltype(values)>(values)...); },
+                    args, result);
             }
         };
 
@@ -103,16 +98,11 @@ namespace Core
                 Function("SetValue", "void", { Core::Parameter("int", "newValue") })
             {}
 
-            void InvokeImpl(void* ref) const override
+            void InvokeImpl(void* ref, void* const* args, void* result) const override
             {
-                if constexpr (std::is_same_v<std::invoke_result_t<decltype(&StructTemplate::SetValue), StructTemplate, int>, void>)
-                {
-                    ((StructTemplate*)ref)->SetValue(*(int*)GetParamValue("newValue"));
-                }
-                else
-                {
-                    *(void*)buffer = ((StructTemplate*)ref)->SetValue(*(int*)GetParamValue("newValue"));
-                }
+                Forward<int>(
+                    [ref](auto&&... values) -> decltype(auto) { return ((StructTemplate*)ref)->SetValue(std::forward<decltype(values)>(values)...); },
+                    args, result);
             }
         };
 
@@ -127,16 +117,9 @@ namespace Core
                 Function("AddOneTo", "int", { Parameter("int", "number") }, true)
             {}
 
-            void InvokeImpl(void*) const override
+            void InvokeImpl(void*, void* const* args, void* result) const override
             {
-                if constexpr (std::is_same_v<std::invoke_result_t<decltype(&StructTemplate::SetValue), StructTemplate, int>, void>)
-                {
-                    AddOneTo(*(int*)GetParamValue("number"));
-                }
-                else
-                {
-                    *(int*)buffer = AddOneTo(*(int*)GetParamValue("number"));
-                }
+                Forward<int>(&AddOneTo, args, result);
             }
         };
 
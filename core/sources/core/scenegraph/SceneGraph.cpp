@@ -11,4 +11,9 @@ namespace Core
     {
         root->DeepCleanWorldTransform();
     }
+
+    void SceneGraph::StorePreviousTransforms()
+    {
+        root->StorePreviousWorldTransform();
+    }
 }
@@ -18,6 +18,7 @@ namespace Core
 		SceneGraph& operator=(SceneGraph&&) = delete;
 
 		void UpdateAll();
+		void StorePreviousTransforms(); // before each simulation step, for the interpolation of the rendered transforms
 		//void UpdateVisible(class Camera* view); //todo: add bounding sphere to sceneNode
 
 		SceneNode* GetRoot() { return root; }
@@ -196,6 +196,13 @@ namespace Core
 		SetScale(scale / parent->GetWorldTransformCheck().scale);
 	}
 
+	void SceneNode::SetWorldPositionAndRotationNoCheck(LibMath::Vector3 position, LibMath::Quaternion rotation)
+	{
+		worldTransformIsDirty = true;
+		local.position = position - parent->world.position;
+		local.rotation = parent->world.rotation.GetOffset(rotation);
+	}
+
 	const Transform& SceneNode::GetWorldTransformCheck()
 	{
 		std::stack<SceneNode*> ancestor;
@@ -257,6 +264,40 @@ namespace Core
 		return mat;
 	}
 
+	Transform SceneNode::GetInterpolatedWorldTransform(const float alpha) const
+	{
+		if (hasPreviousWorld == false || alpha >= 1.f)
+		{
+			return world;
+		}
+
+		return Interpolate(previousWorld, world, alpha);
+	}
+
+	LibMath::Matrix4 SceneNode::GenerateInterpolatedWorldTransformMatrix(const float alpha) const
+	{
+		const Transform trans = GetInterpolatedWorldTransform(alpha);
+
+		LibMath::Matrix4 mat(1.f);
+
+		mat = mat.Scale(trans.scale);
+		mat = mat.Rotate(trans.rotation);
+		mat = mat.Translate(trans.position);
+
+		return mat;
+	}
+
+	void SceneNode::StorePreviousWorldTransform()
+	{
+		previousWorld = world;
+		hasPreviousWorld = true;
+
+		for (SceneNode* child : children)
+		{
+			child->StorePreviousWorldTransform();
+		}
+	}
+
     bool SceneNode::IsDescendantOf(const SceneNode* other) const
     {
 		const auto* tempSceneNode = this;
@@ -57,12 +57,21 @@ namespace Core
 		void SetWorldRotation(LibMath::Quaternion rotation);
 		void SetWorldScale(LibMath::Vector3 scale);
 
+		// the parent world transform must be clean and is only read : many nodes can be written from several threads
+		void SetWorldPositionAndRotationNoCheck(LibMath::Vector3 position, LibMath::Quaternion rotation);
+
 		[[nodiscard]] const Transform& GetLocalTransform() const { return local; }
 		[[nodiscard]] const Transform& GetWorldTransformCheck();
 		[[nodiscard]] const Transform& GetWorldTransformNoCheck() const { return world; }
+		[[nodiscard]] bool IsWorldTransformDirty() const { return worldTransformIsDirty; }
 		[[nodiscard]] LibMath::Matrix4 GenerateWorldTransformMatrixCheck();
 		[[nodiscard]] LibMath::Matrix4 GenerateWorldTransformMatrixNoCheck() const;
 
+		// between the world transform of the previous simulation step and the current one, alpha 1 is the current one
+		[[nodiscard]] Transform GetInterpolatedWorldTransform(float alpha) const;
+		[[nodiscard]] LibMath::Matrix4 GenerateInterpolatedWorldTransformMatrix(float alpha) const;
+		void StorePreviousWorldTransform(); // and its descendants, world transforms must be clean
+
 		[[nodiscard]] bool IsDescendantOf(const SceneNode* other) const;
 
 		void DeepCleanWorldTransform(); // doc: nocheck
@@ -87,6 +96,8 @@ namespace Core
 
 		Transform local;
 		Transform world;
+		Transform previousWorld; // world transform before the last simulation step
+		bool hasPreviousWorld = false; // false until the node lived through a step, it is not interpolated before
 
 		LibMath::Matrix4 worldMatrix;
 
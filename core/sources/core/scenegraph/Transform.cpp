@@ -1,5 +1,7 @@
 #include "Transform.h"
 
+#include <cmath>
+
 namespace Core
 {
 	const Transform& Transform::operator=(const Transform& rhs)
@@ -48,4 +50,40 @@ namespace Core
 	{
 		return !(lhs == rhs);
 	}
+
+	Transform Interpolate(const Transform& from, const Transform& to, const float alpha)
+	{
+		const float beta = 1.f - alpha;
+
+		Transform result = to;
+		result.position = LibMath::Vector3(from.position.x * beta + to.position.x * alpha,
+		                                   from.position.y * beta + to.position.y * alpha,
+		                                   from.position.z * beta + to.position.z * alpha);
+		result.scale = LibMath::Vector3(from.scale.x * beta + to.scale.x * alpha,
+		                                from.scale.y * beta + to.scale.y * alpha,
+		                                from.scale.z * beta + to.scale.z * alpha);
+
+		// q and -q are the same rotation, flip one so the blend does not go the long way around
+		const LibMath::Quaternion& a = from.rotation;
+		const LibMath::Quaternion& b = to.rotation;
+		const float dot = a.X * b.X + a.Y * b.Y + a.Z * b.Z + a.W * b.W;
+		const float sign = dot < 0.f ? -1.f : 1.f;
+
+		float x = a.X * beta + b.X * alpha * sign;
+		float y = a.Y * beta + b.Y * alpha * sign;
+		float z = a.Z * beta + b.Z * alpha * sign;
+		float w = a.W * beta + b.W * alpha * sign;
+
+		const float length = std::sqrt(x * x + y * y + z * z + w * w);
+		if (length > 0.f)
+		{
+			x /= length;
+			y /= length;
+			z /= length;
+			w /= length;
+			result.rotation = LibMath::Quaternion(x, y, z, w);
+		}
+
+		return result;
+	}
 }
@@ -19,4 +19,7 @@ namespace Core
     Transform operator+(Transform lhs, const Transform& rhs);
     bool operator==(const Transform& lhs, const Transform& rhs);
     bool operator!=(const Transform& lhs, const Transform& rhs);
+
+    // position and scale are lerped, rotation is nlerped along the shortest arc
+    Transform Interpolate(const Transform& from, const Transform& to, float alpha);
 }
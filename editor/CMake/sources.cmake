@@ -1,4 +1,6 @@
 set(SOURCE_FILES
+sources/editor/EditorFrontend.cpp
+sources/editor/EditorFrontend.h
 sources/editor/GameComponents/BoulderComponent.cpp
 sources/editor/GameComponents/BoulderComponent.h
 sources/editor/GameComponents/CarChassisComponent.h
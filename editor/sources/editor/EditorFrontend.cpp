@@ -0,0 +1,39 @@
+#include "EditorFrontend.h"
+
+#include "core/InputManager/DefaultInputManager.h"
+#include "sound/SoundManager.h"
+
+EditorFrontend::EditorFrontend() : app(1600, 900, "Clone Engine")
+{
+}
+
+void EditorFrontend::PollInputs()
+{
+    GLFW::GLFWPollEvents();
+    Core::DefaultInputManager::ProcessMouse();
+}
+
+void EditorFrontend::ProcessInputs(const Core::InputClock::time_point until)
+{
+    Core::DefaultInputManager::ProcessInputs(until);
+}
+
+void EditorFrontend::Update(const float deltaTime)
+{
+    Sound::SoundManager::Update(deltaTime);
+}
+
+void EditorFrontend::Render(const float deltaTime, const bool isPipelined)
+{
+    app.DrawFrame(deltaTime, isPipelined);
+}
+
+void EditorFrontend::WaitRender()
+{
+    app.WaitRender();
+}
+
+bool EditorFrontend::IsActive() const
+{
+    return app.IsWindowActive();
+}
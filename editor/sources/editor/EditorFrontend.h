@@ -0,0 +1,20 @@
+#pragma once
+#include "core/GameLoopFrontend.h"
+#include "render/RenderInclude.h"
+
+// Window, inputs, audio and Vulkan rendering around the game loop
+class EditorFrontend final : public Core::GameLoopFrontend
+{
+public:
+    EditorFrontend();
+
+    void PollInputs() override;
+    void ProcessInputs(Core::InputClock::time_point until) override;
+    void Update(float deltaTime) override;
+    void Render(float deltaTime, bool isPipelined) override;
+    void WaitRender() override;
+    [[nodiscard]] bool IsActive() const override;
+
+private:
+    Render::RenderApplication app;
+};
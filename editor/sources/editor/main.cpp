@@ -1,6 +1,7 @@
 #include <cstdlib>
 
 
+#include "EditorFrontend.h"
 #include "SceneTemplate.h"
 #include "core/GameLoop.h"
 #include "core/ECS/World.h"
@@ -13,13 +14,13 @@ int main()
 {
 	Core::NonRegressionReflectionTest();
 
-	Core::InitReflection();
 	Physics::InitPhysics();
 
 	Core::World::Initialize();
 
 
-	Core::GameLoop gameLoop{};
+	EditorFrontend frontend; // opens the window
+	Core::GameLoop gameLoop{&frontend};
 
 	MainMenu();
 
@@ -0,0 +1,3 @@
+set(SOURCE_FILES
+sources/logdecoder/main.cpp
+ )
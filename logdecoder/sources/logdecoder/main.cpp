@@ -0,0 +1,260 @@
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "core/LogFormat.h"
+
+// Renders a binary log file written by CLog (ELogFileFormat::BINARY) as text
+//   logdecoder <file.clog> [--level <debug|info|warning|error>] [--channel <name>] [--find <text>] [--locations]
+
+using namespace Core::LogFormat;
+
+namespace
+{
+	struct Site
+	{
+		std::string file;
+		std::string format;
+		int line = 0;
+	};
+
+	struct Filter
+	{
+		unsigned int minLevel = 0;
+		int channel = -1; // all channels
+		std::string find;
+		bool showLocations = false;
+	};
+
+	template <typename T>
+	bool ReadValue(T& value, const char*& ptr, const char* endPtr)
+	{
+		if ((size_t)(endPtr - ptr) < sizeof(T))
+		{
+			return false;
+		}
+
+		memcpy(&value, ptr, sizeof(T));
+		ptr += sizeof(T);
+		return true;
+	}
+
+	bool ReadString(std::string& str, const char*& ptr, const char* endPtr)
+	{
+		unsigned short length;
+		if (ReadValue(length, ptr, endPtr) == false || (size_t)(endPtr - ptr) < length)
+		{
+			return false;
+		}
+
+		str.assign(ptr, length);
+		ptr += length;
+		return true;
+	}
+
+	bool EqualsIgnoreCase(const char* a, const char* b)
+	{
+		for (; *a != '\0' && *b != '\0'; a++, b++)
+		{
+			if (tolower((unsigned char)*a) != tolower((unsigned char)*b))
+			{
+				return false;
+			}
+		}
+		return *a == *b;
+	}
+
+	int FindName(const char* name, const char* const* names, unsigned int count)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (EqualsIgnoreCase(name, names[i]))
+			{
+				return (int)i;
+			}
+		}
+		return -1;
+	}
+
+	std::string FormatTime(const FileHeader& header, long long ticks)
+	{
+		const long double seconds = (long double)ticks * header.tickNumerator / header.tickDenominator;
+		const time_t timestamp = (time_t)seconds;
+		const int milliseconds = (int)((seconds - (long double)timestamp) * 1000);
+
+		struct tm timeInfos {};
+		if (localtime_s(&timeInfos, &timestamp) != 0)
+		{
+			return std::to_string(ticks);
+		}
+
+		char buffer[80];
+		const size_t length = strftime(buffer, sizeof(buffer), "%d/%m/%Y-%H:%M.%S", &timeInfos);
+		snprintf(buffer + length, sizeof(buffer) - length, ".%03d", milliseconds);
+		return buffer;
+	}
+
+	int PrintUsage()
+	{
+		printf("usage: logdecoder <file%s> [--level <debug|info|warning|error>] [--channel <name>] [--find <text>] [--locations]\n",
+		       FILE_EXTENSION);
+		return EXIT_FAILURE;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		return PrintUsage();
+	}
+
+	Filter filter;
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--locations") == 0)
+		{
+			filter.showLocations = true;
+		}
+		else if (i + 1 < argc && strcmp(argv[i], "--level") == 0)
+		{
+			const int level = FindName(argv[++i], LEVEL_NAMES, LEVEL_COUNT);
+			if (level < 0)
+			{
+				return PrintUsage();
+			}
+			filter.minLevel = (unsigned int)level;
+		}
+		else if (i + 1 < argc && strcmp(argv[i], "--channel") == 0)
+		{
+			filter.channel = FindName(argv[++i], CHANNEL_NAMES, CHANNEL_COUNT);
+			if (filter.channel < 0)
+			{
+				printf("unknown channel \"%s\"\n", argv[i]);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (i + 1 < argc && strcmp(argv[i], "--find") == 0)
+		{
+			filter.find = argv[++i];
+		}
+		else
+		{
+			return PrintUsage();
+		}
+	}
+
+	std::ifstream file(argv[1], std::ios::in | std::ios::binary);
+	if (file.is_open() == false)
+	{
+		printf("could not open \"%s\"\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	const char* ptr = data.data();
+	const char* endPtr = data.data() + data.size();
+
+	FileHeader header;
+	if (ReadValue(header, ptr, endPtr) == false
+		|| memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+		|| header.tickDenominator == 0)
+	{
+		printf("\"%s\" is not a binary log file\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	if (header.version > VERSION)
+	{
+		printf("unsupported log version %u (expected %u)\n", header.version, VERSION);
+		return EXIT_FAILURE;
+	}
+
+	std::vector<Site> sites;
+
+	while (ptr < endPtr)
+	{
+		unsigned char record;
+		ReadValue(record, ptr, endPtr);
+
+		if ((ERecord)record == ERecord::SITE)
+		{
+			unsigned int id;
+			Site site;
+			if (ReadValue(id, ptr, endPtr) == false
+				|| ReadValue(site.line, ptr, endPtr) == false
+				|| ReadString(site.file, ptr, endPtr) == false
+				|| ReadString(site.format, ptr, endPtr) == false)
+			{
+				break;
+			}
+
+			if (id >= sites.size())
+			{
+				sites.resize((size_t)id + 1);
+			}
+			sites[id] = std::move(site);
+		}
+		else if ((ERecord)record == ERecord::MESSAGE)
+		{
+			unsigned int siteId;
+			unsigned char level;
+			unsigned char channel;
+			long long ticks;
+			unsigned short size;
+			if (ReadValue(siteId, ptr, endPtr) == false
+				|| ReadValue(level, ptr, endPtr) == false
+				|| ReadValue(channel, ptr, endPtr) == false
+				|| ReadValue(ticks, ptr, endPtr) == false
+				|| ReadValue(size, ptr, endPtr) == false
+				|| (size_t)(endPtr - ptr) < size)
+			{
+				break;
+			}
+
+			const char* messageArguments = ptr;
+			ptr += size;
+
+			if (level < filter.minLevel
+				|| (filter.channel >= 0 && channel != filter.channel)
+				|| siteId >= sites.size())
+			{
+				continue;
+			}
+
+			const Site& site = sites[siteId];
+			const std::string message = Render(site.format.c_str(), messageArguments, size);
+			if (filter.find.empty() == false && message.find(filter.find) == std::string::npos)
+			{
+				continue;
+			}
+
+			printf("[%s] %s %s : %s", FormatTime(header, ticks).c_str(),
+			       channel < CHANNEL_COUNT ? CHANNEL_NAMES[channel] : "?",
+			       level < LEVEL_COUNT ? LEVEL_NAMES[level] : "?",
+			       message.c_str());
+			if (filter.showLocations)
+			{
+				printf(" (%s:%d)", site.file.c_str(), site.line);
+			}
+			printf("\n");
+		}
+		else
+		{
+			printf("corrupted record, stopping\n");
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (ptr < endPtr)
+	{
+		printf("truncated log file\n");
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -1,5 +1,9 @@
 #include "Model.h"
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
@@ -11,12 +15,45 @@
 #include "core/CLog.h"
 #include "core/ResourceManager.h"
 #include "Vertex.h"
-#include "../../../render/sources/render/VulkanRenderer/VulkanRenderer.h"
 #include "core/PoolAllocator.h"
 
 
 namespace Model
 {
+	namespace
+	{
+		// scenes read by Import, waiting for their constructor : null while being read
+		std::mutex importsMutex;
+		std::unordered_map<std::string, std::unique_ptr<Assimp::Importer>> imports;
+	}
+
+	void Model::Import(const std::string& path)
+	{
+		if (ResourceManager::GetResource<Model>(path) != nullptr)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(importsMutex);
+			if (imports.try_emplace(path).second == false)
+				return; // another component uses the same model
+		}
+
+		auto importer = std::make_unique<Assimp::Importer>();
+		ReadScene(*importer, path);
+
+		std::lock_guard<std::mutex> lock(importsMutex);
+		imports[path] = std::move(importer);
+	}
+
+	void Model::ReadScene(Assimp::Importer& importer, const std::string& path)
+	{
+#ifdef _DEBUG
+		importer.ReadFile(path, aiProcess_Triangulate | aiProcess_MakeLeftHanded/* | aiProcess_FlipWindingOrder*/);
+#else
+		importer.ReadFile(path, aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_MakeLeftHanded);
+#endif
+	}
+
 	Model::Model(const char* path)
 	{
 		if (ResourceManager::GetResource<Model>(path) != nullptr)
@@ -48,19 +85,27 @@ namespace Model
 
 	void Model::LoadModel(const std::string& path)
 	{
-		Assimp::Importer import;
+		std::unique_ptr<Assimp::Importer> import;
+		{
+			std::lock_guard<std::mutex> lock(importsMutex);
+			const auto it = imports.find(path);
+			if (it != imports.end())
+			{
+				import = std::move(it->second);
+				imports.erase(it);
+			}
+		}
 
-#ifdef _DEBUG
-		const aiScene* scene = import.ReadFile(
-			path, aiProcess_Triangulate | aiProcess_MakeLeftHanded/* | aiProcess_FlipWindingOrder*/);
-#else
-		const aiScene* scene = import.ReadFile(
-			path, aiProcessPreset_TargetRealtime_MaxQuality | aiProcess_MakeLeftHanded);
-#endif
+		if (!import)
+		{
+			import = std::make_unique<Assimp::Importer>();
+			ReadScene(*import, path);
+		}
 
+		const aiScene* scene = import->GetScene();
 		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
 		{
-			LOG(LOG_ERROR, "Object " + path + " could not be imported: " + import.GetErrorString());
+			LOG(LOG_ERROR, "Object " + path + " could not be imported: " + import->GetErrorString());
 			return;
 		}
 
@@ -160,7 +205,7 @@ namespace Model
 		{
 			material->GetTexture(aiTextureType_AMBIENT, 0, &str);
 			path += str.C_Str();
-			Render::VulkanRenderer::AddVulkanTextureToMaterial(matName, path, MaterialTextureLocation::AMBIENT);
+			onMaterialTextureImport.Broadcast(matName, path, MaterialTextureLocation::AMBIENT);
 		}
 
 		path = directory + "/";
@@ -169,7 +214,7 @@ namespace Model
 		{
 			material->GetTexture(aiTextureType_DIFFUSE, 0, &str);
 			path += str.C_Str();
-			Render::VulkanRenderer::AddVulkanTextureToMaterial(matName, path, MaterialTextureLocation::DIFFUSE);
+			onMaterialTextureImport.Broadcast(matName, path, MaterialTextureLocation::DIFFUSE);
 		}
 
 		path = directory + "/";
@@ -178,7 +223,7 @@ namespace Model
 		{
 			material->GetTexture(aiTextureType_SPECULAR, 0, &str);
 			path += str.C_Str();
-			Render::VulkanRenderer::AddVulkanTextureToMaterial(matName, path, MaterialTextureLocation::SPECULAR);
+			onMaterialTextureImport.Broadcast(matName, path, MaterialTextureLocation::SPECULAR);
 		}
 
 		path = directory + "/";
@@ -187,7 +232,7 @@ namespace Model
 		{
 			material->GetTexture(aiTextureType_OPACITY, 0, &str);
 			path += str.C_Str();
-			Render::VulkanRenderer::AddVulkanTextureToMaterial(matName, path, MaterialTextureLocation::ALPHA);
+			onMaterialTextureImport.Broadcast(matName, path, MaterialTextureLocation::ALPHA);
 		}
 
 		// Colors
@@ -197,23 +242,23 @@ namespace Model
 
 		material->Get(AI_MATKEY_COLOR_AMBIENT, color);
 		value = LibMath::Vector3(color.r, color.g, color.b);
-		Render::VulkanRenderer::AddValuesToMaterial(matName, value, MaterialValueLocation::AMBIENT_COLOR);
+		onMaterialValueImport.Broadcast(matName, value, MaterialValueLocation::AMBIENT_COLOR);
 
 		material->Get(AI_MATKEY_COLOR_DIFFUSE, color);
 		value = LibMath::Vector3(color.r, color.g, color.b);
-		Render::VulkanRenderer::AddValuesToMaterial(matName, value, MaterialValueLocation::DIFFUSE_COLOR);
+		onMaterialValueImport.Broadcast(matName, value, MaterialValueLocation::DIFFUSE_COLOR);
 
 		material->Get(AI_MATKEY_COLOR_SPECULAR, color);
 		value = LibMath::Vector3(color.r, color.g, color.b);
-		Render::VulkanRenderer::AddValuesToMaterial(matName, value, MaterialValueLocation::SPECUALR_COLOR);
+		onMaterialValueImport.Broadcast(matName, value, MaterialValueLocation::SPECUALR_COLOR);
 
 		material->Get(AI_MATKEY_SHININESS, fValue);
 		value = LibMath::Vector3(fValue);
-		Render::VulkanRenderer::AddValuesToMaterial(matName, value, MaterialValueLocation::SPECULAR_EXPONENT);
+		onMaterialValueImport.Broadcast(matName, value, MaterialValueLocation::SPECULAR_EXPONENT);
 
 		material->Get(AI_MATKEY_OPACITY, fValue);
 		value = LibMath::Vector3(fValue);
-		Render::VulkanRenderer::AddValuesToMaterial(matName, value, MaterialValueLocation::ALPHA);
+		onMaterialValueImport.Broadcast(matName, value, MaterialValueLocation::ALPHA);
 
 		return matName;
 	}
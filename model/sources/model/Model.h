@@ -7,6 +7,11 @@
 
 #include "core/Delegate.h"
 
+namespace Assimp
+{
+	class Importer;
+}
+
 struct aiMaterial;
 struct aiMesh;
 struct aiScene;
@@ -50,11 +55,21 @@ namespace Model
 		{
 		}
 
+		// reads the file of a model not loaded yet, from any thread : the constructor only processes the scene then.
+		// The scene processing stays on the render thread, it creates the textures of the materials.
+		static void Import(const std::string& path);
+
+		// the materials found while processing a scene, the renderer listens : model does not depend on render
+		inline static OnMaterialTextureImport onMaterialTextureImport;
+		inline static OnMaterialValueImport onMaterialValueImport;
+
 		std::vector<Mesh> meshes;
 
 	private:
 		std::string directory;
 
+		static void ReadScene(Assimp::Importer& importer, const std::string& path);
+
 		void LoadModel(const std::string& path);
 		void ProcessNode(aiNode* node, const aiScene* scene);
 		Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene);
@@ -1,6 +1,12 @@
 set(SOURCE_FILES
+sources/physic/CookedMeshCache.cpp
+sources/physic/CookedMeshCache.h
 sources/physic/ErrorCallback.cpp
 sources/physic/ErrorCallback.h
+sources/physic/JobDispatcher.cpp
+sources/physic/JobDispatcher.h
+sources/physic/PhysicsConfig.cpp
+sources/physic/PhysicsConfig.h
 sources/physic/PhysicsInstance.cpp
 sources/physic/PhysicsInstance.doc.h
 sources/physic/PhysicsInstance.h
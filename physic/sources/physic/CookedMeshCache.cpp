@@ -0,0 +1,162 @@
+#include "CookedMeshCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "core/CLog.h"
+#include "model/Vertex.h"
+
+using namespace physx;
+
+namespace Physics
+{
+    namespace
+    {
+        constexpr char MAGIC[4] = {'C', 'E', 'C', 'M'};
+        constexpr uint32_t VERSION = 1;
+        constexpr const char* COOKED_MESH_DIRECTORY = "cache/physics/";
+
+        constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+        constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+        struct Header
+        {
+            char magic[4];
+            uint32_t version;
+            uint64_t key;
+            uint32_t size; // of the cooked data
+        };
+
+        void HashBytes(uint64_t& hash, const void* data, const size_t size)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= FNV_PRIME;
+            }
+        }
+
+        template <typename T>
+        void HashValue(uint64_t& hash, const T value)
+        {
+            HashBytes(hash, &value, sizeof(value));
+        }
+    }
+
+    uint64_t CookedMeshCache::ComputeKey(const EMeshType type, const std::vector<Model::Vertex>& vertices,
+                                         const std::vector<unsigned int>& indices, const PxCookingParams& params)
+    {
+        uint64_t hash = FNV_OFFSET;
+
+        // cooked data only loads in the PhysX version that cooked it
+        HashValue(hash, static_cast<uint32_t>(PX_PHYSICS_VERSION));
+        HashValue(hash, type);
+
+        // field by field, the padding of the structure is not deterministic
+        HashValue(hash, params.areaTestEpsilon);
+        HashValue(hash, params.planeTolerance);
+        HashValue(hash, params.convexMeshCookingType);
+        HashValue(hash, params.suppressTriangleMeshRemapTable);
+        HashValue(hash, params.buildTriangleAdjacencies);
+        HashValue(hash, params.buildGPUData);
+        HashValue(hash, params.scale.length);
+        HashValue(hash, params.scale.speed);
+        HashValue(hash, static_cast<uint32_t>(params.meshPreprocessParams));
+        HashValue(hash, params.meshWeldTolerance);
+        HashValue(hash, params.midphaseDesc.getType());
+        HashValue(hash, params.gaussMapLimit);
+
+        // the cooking only reads the positions
+        HashValue(hash, vertices.size());
+        for (const Model::Vertex& vertex : vertices)
+        {
+            HashBytes(hash, &vertex.position, sizeof(vertex.position));
+        }
+
+        HashValue(hash, indices.size());
+        HashBytes(hash, indices.data(), indices.size() * sizeof(unsigned int));
+
+        return hash;
+    }
+
+    PxConvexMesh* CookedMeshCache::FindConvexMesh(const uint64_t key) const
+    {
+        const auto it = convexMeshes.find(key);
+        return it != convexMeshes.end() ? it->second : nullptr;
+    }
+
+    PxTriangleMesh* CookedMeshCache::FindTriangleMesh(const uint64_t key) const
+    {
+        const auto it = triangleMeshes.find(key);
+        return it != triangleMeshes.end() ? it->second : nullptr;
+    }
+
+    bool CookedMeshCache::LoadCookedData(const uint64_t key, std::vector<unsigned char>& data) const
+    {
+        std::ifstream file(GetFilePath(key), std::ios::in | std::ios::binary);
+        if (file.is_open() == false)
+        {
+            return false;
+        }
+
+        Header header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (file.good() == false || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+            || header.key != key)
+        {
+            return false;
+        }
+
+        data.resize(header.size);
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return file.gcount() == static_cast<std::streamsize>(data.size());
+    }
+
+    void CookedMeshCache::SaveCookedData(const uint64_t key, const void* data, const uint32_t size) const
+    {
+        std::error_code error;
+        std::filesystem::create_directories(COOKED_MESH_DIRECTORY, error);
+
+        const std::string path = GetFilePath(key);
+        std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (file.is_open() == false)
+        {
+            LOGF(LOG_WARNING, Core::ELogChannel::CLOG_PHYSICS, "Could not write the cooked mesh %s", path);
+            return;
+        }
+
+        Header header{};
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.key = key;
+        header.size = size;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(static_cast<const char*>(data), size);
+    }
+
+    void CookedMeshCache::Release()
+    {
+        for (const auto& [key, mesh] : convexMeshes)
+        {
+            mesh->release();
+        }
+        convexMeshes.clear();
+
+        for (const auto& [key, mesh] : triangleMeshes)
+        {
+            mesh->release();
+        }
+        triangleMeshes.clear();
+    }
+
+    std::string CookedMeshCache::GetFilePath(const uint64_t key)
+    {
+        char fileName[32];
+        snprintf(fileName, sizeof(fileName), "%016llx.cooked", static_cast<unsigned long long>(key));
+        return COOKED_MESH_DIRECTORY + std::string(fileName);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PxPhysicsAPI.h"
+
+namespace Model
+{
+    struct Vertex;
+}
+
+namespace Physics
+{
+    // Cooked collision meshes shared by every actor made from the same geometry. Keyed by a hash of the positions,
+    // the indices and the cooking parameters : the meshes are reused for the session, their cooked data across runs.
+    class CookedMeshCache
+    {
+    public:
+        enum class EMeshType : uint32_t
+        {
+            CONVEX,
+            TRIANGLE
+        };
+
+        CookedMeshCache() = default;
+        CookedMeshCache(const CookedMeshCache&) = delete;
+        CookedMeshCache(CookedMeshCache&&) = delete;
+        ~CookedMeshCache() = default;
+
+        CookedMeshCache& operator=(const CookedMeshCache&) = delete;
+        CookedMeshCache& operator=(CookedMeshCache&&) = delete;
+
+        [[nodiscard]] static uint64_t ComputeKey(EMeshType type, const std::vector<Model::Vertex>& vertices,
+                                                 const std::vector<unsigned int>& indices,
+                                                 const physx::PxCookingParams& params);
+
+        [[nodiscard]] physx::PxConvexMesh* FindConvexMesh(uint64_t key) const;
+        [[nodiscard]] physx::PxTriangleMesh* FindTriangleMesh(uint64_t key) const;
+        void Add(uint64_t key, physx::PxConvexMesh* mesh) { convexMeshes[key] = mesh; }
+        void Add(uint64_t key, physx::PxTriangleMesh* mesh) { triangleMeshes[key] = mesh; }
+
+        // the data cooked by a previous run, false when there is none
+        bool LoadCookedData(uint64_t key, std::vector<unsigned char>& data) const;
+        void SaveCookedData(uint64_t key, const void* data, uint32_t size) const;
+
+        // drops the references held by the cache, the meshes still used by shapes are released with them
+        void Release();
+
+    private:
+        [[nodiscard]] static std::string GetFilePath(uint64_t key);
+
+        std::unordered_map<uint64_t, physx::PxConvexMesh*> convexMeshes;
+        std::unordered_map<uint64_t, physx::PxTriangleMesh*> triangleMeshes;
+    };
+}
@@ -5,7 +5,7 @@ using namespace physx;
 
 namespace Physics
 {
-    void ErrorCallback::reportError(const PxErrorCode::Enum code, const char* message, const char*, const int)
+    void ErrorCallback::reportError(const PxErrorCode::Enum code, const char* message, const char* file, const int line)
     {
         if (code == PxErrorCode::eNO_ERROR)
             return;
@@ -17,11 +17,11 @@ namespace Physics
         }
         else if(code == PxErrorCode::eDEBUG_WARNING || code == PxErrorCode::ePERF_WARNING)
         {
-            LOG(LOG_WARNING, message, Core::ELogChannel::CLOG_PHYSICS);
+            LOGF(LOG_WARNING, Core::ELogChannel::CLOG_PHYSICS, "%s (%s:%d)", message, file, line);
         }
         else if(code == PxErrorCode::eDEBUG_INFO)
         {
-            LOG(LOG_INFO, message, Core::ELogChannel::CLOG_PHYSICS);
+            LOGF(LOG_INFO, Core::ELogChannel::CLOG_PHYSICS, "%s (%s:%d)", message, file, line);
         }
     }
 }
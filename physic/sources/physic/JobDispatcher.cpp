@@ -0,0 +1,23 @@
+#include "JobDispatcher.h"
+
+#include "core/ThreadPool.h"
+
+using namespace physx;
+
+namespace Physics
+{
+    void JobDispatcher::submitTask(PxBaseTask& task)
+    {
+        // urgent : the main thread waits in fetchResults, it would otherwise wait behind asset loads
+        pool.AddJob([&task]
+        {
+            task.run();
+            task.release(); // schedules the tasks depending on this one
+        }, true);
+    }
+
+    uint32_t JobDispatcher::getWorkerCount() const
+    {
+        return static_cast<uint32_t>(pool.GetSize());
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "PxPhysicsAPI.h"
+
+namespace Core
+{
+    class ThreadPool;
+}
+
+namespace Physics
+{
+    // Runs the PhysX tasks on the engine thread pool rather than on threads of its own,
+    // so the simulation and the engine jobs share the cores instead of oversubscribing them
+    class JobDispatcher final : public physx::PxCpuDispatcher
+    {
+    public:
+        explicit JobDispatcher(Core::ThreadPool& pool) : pool(pool) {}
+
+        void submitTask(physx::PxBaseTask& task) override;
+        uint32_t getWorkerCount() const override;
+
+    private:
+        Core::ThreadPool& pool;
+    };
+}
@@ -0,0 +1,16 @@
+#include "PhysicsConfig.h"
+
+PhysicsConfig::PhysicsConfig() :
+    gravityX(0.f),
+    gravityY(-9.81f),
+    gravityZ(0.f)
+{
+}
+
+VehicleConfig::VehicleConfig() :
+    enginePeakTorque(500.f),
+    engineMaxOmega(600.f), // approx 6000 rpm
+    gearSwitchTime(0.5f),
+    clutchStrength(10.f)
+{
+}
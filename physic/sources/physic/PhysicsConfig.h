@@ -0,0 +1,27 @@
+#pragma once
+#include "core/reflection/StructMeta.h"
+
+// read from config/physics.txt, re-applied by PhysicsInstance when the file changes
+STRUCT(PhysicsConfig,
+    FIELD(float, gravityX),
+    FIELD(float, gravityY),
+    FIELD(float, gravityZ),
+    SUPPLEMENT(
+        EMPTY(),
+        PhysicsConfig();,
+        EMPTY()
+    )
+);
+
+// read from config/vehicle.txt, re-applied to every registered vehicle by PhysicsVehicle when the file changes
+STRUCT(VehicleConfig,
+    FIELD(float, enginePeakTorque),
+    FIELD(float, engineMaxOmega),
+    FIELD(float, gearSwitchTime),
+    FIELD(float, clutchStrength),
+    SUPPLEMENT(
+        EMPTY(),
+        VehicleConfig();,
+        EMPTY()
+    )
+);
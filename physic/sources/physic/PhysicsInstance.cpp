@@ -1,10 +1,15 @@
 #include "PhysicsInstance.h"
 
+#include <algorithm>
+
 #include "PhysicsRigidActor.h"
 #include <core/CLog.h>
 #include <Matrix/Matrix4.h>
 #include <model/Vertex.h>
 #include "core/ECS/Entity.h"
+#include "core/ThreadPool.h"
+#include "core/ECS/Event.h"
+#include "core/filesys/Config.h"
 #include "core/scenegraph/SceneNode.h"
 
 #include "ErrorCallback.h"
@@ -19,6 +24,24 @@ static Physics::SimulationEventCallback g_DefaultEventCallback;
 
 Physics::PhysicsInstance Physics::PhysicsInstance::physicsInstance;
 
+namespace
+{
+	struct ActorPose
+	{
+		Core::SceneNode* anchor;
+		LibMath::Vector3 position; // of the anchor, the local offset of the actor removed
+		LibMath::Quaternion rotation;
+	};
+
+	constexpr size_t POSE_BATCH_SIZE = 256;
+	constexpr const char* PHYSICS_CONFIG_PATH = "config/physics.txt";
+
+	// kept from one step to the next for its capacity
+	std::vector<ActorPose> g_ActivePoses;
+	std::vector<std::pair<size_t, const ActorPose*>> g_NestedPoses; // depth in the scene graph, pose
+	std::vector<Physics::PhysicsRigidActor*> g_ActiveVehicles;
+}
+
 namespace Physics
 {
 
@@ -28,9 +51,12 @@ namespace Physics
 		{
 			LOG(LOG_INFO, "Destroying physics.", Core::ELogChannel::CLOG_PHYSICS);
 
+			EndAdvance();
 			PxCloseVehicleSDK();
 			pvd->disconnect();
 			scene->release();
+			meshCache.Release();
+			delete dispatcher;
 			physics->release();
 
 			LOG(LOG_INFO, "Physics destroyed.", Core::ELogChannel::CLOG_PHYSICS);
@@ -63,7 +89,7 @@ namespace Physics
 		cooking = PxCreateCooking(PX_PHYSICS_VERSION, *foundation, cookingParams);
 		ASSERT(cooking != nullptr, "PxCreateCooking failed!", Core::ELogChannel::CLOG_PHYSICS);
 
-		dispatcher = PxDefaultCpuDispatcherCreate(nbThreads);
+		dispatcher = new JobDispatcher(Core::ThreadPool::GetDefaultThreadPool());
 
 		CreateScene();
 
@@ -71,21 +97,85 @@ namespace Physics
 
 		PhysicsVehicle::InitVehicles(&g_DefaultAllocatorCallback);
 
+		// not unwatched : the instance lives until the static destruction, where Config may already be gone
+		Core::Config::Watch(PHYSICS_CONFIG_PATH, config, &PhysicsInstance::ApplyConfig);
+		ApplyConfig();
+
+		Core::EventBus::Subscribe<ContactEvent>(&SimulationEventCallback::BroadcastContact);
+
 		LOG(LOG_INFO, "Successfully created physics.", Core::ELogChannel::CLOG_PHYSICS);
 	}
 
 	void PhysicsInstance::Advance(const float delta)
 	{
+		BeginAdvance(delta);
+		EndAdvance();
+	}
+
+	void PhysicsInstance::BeginAdvance(const float delta)
+	{
+		EndAdvance(); // one step in flight at most
+
 		PhysicsVehicle::UpdateVehicles(delta);
 
 		physicsInstance.scene->simulate(delta);
+		physicsInstance.isSimulating = true;
+	}
+
+	void PhysicsInstance::EndAdvance()
+	{
+		if (physicsInstance.isSimulating == false)
+		{
+			return;
+		}
+
 		physicsInstance.scene->fetchResults(true);
+		physicsInstance.isSimulating = false;
+
+		// before moving the entities, so an actor moved by gameplay during the step moves its entity too
+		for (const std::function<void()>& write : physicsInstance.pendingWrites)
+		{
+			write();
+		}
+		physicsInstance.pendingWrites.clear();
 
 		NotifyActiveActors();
 	}
 
+	void PhysicsInstance::Write(std::function<void()> write)
+	{
+		if (physicsInstance.isSimulating)
+		{
+			physicsInstance.pendingWrites.push_back(std::move(write));
+		}
+		else
+		{
+			write();
+		}
+	}
+
+	void PhysicsInstance::AddActor(PxActor& actor)
+	{
+		Write([&actor] { physicsInstance.scene->addActor(actor); });
+	}
+
+	void PhysicsInstance::ReleaseActor(PxRigidActor* actor)
+	{
+		// the step in flight may still report contacts of the actor, they are ignored without user data
+		actor->userData = nullptr;
+		SimulationEventCallback::DiscardContacts(actor);
+
+		Write([actor]
+		{
+			SimulationEventCallback::DiscardContacts(actor); // reported by the step that just ended
+			actor->release();
+		});
+	}
+
 	void PhysicsInstance::ClearScene()
 	{
+		EndAdvance();
+		SimulationEventCallback::DiscardAllContacts();
 		physicsInstance.scene->release();
 
 		physicsInstance.CreateScene();
@@ -94,7 +184,13 @@ namespace Physics
 	void PhysicsInstance::SetDefaultGravity(const PxVec3& gravity)
 	{
 		physicsInstance.defaultGravity = gravity;
-		physicsInstance.scene->setGravity(gravity);
+		Write([gravity] { physicsInstance.scene->setGravity(gravity); });
+	}
+
+	void PhysicsInstance::ApplyConfig()
+	{
+		const PhysicsConfig& config = physicsInstance.config;
+		SetDefaultGravity({config.gravityX, config.gravityY, config.gravityZ});
 	}
 
 	void PhysicsInstance::CreateRigidDynamic(PhysicsRigidDynamic* rigidDynamic, const PxTransform& transform,
@@ -104,7 +200,7 @@ namespace Physics
 		PxRigidDynamic* dynamic = PxCreateDynamic(*physics, transform, geometry, material, density);
 		dynamic->setAngularDamping(angularDamping);
 		dynamic->setLinearVelocity({velocity.x, velocity.y, velocity.z});
-		scene->addActor(*dynamic);
+		AddActor(*dynamic);
 
 		rigidDynamic->rigidDynamic = dynamic;
 		rigidDynamic->rigidDynamic->userData = rigidDynamic;
@@ -130,7 +226,7 @@ namespace Physics
 
 		capsuleDynamic->setMassSpaceInertiaTensor(PxVec3(0.f, 1000.f, 0.f));
 
-		scene->addActor(*capsuleDynamic);
+		AddActor(*capsuleDynamic);
 
 		rigidDynamic->rigidDynamic = capsuleDynamic;
 		rigidDynamic->rigidDynamic->userData = rigidDynamic;
@@ -144,7 +240,7 @@ namespace Physics
 	                                        PxMaterial& material) const
 	{
 		PxRigidStatic* rigidStaticPhysX = PxCreateStatic(*physics, transform, geometry, material);
-		scene->addActor(*rigidStaticPhysX);
+		AddActor(*rigidStaticPhysX);
 
 		SetRigidStaticUserData(rigidStatic, rigidStaticPhysX);
 		rigidStatic->geometryType = geometryType;
@@ -159,14 +255,14 @@ namespace Physics
 
 		MakeActorShapesDrivable(physicsInstance.plane);
 
-		physicsInstance.scene->addActor(*physicsInstance.plane);
+		AddActor(*physicsInstance.plane);
     }
 
     void PhysicsInstance::DestroyPlane()
     {
 		if(physicsInstance.plane != nullptr)
 		{
-			physicsInstance.plane->release();
+			ReleaseActor(physicsInstance.plane);
 			physicsInstance.plane = nullptr;
 		}
     }
@@ -219,15 +315,86 @@ namespace Physics
 		PxU32 nbActiveActors;
 		auto* const activeActors = physicsInstance.scene->getActiveActors(nbActiveActors);
 
+		g_ActivePoses.clear();
+		g_ActiveVehicles.clear();
+
+		// gather : the poses in one array, the parents cleaned once so the writes below only read them
+		const Core::SceneNode* cleanParent = nullptr;
+		bool hasNestedAnchors = false;
+
 		for (PxU32 i = 0; i < nbActiveActors; ++i)
 		{
 			auto* actor = static_cast<PhysicsRigidActor*>(activeActors[i]->userData);
 
-			if(actor->IsCanChangeEntityTransform())
+			if (actor == nullptr || actor->IsCanChangeEntityTransform() == false)
+			{
+				continue;
+			}
+
+			if (actor->GetGeometryType() == EGeometryType::VEHICLE)
+			{
+				g_ActiveVehicles.push_back(actor); // the vehicle components also move their wheels
+				continue;
+			}
+
+			Core::SceneNode* anchor = Core::Entity::GetEntity(actor->GetPhysicsEntityHandle())->GetAnchor();
+			if (anchor->GetParent() != cleanParent)
+			{
+				cleanParent = anchor->GetParent();
+				(void)anchor->GetParent()->GetWorldTransformCheck();
+			}
+			hasNestedAnchors |= anchor->GetChildrenCount() > 0;
+
+			const PxTransform pose = static_cast<PxRigidActor*>(activeActors[i])->getGlobalPose();
+			g_ActivePoses.push_back({anchor, Vec3Convert(pose.p) - actor->GetLocalLocation(), QuaternionConvert(pose.q)});
+		}
+
+		// write back : every anchor written once, in parallel
+		Core::ThreadPool::GetDefaultThreadPool().ParallelFor(g_ActivePoses.size(), POSE_BATCH_SIZE,
+		                                                [](const size_t begin, const size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				g_ActivePoses[i].anchor->SetWorldPositionAndRotationNoCheck(g_ActivePoses[i].position,
+				                                                            g_ActivePoses[i].rotation);
+			}
+		});
+
+		if (hasNestedAnchors)
+		{
+			// an anchor below another moved anchor was written against the old world transform of its ancestor.
+			// Rewriting one cleans its ancestors : every such anchor is found first, then rewritten from the root down.
+			g_NestedPoses.clear();
+			for (const ActorPose& actorPose : g_ActivePoses)
+			{
+				size_t depth = 0;
+				bool hasMovedAncestor = false;
+				for (const Core::SceneNode* ancestor = actorPose.anchor->GetParent(); ancestor; ancestor = ancestor->GetParent())
+				{
+					hasMovedAncestor |= ancestor->IsWorldTransformDirty();
+					depth++;
+				}
+
+				if (hasMovedAncestor)
+				{
+					g_NestedPoses.emplace_back(depth, &actorPose);
+				}
+			}
+
+			std::stable_sort(g_NestedPoses.begin(), g_NestedPoses.end(),
+			                 [](const auto& a, const auto& b) { return a.first < b.first; });
+
+			for (const auto& [depth, actorPose] : g_NestedPoses)
 			{
-				actor->UpdatePhysicsRender();
+				actorPose->anchor->SetWorldPosition(actorPose->position);
+				actorPose->anchor->SetWorldRotation(actorPose->rotation);
 			}
 		}
+
+		for (PhysicsRigidActor* vehicle : g_ActiveVehicles)
+		{
+			vehicle->UpdatePhysicsRender();
+		}
 	}
 
     void PhysicsInstance::MakeActorShapesDrivable(PxRigidActor* actor)
@@ -295,23 +462,51 @@ namespace Physics
 	{
 		const size_t verticesNumber = vertices.size();
 
-		PxConvexMeshDesc convexDesc;
-		convexDesc.points.count = static_cast<PxU32>(verticesNumber);
-		convexDesc.points.stride = sizeof(Model::Vertex);
-		convexDesc.points.data = &vertices[0];
-		convexDesc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
+		CookedMeshCache& meshCache = physicsInstance.meshCache;
+		const uint64_t key = CookedMeshCache::ComputeKey(CookedMeshCache::EMeshType::CONVEX, vertices, {},
+		                                                 physicsInstance.cooking->getParams());
+
+		if (PxConvexMesh* cachedMesh = meshCache.FindConvexMesh(key))
+		{
+			return cachedMesh;
+		}
 
-		PxDefaultMemoryOutputStream buf;
-		PxConvexMeshCookingResult::Enum result;
+		PxConvexMesh* convexMesh = nullptr;
 
-		if (!physicsInstance.cooking->cookConvexMesh(convexDesc, buf, &result))
+		std::vector<unsigned char> cookedData;
+		if (meshCache.LoadCookedData(key, cookedData))
 		{
-			LOG(LOG_WARNING, "Failed to create Convex Mesh from vertices.", Core::ELogChannel::CLOG_PHYSICS);
-			return nullptr;
+			PxDefaultMemoryInputData input(cookedData.data(), static_cast<PxU32>(cookedData.size()));
+			convexMesh = physicsInstance.physics->createConvexMesh(input); // null when the file is damaged, cooked again
 		}
 
-		PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
-		PxConvexMesh* convexMesh = physicsInstance.physics->createConvexMesh(input);
+		if (convexMesh == nullptr)
+		{
+			PxConvexMeshDesc convexDesc;
+			convexDesc.points.count = static_cast<PxU32>(verticesNumber);
+			convexDesc.points.stride = sizeof(Model::Vertex);
+			convexDesc.points.data = &vertices[0];
+			convexDesc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
+
+			PxDefaultMemoryOutputStream buf;
+			PxConvexMeshCookingResult::Enum result;
+
+			if (!physicsInstance.cooking->cookConvexMesh(convexDesc, buf, &result))
+			{
+				LOG(LOG_WARNING, "Failed to create Convex Mesh from vertices.", Core::ELogChannel::CLOG_PHYSICS);
+				return nullptr;
+			}
+
+			meshCache.SaveCookedData(key, buf.getData(), buf.getSize());
+
+			PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+			convexMesh = physicsInstance.physics->createConvexMesh(input);
+		}
+
+		if (convexMesh)
+		{
+			meshCache.Add(key, convexMesh);
+		}
 
 		return convexMesh;
 	}
@@ -331,24 +526,59 @@ namespace Physics
 
 		physicsInstance.cooking->setParams(params);
 
-		PxTriangleMeshDesc meshDesc;
-		meshDesc.points.count = static_cast<PxU32>(verticesNumber);
-		meshDesc.points.stride = sizeof(Model::Vertex);
-		meshDesc.points.data = &vertices[0];
+		CookedMeshCache& meshCache = physicsInstance.meshCache;
+		const uint64_t key = CookedMeshCache::ComputeKey(CookedMeshCache::EMeshType::TRIANGLE, vertices, indices, params);
 
-		meshDesc.triangles.count = static_cast<PxU32>(indicesNumber / 3);
-		meshDesc.triangles.stride = 3 * sizeof(unsigned);
-		meshDesc.triangles.data = &indices[0];
+		if (PxTriangleMesh* cachedMesh = meshCache.FindTriangleMesh(key))
+		{
+			return cachedMesh;
+		}
+
+		PxTriangleMesh* triangleMesh = nullptr;
+
+		std::vector<unsigned char> cookedData;
+		if (meshCache.LoadCookedData(key, cookedData))
+		{
+			PxDefaultMemoryInputData input(cookedData.data(), static_cast<PxU32>(cookedData.size()));
+			triangleMesh = physicsInstance.physics->createTriangleMesh(input);
+		}
 
-		if(meshDesc.isValid())
+		if (triangleMesh == nullptr)
 		{
-			PxTriangleMesh* aTriangleMesh = physicsInstance.cooking->createTriangleMesh(meshDesc,
-				physicsInstance.physics->getPhysicsInsertionCallback());
+			PxTriangleMeshDesc meshDesc;
+			meshDesc.points.count = static_cast<PxU32>(verticesNumber);
+			meshDesc.points.stride = sizeof(Model::Vertex);
+			meshDesc.points.data = &vertices[0];
 
-			return aTriangleMesh;
+			meshDesc.triangles.count = static_cast<PxU32>(indicesNumber / 3);
+			meshDesc.triangles.stride = 3 * sizeof(unsigned);
+			meshDesc.triangles.data = &indices[0];
+
+			if (meshDesc.isValid() == false)
+			{
+				return nullptr;
+			}
+
+			// cooked to a stream rather than inserted directly, so the data can be kept for the next runs
+			PxDefaultMemoryOutputStream buf;
+			if (!physicsInstance.cooking->cookTriangleMesh(meshDesc, buf))
+			{
+				LOG(LOG_WARNING, "Failed to create Triangle Mesh from vertices.", Core::ELogChannel::CLOG_PHYSICS);
+				return nullptr;
+			}
+
+			meshCache.SaveCookedData(key, buf.getData(), buf.getSize());
+
+			PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+			triangleMesh = physicsInstance.physics->createTriangleMesh(input);
+		}
+
+		if (triangleMesh)
+		{
+			meshCache.Add(key, triangleMesh);
 		}
 
-		return nullptr;
+		return triangleMesh;
 	}
 
 	PxTransform PhysicsInstance::TransformFromLocationAndRotation(const LibMath::Vector3& location,
@@ -1,11 +1,15 @@
 #pragma once
 #include "physic_export.h"
 
+#include <functional>
 #include <vector>
 
 #define PX_FOUNDATION_DLL 0
 #include "PxPhysicsAPI.h"
 #include "Vector/Vector3.h"
+#include "CookedMeshCache.h"
+#include "JobDispatcher.h"
+#include "PhysicsConfig.h"
 
 namespace Core
 {
@@ -54,6 +58,49 @@ namespace Physics
 		 */
 		static void Advance(float delta);
 
+		/**
+		 * Starts simulating the given amount of time on the worker threads and returns at once.
+		 * Until EndAdvance, the reads return the results of the previous step and the writes go through Write.
+		 * 
+		 * @param delta Amount of time to simulate.
+		 */
+		static void BeginAdvance(float delta);
+
+		/**
+		 * Waits for the step started by BeginAdvance, applies the writes made meanwhile and moves the entities.
+		 * Does nothing when no step is in flight.
+		 */
+		static void EndAdvance();
+
+		/**
+		 * Indicates if a step started by BeginAdvance is in flight.
+		 * 
+		 * @return True between BeginAdvance and EndAdvance.
+		 */
+		static bool IsSimulating() { return physicsInstance.isSimulating; }
+
+		/**
+		 * Applies a write to the scene or its actors now, or once the results are fetched when a step is in flight.
+		 * The writes are applied in call order and override the results of the step, as if made after it.
+		 * 
+		 * @param write Function writing to the scene.
+		 */
+		static void Write(std::function<void()> write);
+
+		/**
+		 * Adds the actor to the current scene, see Write.
+		 * 
+		 * @param actor Actor to add.
+		 */
+		static void AddActor(physx::PxActor& actor);
+
+		/**
+		 * Releases the actor and discards its pending contacts, see Write. The actor user data is cleared at once.
+		 * 
+		 * @param actor Actor to release.
+		 */
+		static void ReleaseActor(physx::PxRigidActor* actor);
+
 		/**
 		 * Completely clears the scene of all rigid actors and create a new one.
 		 */
@@ -66,6 +113,11 @@ namespace Physics
 		 */
 		static void SetDefaultGravity(const physx::PxVec3& gravity);
 
+		/**
+		 * Applies the values of config/physics.txt. Called on init and by Core::Config when the file changes.
+		 */
+		static void ApplyConfig();
+
 		/**
 		 * Creates a rigid dynamic corresponding to the given parameters.
 		 * 
@@ -112,9 +164,11 @@ namespace Physics
 
 		/**
 		 * Converts a vector of vertices to a physx readable convex mesh.
+		 * The mesh is cooked once per geometry : the same vertices give the same mesh, and the cooked data is reused
+		 * from the disk by the next runs.
 		 * 
 		 * @param vertices Vector of vertices.
-		 * @return physx convex mesh.
+		 * @return physx convex mesh, owned by the mesh cache.
 		 */
 		static physx::PxConvexMesh* ConvexMeshFromMesh(const std::vector<Model::Vertex>& vertices);
 
@@ -190,6 +244,8 @@ namespace Physics
 
 		/**
 		 * Notify all scene active actors to update their render transform.
+		 * The poses of the rigid dynamics are gathered in one array then written to their anchors in parallel,
+		 * the vehicles update through UpdatePhysicsRender.
 		 */
 		static void NotifyActiveActors();
 
@@ -200,13 +256,18 @@ namespace Physics
 		physx::PxPvdTransport* transport = nullptr;
 		physx::PxCooking* cooking = nullptr;
 		physx::PxScene* scene = nullptr;
-		physx::PxDefaultCpuDispatcher* dispatcher = nullptr;
+		JobDispatcher* dispatcher = nullptr;
+		CookedMeshCache meshCache;
 
 		/* constants */
 		physx::PxReal objectsAverageLength = 100;
 		physx::PxReal objectsAverageSpeed = 981;
 		physx::PxVec3 defaultGravity{0.0f, -9.81f, 0.0f};
-		int nbThreads = 2;
+		PhysicsConfig config; // watched, see ApplyConfig
+
+		/* step in flight */
+		bool isSimulating = false;
+		std::vector<std::function<void()>> pendingWrites;
 	};
 
 	/**
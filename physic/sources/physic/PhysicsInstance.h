@@ -1,11 +1,15 @@
 #pragma once
 #include "physic_export.h"
 
+#include <functional>
 #include <vector>
 
 #define PX_FOUNDATION_DLL 0
 #include "PxPhysicsAPI.h"
 #include "Vector/Vector3.h"
+#include "CookedMeshCache.h"
+#include "JobDispatcher.h"
+#include "PhysicsConfig.h"
 
 namespace Model
 {
@@ -36,11 +40,24 @@ namespace Physics
 
 		void Init();
 
-		static void Advance(float delta);
+		static void Advance(float delta); // simulates and waits for the results
+
+		// Advance in two halves : the step simulates on the workers until EndAdvance while the caller keeps working,
+		// reading the results of the previous step. PhysX refuses the writes in between, they go through Write.
+		static void BeginAdvance(float delta);
+		static void EndAdvance(); // waits for the step in flight, if any
+		static bool IsSimulating() { return physicsInstance.isSimulating; }
+
+		// now, or when a step is in flight once its results are fetched, in call order. The writes override the results
+		// of the step as if they were made after it.
+		static void Write(std::function<void()> write);
+		static void AddActor(physx::PxActor& actor);
+		static void ReleaseActor(physx::PxRigidActor* actor); // and its pending contacts
 
 		static void ClearScene();
 
 		static void SetDefaultGravity(const physx::PxVec3& gravity);
+		static void ApplyConfig(); // of config/physics.txt, on init and when the file changes
 
 		void CreateRigidDynamic(PhysicsRigidDynamic* rigidDynamic, const physx::PxTransform& transform,
 		                        const physx::PxGeometry& geometry,
@@ -62,6 +79,7 @@ namespace Physics
         static void	SetRigidStaticUserData(PhysicsRigidStatic* rigidStatic, physx::PxRigidStatic* staticActor);
 		static void	SetRigidDynamicUserData(PhysicsRigidDynamic* rigidDynamic, physx::PxRigidDynamic* dynamicActor);
 
+		// cooked once per geometry, the same mesh is returned for the same vertices and indices
 		static physx::PxConvexMesh* ConvexMeshFromMesh(const std::vector<Model::Vertex>& vertices);
 		static physx::PxTriangleMesh* TriangleMeshFromMesh(const std::vector<Model::Vertex>& vertices,
 		                                                    const std::vector<unsigned int>& indices);
@@ -102,15 +120,18 @@ namespace Physics
 		physx::PxPvdTransport* transport = nullptr;
 		physx::PxCooking* cooking = nullptr;
 		physx::PxScene* scene = nullptr;
-		physx::PxDefaultCpuDispatcher* dispatcher = nullptr;
+		JobDispatcher* dispatcher = nullptr; // on Core::ThreadPool::GetDefaultThreadPool(), sized from the hardware
+		CookedMeshCache meshCache;
 
 		physx::PxRigidStatic* plane = nullptr;
 
 		physx::PxReal objectsAverageLength = 100;
 		physx::PxReal objectsAverageSpeed = 981;
 		physx::PxVec3 defaultGravity{0.0f, -9.81f, 0.0f};
+		PhysicsConfig config;
 
-		int nbThreads = 2;
+		bool isSimulating = false;
+		std::vector<std::function<void()>> pendingWrites;
 	};
 
 	LibMath::Vector3 Vec3Convert(const physx::PxVec3& vec3);
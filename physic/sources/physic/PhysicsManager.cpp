@@ -11,6 +11,24 @@ using namespace physx;
 
 namespace Physics
 {
+	// copy of the debug lines of the last fetched step, PhysX refuses to read them while the next one simulates
+	static std::vector<DebugVertex> s_debugLines;
+
+	static void ReadDebugLines(std::vector<DebugVertex>& debugVertices)
+	{
+		const PxRenderBuffer& rb = PhysicsInstance::GetScene()->getRenderBuffer();
+
+		debugVertices.reserve(debugVertices.size() + rb.getNbLines() * 2);
+
+		for (PxU32 iLine = 0; iLine < rb.getNbLines(); iLine++)
+		{
+			const PxDebugLine& line = rb.getLines()[iLine];
+
+			debugVertices.emplace_back(Vec3Convert(line.pos0), line.color0);
+			debugVertices.emplace_back(Vec3Convert(line.pos1), line.color1);
+		}
+	}
+
 	DebugVertex::DebugVertex(const LibMath::Vector3& pos, const uint32_t col)
 		: position(pos)
 	{
@@ -65,6 +83,25 @@ namespace Physics
 		PhysicsInstance::Advance(delta);
 	}
 
+	void BeginAdvance(const float delta)
+	{
+		EndAdvance();
+		PhysicsInstance::BeginAdvance(delta);
+	}
+
+	void EndAdvance()
+	{
+		if (PhysicsInstance::IsSimulating() == false)
+		{
+			return;
+		}
+
+		PhysicsInstance::EndAdvance();
+
+		s_debugLines.clear();
+		ReadDebugLines(s_debugLines); // empty unless the debug visualization is on
+	}
+
 	void CreateConvexMeshRigidDynamic(PhysicsRigidDynamic* rigidDynamic, const Core::Entity* entity,
 	                                  const std::vector<Model::Vertex>& vertices, const float staticFriction,
 	                                  const float dynamicFriction, const float restitution,
@@ -249,7 +286,7 @@ namespace Physics
 					PxRigidActorExt::createExclusiveShape(*modelStatic, geometry, *material);
 				}
 			}
-			PhysicsInstance::GetScene()->addActor(*modelStatic);
+			PhysicsInstance::AddActor(*modelStatic);
 
 			PhysicsInstance::SetRigidDynamicUserData(rigidDynamic, modelStatic);
 			rigidDynamic->AttachToEntity();
@@ -290,7 +327,7 @@ namespace Physics
 					PxRigidActorExt::createExclusiveShape(*modelStatic, geometry, *material);
 				}
 			}
-			PhysicsInstance::GetScene()->addActor(*modelStatic);
+			PhysicsInstance::AddActor(*modelStatic);
 
 			PhysicsInstance::SetRigidStaticUserData(rigidStatic, modelStatic);
 
@@ -331,7 +368,7 @@ namespace Physics
 					PxRigidActorExt::createExclusiveShape(*modelStatic, geometry, *material);
 				}
 			}
-			PhysicsInstance::GetScene()->addActor(*modelStatic);
+			PhysicsInstance::AddActor(*modelStatic);
 
 			PhysicsInstance::SetRigidStaticUserData(rigidStatic, modelStatic);
 			rigidStatic->SetGeometryType(EGeometryType::TRIANGLE_MESH);
@@ -443,35 +480,34 @@ namespace Physics
 
 	void EnableDebugVisualization(const bool debug)
 	{
-		if (debug)
-		{
-			PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eSCALE, 1.0f);
-			PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eCOLLISION_EDGES, 2.0f);
-			PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eCOLLISION_SHAPES, 2.0f);
-			PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eACTOR_AXES, 2.0f);
-		}
-		else
+		PhysicsInstance::Write([debug]
 		{
-			PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eSCALE, 0.f);
-			PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eCOLLISION_EDGES, 0.f);
-			PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eCOLLISION_SHAPES, 0.f);
-			PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eACTOR_AXES, 0.f);
-		}
+			if (debug)
+			{
+				PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eSCALE, 1.0f);
+				PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eCOLLISION_EDGES, 2.0f);
+				PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eCOLLISION_SHAPES, 2.0f);
+				PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eACTOR_AXES, 2.0f);
+			}
+			else
+			{
+				PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eSCALE, 0.f);
+				PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eCOLLISION_EDGES, 0.f);
+				PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eCOLLISION_SHAPES, 0.f);
+				PhysicsInstance::GetScene()->setVisualizationParameter(PxVisualizationParameter::eACTOR_AXES, 0.f);
+			}
+		});
 	}
 
 	void GetDebugLines(std::vector<DebugVertex>& debugVertices)
 	{
-		const PxRenderBuffer& rb = PhysicsInstance::GetScene()->getRenderBuffer();
-
-		debugVertices.reserve(rb.getNbLines());
-
-		for (PxU32 iLine = 0; iLine < rb.getNbLines(); iLine++)
+		if (PhysicsInstance::IsSimulating())
 		{
-			const PxDebugLine& line = rb.getLines()[iLine];
-
-			debugVertices.emplace_back(Vec3Convert(line.pos0), line.color0);
-			debugVertices.emplace_back(Vec3Convert(line.pos1), line.color1);
+			debugVertices.insert(debugVertices.end(), s_debugLines.begin(), s_debugLines.end());
+			return;
 		}
+
+		ReadDebugLines(debugVertices);
 	}
 
 	bool Raycast(const LibMath::Vector3& origin, const LibMath::Vector3& direction, float maxDistance, RaycastHit& hit)
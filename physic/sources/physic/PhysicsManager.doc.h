@@ -55,6 +55,19 @@ namespace Physics
 	 */
 	PHYSIC_EXPORT void Advance(float delta);
 
+	/**
+	 * Starts simulating the given amount of time on the worker threads and returns at once.
+	 * Until EndAdvance, gameplay reads the results of the previous step and its writes are applied once the results are fetched.
+	 *
+	 * @param delta Amount of time to simulate.
+	 */
+	PHYSIC_EXPORT void BeginAdvance(float delta);
+
+	/**
+	 * Waits for the step started by BeginAdvance and moves the entities. Does nothing when no step is in flight.
+	 */
+	PHYSIC_EXPORT void EndAdvance();
+
 	/**
 	 * Creates a dynamic Convex mesh collider corresponding to the given parameters.
 	 * 
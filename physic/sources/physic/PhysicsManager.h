@@ -44,6 +44,11 @@ namespace Physics
 
 	void Advance(float delta);
 
+	// Advance in two halves, the step simulates on the workers while the caller works against the previous results.
+	// Writes made in between are applied once the results are fetched, see PhysicsInstance::Write
+	void BeginAdvance(float delta);
+	void EndAdvance(); // waits for the step in flight, if any
+
 	void CreateConvexMeshRigidDynamic(PhysicsRigidDynamic* rigidDynamic, const Core::Entity*,
 	                                  const std::vector<Model::Vertex>& vertices, float staticFriction = .5f,
 	                                  float dynamicFriction = .5f, float restitution = .1f,
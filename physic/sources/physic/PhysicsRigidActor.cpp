@@ -35,15 +35,21 @@ namespace Physics
     {
         const auto& newLocation = Core::Entity::GetEntity(handle)->GetAnchor()->GetWorldTransformNoCheck().position + localLocation;
 
-        rigidStatic->setGlobalPose(physx::PxTransform(newLocation.x, newLocation.y, newLocation.z, rigidStatic->getGlobalPose().q));
+        PhysicsInstance::Write([actor = rigidStatic, newLocation]
+        {
+            actor->setGlobalPose(physx::PxTransform(newLocation.x, newLocation.y, newLocation.z, actor->getGlobalPose().q));
+        });
     }
 
     void PhysicsRigidStatic::UpdateWorldRotation()
     {
         const auto& newRotation = Core::Entity::GetEntity(handle)->GetAnchor()->GetWorldTransformNoCheck().rotation * localRotation;
 
-        rigidStatic->setGlobalPose(physx::PxTransform(rigidStatic->getGlobalPose().p, 
-            physx::PxQuat(newRotation.X, newRotation.Y, newRotation.Z, newRotation.W)));
+        PhysicsInstance::Write([actor = rigidStatic, newRotation]
+        {
+            actor->setGlobalPose(physx::PxTransform(actor->getGlobalPose().p,
+                physx::PxQuat(newRotation.X, newRotation.Y, newRotation.Z, newRotation.W)));
+        });
     }
 
     LibMath::Vector3 PhysicsRigidStatic::GetWorldLocation() const
@@ -64,27 +70,32 @@ namespace Physics
 
     void PhysicsRigidStatic::SetIsTriggerShape(const bool isTrigger)
     {
-        physx::PxShape* shape;
-        rigidStatic->getShapes(&shape, 1);
-        shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, !isTrigger);
-        shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, isTrigger);
-
         isTriggerShape = isTrigger;
 
-        if(!isTrigger)
-        {
-            PhysicsInstance::MakeActorShapesDrivable(rigidStatic);
-        }
-        else
+        PhysicsInstance::Write([actor = rigidStatic, isTrigger]
         {
-            PhysicsInstance::MakeActorShapesNotDrivable(rigidStatic);
-        }
+            physx::PxShape* shape;
+            actor->getShapes(&shape, 1);
+            shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, !isTrigger);
+            shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, isTrigger);
+
+            if(!isTrigger)
+            {
+                PhysicsInstance::MakeActorShapesDrivable(actor);
+            }
+            else
+            {
+                PhysicsInstance::MakeActorShapesNotDrivable(actor);
+            }
+        });
     }
 
     void PhysicsRigidStatic::Release() const
     {
         if(rigidStatic)
-            rigidStatic->release();
+        {
+            PhysicsInstance::ReleaseActor(rigidStatic);
+        }
     }
 
     PhysicsRigidDynamic::PhysicsRigidDynamic(PhysicsRigidDynamic&& other) noexcept :
@@ -114,15 +125,21 @@ namespace Physics
     {
         const auto& newLocation = Core::Entity::GetEntity(handle)->GetAnchor()->GetWorldTransformNoCheck().position + localLocation;
 
-        rigidDynamic->setGlobalPose(physx::PxTransform(newLocation.x, newLocation.y, newLocation.z, rigidDynamic->getGlobalPose().q));
+        PhysicsInstance::Write([actor = rigidDynamic, newLocation]
+        {
+            actor->setGlobalPose(physx::PxTransform(newLocation.x, newLocation.y, newLocation.z, actor->getGlobalPose().q));
+        });
     }
 
     void PhysicsRigidDynamic::UpdateWorldRotation()
     {
         const auto& newRotation = Core::Entity::GetEntity(handle)->GetAnchor()->GetWorldTransformNoCheck().rotation * localRotation;
 
-        rigidDynamic->setGlobalPose(physx::PxTransform(rigidDynamic->getGlobalPose().p,
-            physx::PxQuat(newRotation.X, newRotation.Y, newRotation.Z, newRotation.W)));
+        PhysicsInstance::Write([actor = rigidDynamic, newRotation]
+        {
+            actor->setGlobalPose(physx::PxTransform(actor->getGlobalPose().p,
+                physx::PxQuat(newRotation.X, newRotation.Y, newRotation.Z, newRotation.W)));
+        });
     }
 
     LibMath::Vector3 PhysicsRigidDynamic::GetWorldLocation() const
@@ -143,39 +160,42 @@ namespace Physics
 
     void PhysicsRigidDynamic::SetMass(const float mass) const
     {
-        rigidDynamic->setMass(mass);
+        PhysicsInstance::Write([actor = rigidDynamic, mass] { actor->setMass(mass); });
     }
 
     void PhysicsRigidDynamic::SetKinematic(const bool isKinematic) const
     {
-        rigidDynamic->setRigidBodyFlag(physx::PxRigidBodyFlag::eKINEMATIC, isKinematic);
-        if(!isKinematic)
-            rigidDynamic->wakeUp();
+        PhysicsInstance::Write([actor = rigidDynamic, isKinematic]
+        {
+            actor->setRigidBodyFlag(physx::PxRigidBodyFlag::eKINEMATIC, isKinematic);
+            if(!isKinematic)
+                actor->wakeUp();
+        });
     }
 
     void PhysicsRigidDynamic::SetLinearDamping(const float angularDamping) const
     {
-        rigidDynamic->setLinearDamping(angularDamping);
+        PhysicsInstance::Write([actor = rigidDynamic, angularDamping] { actor->setLinearDamping(angularDamping); });
     }
 
     void PhysicsRigidDynamic::SetAngularDamping(const float angularDamping) const
     {
-        rigidDynamic->setAngularDamping(angularDamping);
+        PhysicsInstance::Write([actor = rigidDynamic, angularDamping] { actor->setAngularDamping(angularDamping); });
     }
 
     void PhysicsRigidDynamic::SetLinearVelocity(const LibMath::Vector3& velocity) const
     {
-        rigidDynamic->setLinearVelocity({ velocity.x, velocity.y, velocity.z });
+        PhysicsInstance::Write([actor = rigidDynamic, velocity] { actor->setLinearVelocity({ velocity.x, velocity.y, velocity.z }); });
     }
 
     void PhysicsRigidDynamic::SetAngularVelocity(const LibMath::Vector3& velocity) const
     {
-        rigidDynamic->setAngularVelocity({ velocity.x, velocity.y, velocity.z });
+        PhysicsInstance::Write([actor = rigidDynamic, velocity] { actor->setAngularVelocity({ velocity.x, velocity.y, velocity.z }); });
     }
 
     void PhysicsRigidDynamic::SetMassSpaceInertiaTensor(const LibMath::Vector3& tensor) const
     {
-        rigidDynamic->setMassSpaceInertiaTensor({ tensor.x, tensor.y, tensor.z });
+        PhysicsInstance::Write([actor = rigidDynamic, tensor] { actor->setMassSpaceInertiaTensor({ tensor.x, tensor.y, tensor.z }); });
     }
 
     float PhysicsRigidDynamic::GetRigidMass() const
@@ -210,66 +230,84 @@ namespace Physics
 
     void PhysicsRigidDynamic::AddForce(const LibMath::Vector3& force) const
     {
-        rigidDynamic->addForce({ force.x, force.y, force.z }, physx::PxForceMode::eFORCE);
+        PhysicsInstance::Write([actor = rigidDynamic, force] { actor->addForce({ force.x, force.y, force.z }, physx::PxForceMode::eFORCE); });
     }
 
     void PhysicsRigidDynamic::AddImpulse(const LibMath::Vector3& impulse) const
     {
-        rigidDynamic->addForce({ impulse.x, impulse.y, impulse.z }, physx::PxForceMode::eIMPULSE);
+        PhysicsInstance::Write([actor = rigidDynamic, impulse] { actor->addForce({ impulse.x, impulse.y, impulse.z }, physx::PxForceMode::eIMPULSE); });
     }
 
     void PhysicsRigidDynamic::AddAcceleration(const LibMath::Vector3& acceleration) const
     {
-        rigidDynamic->addForce({ acceleration.x, acceleration.y, acceleration.z }, physx::PxForceMode::eACCELERATION);
+        PhysicsInstance::Write([actor = rigidDynamic, acceleration] { actor->addForce({ acceleration.x, acceleration.y, acceleration.z }, physx::PxForceMode::eACCELERATION); });
     }
 
     void PhysicsRigidDynamic::AddForceAtLocation(const LibMath::Vector3& force, const LibMath::Vector3& location) const
     {
-        physx::PxRigidBodyExt::addForceAtPos(*rigidDynamic, { force.x, force.y, force.z }, { location.x, location.y, location.z });
+        PhysicsInstance::Write([actor = rigidDynamic, force, location]
+        {
+            physx::PxRigidBodyExt::addForceAtPos(*actor, { force.x, force.y, force.z }, { location.x, location.y, location.z });
+        });
     }
 
     void PhysicsRigidDynamic::AddForceAtLocalLocation(const LibMath::Vector3& force, const LibMath::Vector3& location) const
     {
-        physx::PxRigidBodyExt::addForceAtLocalPos(*rigidDynamic, { force.x, force.y, force.z }, { location.x, location.y, location.z });
+        PhysicsInstance::Write([actor = rigidDynamic, force, location]
+        {
+            physx::PxRigidBodyExt::addForceAtLocalPos(*actor, { force.x, force.y, force.z }, { location.x, location.y, location.z });
+        });
     }
 
     void PhysicsRigidDynamic::AddLocalForceAtLocation(const LibMath::Vector3& force, const LibMath::Vector3& location) const
     {
-        physx::PxRigidBodyExt::addLocalForceAtPos(*rigidDynamic, { force.x, force.y, force.z }, { location.x, location.y, location.z });
+        PhysicsInstance::Write([actor = rigidDynamic, force, location]
+        {
+            physx::PxRigidBodyExt::addLocalForceAtPos(*actor, { force.x, force.y, force.z }, { location.x, location.y, location.z });
+        });
     }
 
     void PhysicsRigidDynamic::AddLocalForceAtLocalLocation(const LibMath::Vector3& force,
         const LibMath::Vector3& location) const
     {
-        physx::PxRigidBodyExt::addLocalForceAtLocalPos(*rigidDynamic, { force.x, force.y, force.z }, { location.x, location.y, location.z });
+        PhysicsInstance::Write([actor = rigidDynamic, force, location]
+        {
+            physx::PxRigidBodyExt::addLocalForceAtLocalPos(*actor, { force.x, force.y, force.z }, { location.x, location.y, location.z });
+        });
     }
 
     void PhysicsRigidDynamic::SetIsTriggerShape(const bool isTrigger)
     {
-        physx::PxShape* shape;
-        rigidDynamic->getShapes(&shape, 1);
-        if(isTrigger)
-        {
-            shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, !isTrigger);
-            shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, isTrigger);
-        }
-        else
-        {
-            shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, isTrigger);
-            shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, !isTrigger);
-        }
-
         isTriggerShape = isTrigger;
+
+        PhysicsInstance::Write([actor = rigidDynamic, isTrigger]
+        {
+            physx::PxShape* shape;
+            actor->getShapes(&shape, 1);
+            if(isTrigger)
+            {
+                shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, !isTrigger);
+                shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, isTrigger);
+            }
+            else
+            {
+                shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, isTrigger);
+                shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, !isTrigger);
+            }
+        });
     }
 
     void PhysicsRigidDynamic::EnableGravity(const bool gravity) const
     {
-        if(!IsKinematic())
+        PhysicsInstance::Write([actor = rigidDynamic, gravity]
         {
-            rigidDynamic->setActorFlag(physx::PxActorFlag::eDISABLE_GRAVITY, !gravity);
-            if (gravity)
-                rigidDynamic->wakeUp();
-        }
+            if(!actor->getRigidBodyFlags().isSet(physx::PxRigidBodyFlag::eKINEMATIC))
+            {
+                actor->setActorFlag(physx::PxActorFlag::eDISABLE_GRAVITY, !gravity);
+                if (gravity)
+                    actor->wakeUp();
+            }
+        });
     }
 
     bool PhysicsRigidDynamic::IsGravityEnabled() const
@@ -280,7 +318,9 @@ namespace Physics
     void PhysicsRigidDynamic::Release() const
     {
         if(rigidDynamic)
-            rigidDynamic->release();
+        {
+            PhysicsInstance::ReleaseActor(rigidDynamic);
+        }
     }
 
     PhysicsVehicleActor::PhysicsVehicleActor(): vehicle(nullptr)
@@ -315,15 +355,21 @@ namespace Physics
     {
         const auto& newLocation = Core::Entity::GetEntity(handle)->GetAnchor()->GetWorldTransformNoCheck().position + localLocation;
 
-        vehicle->getRigidDynamicActor()->setGlobalPose(physx::PxTransform(newLocation.x, newLocation.y, newLocation.z, vehicle->getRigidDynamicActor()->getGlobalPose().q));
+        PhysicsInstance::Write([actor = vehicle->getRigidDynamicActor(), newLocation]
+        {
+            actor->setGlobalPose(physx::PxTransform(newLocation.x, newLocation.y, newLocation.z, actor->getGlobalPose().q));
+        });
     }
 
     void PhysicsVehicleActor::UpdateWorldRotation()
     {
         const auto& newRotation = Core::Entity::GetEntity(handle)->GetAnchor()->GetWorldTransformNoCheck().rotation * localRotation;
 
-        vehicle->getRigidDynamicActor()->setGlobalPose(physx::PxTransform(vehicle->getRigidDynamicActor()->getGlobalPose().p,
-            physx::PxQuat(newRotation.X, newRotation.Y, newRotation.Z, newRotation.W)));
+        PhysicsInstance::Write([actor = vehicle->getRigidDynamicActor(), newRotation]
+        {
+            actor->setGlobalPose(physx::PxTransform(actor->getGlobalPose().p,
+                physx::PxQuat(newRotation.X, newRotation.Y, newRotation.Z, newRotation.W)));
+        });
     }
 
     LibMath::Vector3 PhysicsVehicleActor::GetWorldLocation() const
@@ -459,8 +505,8 @@ namespace Physics
 
         if(vehicle)
         {
-            vehicle->getRigidDynamicActor()->release();
-            vehicle->release();
+            PhysicsInstance::ReleaseActor(vehicle->getRigidDynamicActor());
+            PhysicsInstance::Write([vehicle = vehicle] { vehicle->release(); });
         }
     }
 
@@ -9,6 +9,7 @@
 #include "VehicleSceneQuerry.h"
 #include "core/CLog.h"
 #include "core/ECS/Entity.h"
+#include "core/filesys/Config.h"
 #include "core/scenegraph/SceneNode.h"
 
 using namespace physx;
@@ -19,6 +20,7 @@ namespace Physics
     class VehicleWheelQueryResults;
 
     constexpr auto NUM_VEHICLES = 1024;
+    constexpr const char* VEHICLE_CONFIG_PATH = "config/vehicle.txt";
 
 	PxBatchQuery* gBatchQuery = nullptr;
 
@@ -70,9 +72,32 @@ namespace Physics
 	};
 	PxFixedSizeLookupTable<8> gSteerVsForwardSpeedTable(gSteerVsForwardSpeedData, 4);
 
+	static PxVehicleEngineData EngineData(const VehicleConfig& config)
+	{
+		PxVehicleEngineData engine;
+		engine.mPeakTorque = config.enginePeakTorque;
+		engine.mMaxOmega = config.engineMaxOmega;
+		return engine;
+	}
+
+	static PxVehicleGearsData GearsData(const VehicleConfig& config)
+	{
+		PxVehicleGearsData gears;
+		gears.mSwitchTime = config.gearSwitchTime;
+		return gears;
+	}
+
+	static PxVehicleClutchData ClutchData(const VehicleConfig& config)
+	{
+		PxVehicleClutchData clutch;
+		clutch.mStrength = config.clutchStrength;
+		return clutch;
+	}
+
 	/* All registered vehicles */
 	std::vector<PxVehicleWheels*> PhysicsVehicle::registeredVehicles;
 	int PhysicsVehicle::createdVehiclesCount = 0;
+	VehicleConfig PhysicsVehicle::config;
 
     void PhysicsVehicle::InitVehicles(PxDefaultAllocator* defaultAllocator)
     {
@@ -85,6 +110,8 @@ namespace Physics
 		gBatchQuery = VehicleSceneQueryData::SetUpBatchedSceneQuery(0, *gVehicleSceneQueryData, PhysicsInstance::GetScene());
 
 		gFrictionPairs = CreateFrictionPairs(PxGetPhysics().createMaterial(0.5f, 0.5f, 0.6f));
+
+		Core::Config::Watch(VEHICLE_CONFIG_PATH, config, &PhysicsVehicle::ApplyConfig); // for the whole run, like the physics one
     }
 
 	void PhysicsVehicle::CreateVehicle(PhysicsVehicleActor* vehicleActor, const VehicleDesc& vehicle4WDesc, const PxVec3& location, const PxQuat& rotation)
@@ -160,21 +187,10 @@ namespace Physics
 			diff.mType = PxVehicleDifferential4WData::eDIFF_TYPE_LS_4WD;
 			driveSimData.setDiffData(diff);
 
-			//Engine
-			PxVehicleEngineData engine;
-			engine.mPeakTorque = 500.0f;
-			engine.mMaxOmega = 600.0f;//approx 6000 rpm
-			driveSimData.setEngineData(engine);
-
-			//Gears
-			PxVehicleGearsData gears;
-			gears.mSwitchTime = 0.5f;
-			driveSimData.setGearsData(gears);
-
-			//Clutch
-			PxVehicleClutchData clutch;
-			clutch.mStrength = 10.0f;
-			driveSimData.setClutchData(clutch);
+			//Engine, gears and clutch from config/vehicle.txt
+			driveSimData.setEngineData(EngineData(config));
+			driveSimData.setGearsData(GearsData(config));
+			driveSimData.setClutchData(ClutchData(config));
 
 			//Ackermann steer accuracy
 			PxVehicleAckermannGeometryData ackermann;
@@ -203,7 +219,7 @@ namespace Physics
 
 		vehDrive4W->getRigidDynamicActor()->setGlobalPose(PxTransform{ location, rotation });
 
-		PhysicsInstance::GetScene()->addActor(*vehDrive4W->getRigidDynamicActor());
+		PhysicsInstance::AddActor(*vehDrive4W->getRigidDynamicActor());
 
 		vehicleActor->vehicle = vehDrive4W;
 		vehicleActor->wheelsCount = vehicle4WDesc.numWheels;
@@ -466,6 +482,21 @@ namespace Physics
 	   }
     }
 
+    void PhysicsVehicle::ApplyConfig()
+    {
+		// the sim data is read by the step in flight
+		PhysicsInstance::Write([]
+		{
+			for (PxVehicleWheels* vehicle : registeredVehicles)
+			{
+				PxVehicleDriveSimData4W& driveSimData = static_cast<PxVehicleDrive4W*>(vehicle)->mDriveSimData;
+				driveSimData.setEngineData(EngineData(config));
+				driveSimData.setGearsData(GearsData(config));
+				driveSimData.setClutchData(ClutchData(config));
+			}
+		});
+    }
+
     PxVehicleDrivableSurfaceToTireFrictionPairs* PhysicsVehicle::CreateFrictionPairs(const PxMaterial* defaultMaterial)
     {
 		PxVehicleDrivableSurfaceType surfaceTypes[1];
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "PxPhysicsAPI.h"
+#include "PhysicsConfig.h"
 
 namespace LibMath {
     struct Quaternion;
@@ -139,6 +140,8 @@ namespace Physics
 
         static void ReleaseVehicle(int vehicleId);
 
+        static void ApplyConfig(); // of config/vehicle.txt to every registered vehicle, when the file changes
+
     private:
 
         static physx::PxVehicleDrivableSurfaceToTireFrictionPairs*  CreateFrictionPairs(const physx::PxMaterial* defaultMaterial);
@@ -168,5 +171,7 @@ namespace Physics
         static std::vector<physx::PxVehicleWheels*> registeredVehicles;
 
         static int createdVehiclesCount;
+
+        static VehicleConfig config;
     };
 }
\ No newline at end of file
@@ -2,11 +2,22 @@
 
 #include "PhysicsInstance.h"
 #include "PhysicsRigidActor.h"
+#include "core/ECS/Event.h"
 
 using namespace physx;
 
 namespace Physics
 {
+    namespace
+    {
+        // one event per receiving actor, so releasing one side while handling discards what the other side would get
+        void EnqueueContact(PxRigidActor* first, PxRigidActor* second, const SweepHit& sweepHit, const EContactType type)
+        {
+            Core::EventBus::Enqueue(ContactEvent{first, second, sweepHit, type});
+            Core::EventBus::Enqueue(ContactEvent{second, first, sweepHit, type});
+        }
+    }
+
     void SimulationEventCallback::onTrigger(PxTriggerPair* pairs, PxU32 count)
     {
         for (PxU32 i = 0; i < count; i++)
@@ -14,19 +25,7 @@ namespace Physics
             if (pairs[i].flags & (PxTriggerPairFlag::eREMOVED_SHAPE_TRIGGER | PxTriggerPairFlag::eREMOVED_SHAPE_OTHER))
                 continue;
 
-            auto* firstActor = pairs[i].triggerActor;
-            auto* secondActor = pairs[i].otherActor;
-
-            auto* firstRigidBody = static_cast<PhysicsRigidActor*>(firstActor->userData);
-            auto* secondRigidBody = static_cast<PhysicsRigidActor*>(secondActor->userData);
-
-            if(firstRigidBody && secondRigidBody)
-            {
-                const SweepHit sweepHit{};
-
-                firstRigidBody->onBeginOverlap.Broadcast(firstRigidBody, secondRigidBody, sweepHit);
-                secondRigidBody->onBeginOverlap.Broadcast(secondRigidBody, firstRigidBody, sweepHit);
-            }
+            EnqueueContact(pairs[i].triggerActor, pairs[i].otherActor, SweepHit{}, EContactType::BEGIN_OVERLAP);
         }
     }
 
@@ -42,15 +41,11 @@ namespace Physics
                 auto* firstActor = pairs[iPair].shapes[0]->getActor();
                 auto* secondActor = pairs[iPair].shapes[1]->getActor();
 
-                auto* firstRigidBody = static_cast<PhysicsRigidActor*>(firstActor->userData);
-                auto* secondRigidBody = static_cast<PhysicsRigidActor*>(secondActor->userData);
-
-                if (firstRigidBody && secondRigidBody)
+                if (firstActor->userData && secondActor->userData)
                 {
                     if (pairs[iPair].flags.isSet(PxContactPairFlag::eACTOR_PAIR_LOST_TOUCH))
                     {
-                        firstRigidBody->onEndOverlap.Broadcast(firstRigidBody, secondRigidBody);
-                        secondRigidBody->onEndOverlap.Broadcast(secondRigidBody, firstRigidBody);
+                        EnqueueContact(firstActor, secondActor, SweepHit{}, EContactType::END_OVERLAP);
                     }
                     if (pairs[iPair].events.isSet(PxPairFlag::eNOTIFY_TOUCH_FOUND))
                     {
@@ -68,9 +63,7 @@ namespace Physics
                                 const SweepHit sweepHit(Vec3Convert(contactPoints[0].position),
                                     Vec3Convert(contactPoints[0].normal), contactPoints[0].separation < 0.f);
 
-                                firstRigidBody->onBeginOverlap.Broadcast(firstRigidBody, secondRigidBody, sweepHit);
-                                secondRigidBody->onBeginOverlap.Broadcast(secondRigidBody, firstRigidBody, sweepHit);
-
+                                EnqueueContact(firstActor, secondActor, sweepHit, EContactType::BEGIN_OVERLAP);
                             }
                         }
                     }
@@ -80,4 +73,31 @@ namespace Physics
         }
 
     }
-}
\ No newline at end of file
+
+    void SimulationEventCallback::BroadcastContact(const ContactEvent& event)
+    {
+        auto* rigidBody = static_cast<PhysicsRigidActor*>(event.first->userData);
+        auto* otherRigidBody = static_cast<PhysicsRigidActor*>(event.second->userData);
+
+        if (rigidBody == nullptr || otherRigidBody == nullptr)
+            return;
+
+        if (event.type == EContactType::END_OVERLAP)
+            rigidBody->onEndOverlap.Broadcast(rigidBody, otherRigidBody);
+        else
+            rigidBody->onBeginOverlap.Broadcast(rigidBody, otherRigidBody, event.sweepHit);
+    }
+
+    void SimulationEventCallback::DiscardContacts(const PxRigidActor* actor)
+    {
+        Core::EventBus::Discard<ContactEvent>([actor](const ContactEvent& event)
+        {
+            return event.first == actor || event.second == actor;
+        });
+    }
+
+    void SimulationEventCallback::DiscardAllContacts()
+    {
+        Core::EventBus::Discard<ContactEvent>([](const ContactEvent&) { return true; });
+    }
+}
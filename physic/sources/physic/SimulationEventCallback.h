@@ -1,8 +1,26 @@
 #pragma once
 #include <PxSimulationEventCallback.h>
 
+#include "PhysicsRigidActor.h"
+
 namespace Physics
 {
+    enum class EContactType
+    {
+        BEGIN_OVERLAP,
+        END_OVERLAP
+    };
+
+    // Enqueued on the Core::EventBus during fetchResults, broadcast to the onBeginOverlap / onEndOverlap of the first actor when dispatched.
+    // The physx actors are kept rather than the components, which move in memory when their array grows.
+    struct ContactEvent
+    {
+        physx::PxRigidActor*    first;
+        physx::PxRigidActor*    second; // the other actor
+        SweepHit                sweepHit;
+        EContactType            type;
+    };
+
     class SimulationEventCallback : public physx::PxSimulationEventCallback
     {
         void onConstraintBreak(physx::PxConstraintInfo* constraints, physx::PxU32 count) override { PX_UNUSED(constraints); PX_UNUSED(count); }
@@ -13,5 +31,12 @@ namespace Physics
 
 
         void onContact(const physx::PxContactPairHeader& pairHeader, const physx::PxContactPair* pairs, physx::PxU32 nbPairs) override;
+
+    public:
+        static void BroadcastContact(const ContactEvent& event);
+
+        // before releasing an actor, its queued contacts would point to freed memory
+        static void DiscardContacts(const physx::PxRigidActor* actor);
+        static void DiscardAllContacts();
     };
 }
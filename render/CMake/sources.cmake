@@ -11,8 +11,8 @@ sources/imgui/ImguiImpl.cpp
 sources/imgui/ImguiImpl.h
 sources/imgui/UI.cpp
 sources/imgui/UI.h
-sources/imgui/UIDebugBenchmarkValue.cpp
-sources/imgui/UIDebugBenchmarkValue.h
+sources/imgui/UIDebugProfiler.cpp
+sources/imgui/UIDebugProfiler.h
 sources/imgui/UIDebugSection.cpp
 sources/imgui/UIDebugSection.h
 sources/imgui/UIDebugWindow.cpp
@@ -39,6 +39,8 @@ sources/render/RenderComponent/ModelComponent.cpp
 sources/render/RenderComponent/ModelComponent.h
 sources/render/RenderInclude.cpp
 sources/render/RenderInclude.h
+sources/render/RenderSnapshot/RenderSnapshot.cpp
+sources/render/RenderSnapshot/RenderSnapshot.h
 sources/render/Shaders/ShaderModule.cpp
 sources/render/Shaders/ShaderModule.h
 sources/render/TextureImage/VulkanTextureImage.cpp
@@ -16,12 +16,15 @@ ConsoleLogs::ConsoleLogs()
 
 void ConsoleLogs::Clear()
 {
+    std::lock_guard<std::mutex> lock(mutex);
     buffer.clear();
     lineOffsets.clear();
 }
 
 void ConsoleLogs::AddLog(Core::CLogMessage* message)
 {
+    std::lock_guard<std::mutex> lock(mutex);
+
     if (message->message[message->message.size() - 1] != '\n')
         message->message.push_back('\n');
 
@@ -99,6 +102,8 @@ void ConsoleLogs::Draw(const char* title, bool* p_open)
     if (copy)
         LogToClipboard();
 
+    std::lock_guard<std::mutex> lock(mutex);
+
     PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
     const char* buf = buffer.begin();
     const char* bufEnd = buffer.end();
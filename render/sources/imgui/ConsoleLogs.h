@@ -1,4 +1,6 @@
 #pragma once
+#include <mutex>
+
 #include "imgui/imgui.h"
 
 namespace Core
@@ -30,6 +32,7 @@ private:
 	ImVector<int>	lineFileLine;
 	ImVector<ImU32>	lineColors;
 	bool			autoScroll;
+	std::mutex		mutex; // logs are received on the log writer thread
 
 	ImU32	warningColor = ImColor(255, 94, 19);
 	ImU32	errorColor = ImColor{ 255, 0, 0 };
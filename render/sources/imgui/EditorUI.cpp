@@ -31,6 +31,9 @@ using namespace ImGui;
 
 static bool isFileDragged = false;
 static EFileType draggedFileType = EFileType::MODEL;
+static constexpr const char* INPUT_RECORDING_FILE = "inputs.rec"; // in the working directory, replayable by the bench
+static constexpr const char* AUTOSAVE_FILE = "autosave.lvl"; // for a level never saved, next to the level otherwise
+static constexpr float AUTOSAVE_PERIOD = 60.f; // seconds
 
 EditorUI::EditorUI()
 {
@@ -112,6 +115,8 @@ void EditorUI::Draw(const int idx)
 	DrawSceneGraphWindow();
 
 	DrawInspectorWindow();
+
+	UpdateHistory();
 }
 
 void EditorUI::DrawMainMenuBar()
@@ -124,6 +129,7 @@ void EditorUI::DrawMainMenuBar()
 			{
 				Core::World::Initialize();
 				currentLevelFile = "";
+				ResetHistory();
 			}
 			if (MenuItem("Open", "Ctrl+O"))
 			{
@@ -141,6 +147,7 @@ void EditorUI::DrawMainMenuBar()
 				else
 				{
 					Core::World::Save(currentLevelFile.c_str());
+					hasUnsavedChanges = false;
 				}
 			}
 			if (MenuItem("Save As.."))
@@ -157,6 +164,16 @@ void EditorUI::DrawMainMenuBar()
 
 		if (BeginMenu("Edit"))
 		{
+			const bool isEditing = Core::World::HasStarted() == false;
+			if (MenuItem("Undo", "Ctrl+Z", false, isEditing && worldHistory.CanUndo()))
+			{
+				UndoEdit();
+			}
+			if (MenuItem("Redo", "Ctrl+Y", false, isEditing && worldHistory.CanRedo()))
+			{
+				RedoEdit();
+			}
+			Separator();
 			if (MenuItem("Refresh Shaders"))
 			{
 				Render::VulkanRenderer::RefreshShaders();
@@ -165,6 +182,32 @@ void EditorUI::DrawMainMenuBar()
 			{
 				Render::VulkanRenderer::TogglePhysXDebug(physXDebug);
 			}
+			bool pipelinedRendering = Core::GameLoop::IsPipelinedRendering();
+			if (Checkbox("Pipelined rendering", &pipelinedRendering))
+			{
+				Core::GameLoop::SetPipelinedRendering(pipelinedRendering);
+			}
+			bool asyncPhysics = Core::GameLoop::IsAsyncPhysics();
+			if (Checkbox("Async physics", &asyncPhysics))
+			{
+				Core::GameLoop::SetAsyncPhysics(asyncPhysics);
+			}
+			// the mode applies to the next play session, not to the one running
+			const bool canChangeInputMode = Core::GameLoop::CanChangeInputMode();
+			if (MenuItem("Record inputs", nullptr, Core::GameLoop::IsRecordingInputs(), canChangeInputMode))
+			{
+				if (Core::GameLoop::IsRecordingInputs())
+					Core::GameLoop::UseLiveInputs();
+				else
+					Core::GameLoop::RecordInputs(INPUT_RECORDING_FILE);
+			}
+			if (MenuItem("Replay inputs", nullptr, Core::GameLoop::IsReplayingInputs(), canChangeInputMode))
+			{
+				if (Core::GameLoop::IsReplayingInputs())
+					Core::GameLoop::UseLiveInputs();
+				else if (Core::GameLoop::ReplayInputs(INPUT_RECORDING_FILE) == false)
+					inputReplayError = std::string("Could not load the input recording ") + INPUT_RECORDING_FILE;
+			}
 
 			GameViewport::gameViewport.DrawViewportSelectorMenu();
 
@@ -234,11 +277,10 @@ void EditorUI::DrawMainMenuBar()
 		}
 		if (Core::World::HasStarted())
 		{
-			//if (MenuItem("Stop"))
-			//{
-			//	Core::GameLoop::StopWorld();
-			//	Core::World::Initialize(currentLevelFile.c_str());
-			//}
+			if (MenuItem("Stop"))
+			{
+				Core::GameLoop::StopWorld();
+			}
 		}
 
 		Separator();
@@ -250,6 +292,21 @@ void EditorUI::DrawMainMenuBar()
 
 		EndMainMenuBar();
 	}
+
+	if (inputReplayError.empty() == false)
+	{
+		OpenPopup("Input replay");
+	}
+	if (BeginPopupModal("Input replay", nullptr, ImGuiWindowFlags_AlwaysAutoResize))
+	{
+		Text("%s", inputReplayError.c_str());
+		if (Button("OK"))
+		{
+			inputReplayError.clear();
+			CloseCurrentPopup();
+		}
+		EndPopup();
+	}
 }
 
 void EditorUI::DrawToolsWindow()
@@ -553,7 +610,7 @@ void EditorUI::DrawFields(Core::Structure* structure, void* instance) const
 				void* icon;
 				if (iconImage == nullptr)
 				{
-					Core::ThreadPool::defaultThreadPool.AddTask([uiImagePointer]
+					Core::ThreadPool::GetDefaultThreadPool().AddTask([uiImagePointer]
 					{
 						ImGuiImpl::LoadImGuiTexture(uiImagePointer.image->path);
 					});
@@ -787,7 +844,7 @@ void EditorUI::DragDropFile(File* instance) const
 		iconImage = ResourceManager::GetResource<Render::Image>(instance->path);
 		if (iconImage == nullptr)
 		{
-			Core::ThreadPool::defaultThreadPool.AddTask([instance]
+			Core::ThreadPool::GetDefaultThreadPool().AddTask([instance]
 			{
 				ImGuiImpl::LoadImGuiTexture(instance->path);
 			});
@@ -917,9 +974,9 @@ void EditorUI::DrawDebugWindow() const
 	Separator();
 
 
-	if (TreeNode("Benchmark"))
+	if (TreeNode("Profiler"))
 	{
-		UIDebugWindow::DrawBenchmarkValues();
+		UIDebugWindow::DrawProfiler();
 		TreePop();
 		Separator();
 	}
@@ -932,7 +989,7 @@ void EditorUI::DrawDebugWindow() const
 
 void EditorUI::PackageProject()
 {
-	Core::ThreadPool::defaultThreadPool.AddTask([]
+	Core::ThreadPool::GetDefaultThreadPool().AddTask([]
 	{
 		TCHAR szDir[MAX_PATH];
 		BROWSEINFO bInfo;
@@ -987,6 +1044,7 @@ void EditorUI::LoadProject()
 
 	currentLevelFile = std::string(buffer);
 	Core::World::Initialize(buffer);
+	ResetHistory();
 }
 
 void EditorUI::SaveProject()
@@ -1007,6 +1065,99 @@ void EditorUI::SaveProject()
 
 	currentLevelFile = std::string(buffer);
 	Core::World::Save(buffer);
+	hasUnsavedChanges = false;
+}
+
+void EditorUI::UpdateHistory()
+{
+	if (Core::World::HasStarted())
+	{
+		// not edits : the world is restored to its state before play when it stops
+		wasItemActive = false;
+		return;
+	}
+
+	const ImGuiIO& io = GetIO();
+	if (io.KeyCtrl && io.WantTextInput == false) // the text fields have their own undo
+	{
+		if (IsKeyPressed(GetKeyIndex(ImGuiKey_Z)))
+		{
+			UndoEdit();
+		}
+		else if (IsKeyPressed(GetKeyIndex(ImGuiKey_Y)))
+		{
+			RedoEdit();
+		}
+	}
+
+	// an edit is done when its widget is released, or on a click for the buttons and the viewport
+	const bool isItemActive = IsAnyItemActive();
+	if (isItemActive == false && (wasItemActive || IsMouseReleased(ImGuiMouseButton_Left)))
+	{
+		worldHistory.Touch(currentSelectedNode); // the inspector only edits the selected node
+		hasUnsavedChanges |= worldHistory.Commit();
+	}
+	wasItemActive = isItemActive;
+
+	timeSinceAutosave += io.DeltaTime;
+	if (hasUnsavedChanges && timeSinceAutosave >= AUTOSAVE_PERIOD)
+	{
+		Autosave();
+	}
+}
+
+void EditorUI::ResetHistory()
+{
+	worldHistory.Reset();
+	hasUnsavedChanges = false;
+	timeSinceAutosave = 0.f;
+}
+
+void EditorUI::UndoEdit()
+{
+	worldHistory.Touch(currentSelectedNode);
+	worldHistory.Commit(); // the edit in progress, if any
+
+	const unsigned int generation = Core::World::GetLevelGeneration();
+	if (worldHistory.Undo())
+	{
+		hasUnsavedChanges = true;
+		if (generation != Core::World::GetLevelGeneration())
+		{
+			currentSelectedNode = nullptr; // the level was reloaded to undo a structural change
+		}
+	}
+}
+
+void EditorUI::RedoEdit()
+{
+	const unsigned int generation = Core::World::GetLevelGeneration();
+	if (worldHistory.Redo())
+	{
+		hasUnsavedChanges = true;
+		if (generation != Core::World::GetLevelGeneration())
+		{
+			currentSelectedNode = nullptr;
+		}
+	}
+}
+
+void EditorUI::Autosave()
+{
+	std::filesystem::path autosavePath(AUTOSAVE_FILE);
+	if (currentLevelFile.empty() == false)
+	{
+		autosavePath = currentLevelFile;
+		autosavePath.replace_filename(autosavePath.stem().string() + "_autosave.lvl");
+	}
+
+	if (Core::WorldSnapshot::Capture().Save(autosavePath.string().c_str()) == false)
+	{
+		LOG(LOG_WARNING, "Could not autosave the level to " + autosavePath.string(), Core::ELogChannel::CLOG_GENERAL);
+	}
+
+	hasUnsavedChanges = false;
+	timeSinceAutosave = 0.f;
 }
 
 void EditorUI::ExploreFiles()
@@ -1087,7 +1238,7 @@ void EditorUI::ExploreFiles()
 				else
 				{
 					Image(fileIcon, {imageWidth, imageHeight});
-					Core::ThreadPool::defaultThreadPool.AddTask([projectRelativePath]
+					Core::ThreadPool::GetDefaultThreadPool().AddTask([projectRelativePath]
 					{
 						ImGuiImpl::LoadImGuiTexture(projectRelativePath);
 					});
@@ -1157,6 +1308,7 @@ void EditorUI::ExploreFiles()
 				if (ImageButton(levelIcon, {imageWidth, imageHeight}))
 				{
 					Core::World::Initialize(file.path().string().c_str());
+					ResetHistory();
 				}
 				PopID();
 			}
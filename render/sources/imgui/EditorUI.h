@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <vector>
 
+#include "core/ECS/WorldSnapshot.h"
 #include "core/reflection/StructureField.h"
 
 #define INPUT_STEP 0.1f
@@ -105,6 +106,18 @@ private:
 
 	Core::SceneNode* currentSelectedNode = nullptr;
 
+	/* Undo, redo and autosave of the level edits */
+	void UpdateHistory();
+	void ResetHistory(); // a level was opened
+	void UndoEdit();
+	void RedoEdit();
+	void Autosave();
+
+	Core::WorldHistory worldHistory;
+	bool wasItemActive = false;
+	bool hasUnsavedChanges = false; // since the last save or autosave
+	float timeSinceAutosave = 0.f;
+
 	/* File explorer */
 	void ExploreFiles();
 	void DrawExploredDirectories();
@@ -134,4 +147,5 @@ private:
 	bool needStyleUpdate = true;
 
 	std::string currentLevelFile = "";
+	std::string inputReplayError = ""; // shown until dismissed
 };
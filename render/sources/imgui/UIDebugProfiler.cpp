@@ -0,0 +1,62 @@
+#include "UIDebugProfiler.h"
+
+#include "core/CLog.h"
+#include "imgui/imgui.h"
+
+namespace
+{
+	void DrawPercentiles(const Core::Histogram& histogram)
+	{
+		ImGui::TextDisabled("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms (%llu frames)",
+		                    histogram.Percentile(50.f), histogram.Percentile(95.f), histogram.Percentile(99.f),
+		                    histogram.GetMax(), histogram.GetCount());
+	}
+}
+
+void UIDebugProfiler::DrawFrameStats()
+{
+	const Core::Histogram& frames = Core::FrameStats::GetFrameHistogram();
+	ImGui::Text("Frame: mean %.2f ms, %llu spikes", frames.GetMean(), Core::FrameStats::GetSpikeCount());
+	DrawPercentiles(frames);
+
+	if (Core::FrameStats::GetLastDumpPath().empty() == false)
+		ImGui::TextDisabled("Last spike dump: %s", Core::FrameStats::GetLastDumpPath().c_str());
+
+	if (ImGui::Button("Reset stats"))
+		ResetStats();
+}
+
+void UIDebugProfiler::DrawZoneGraph(const ZoneHistory& history)
+{
+	ImGui::Text("%s: %.2f ms", history.zone->name, GetLastMilliseconds(history));
+	DrawPercentiles(history.histogram);
+
+	float maxVal = 0;
+	const float minVal = 0;
+
+	for (float val : history.milliseconds)
+	{
+		if (maxVal < val)
+			maxVal = val;
+	}
+
+	ImGui::PushID(history.zone);
+	ImGui::PlotLines("", history.milliseconds, HISTORY_SIZE, GetHistoryOffset(),
+	                 nullptr, minVal, maxVal,
+	                 ImVec2(ImGui::GetContentRegionAvailWidth(), 50));
+	ImGui::PopID();
+}
+
+void UIDebugProfiler::DrawExportButton()
+{
+	if (ImGui::Button("Export trace"))
+	{
+		// open with chrome://tracing or ui.perfetto.dev
+		const std::string filePath = "Logs/trace_" + Core::CLog::LogTime(true) + ".json";
+
+		if (ExportChromeTrace(filePath))
+			LOG(LOG_INFO, "Profiler trace exported to " + filePath);
+		else
+			LOG(LOG_WARNING, "Could not export the profiler trace to " + filePath);
+	}
+}
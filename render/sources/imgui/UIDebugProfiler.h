@@ -0,0 +1,13 @@
+#pragma once
+
+#include "core/DebugWindow/Profiler.h"
+
+
+class UIDebugProfiler : Core::Profiler
+{
+public:
+
+	static void DrawFrameStats();
+	static void DrawZoneGraph(const ZoneHistory& history);
+	static void DrawExportButton();
+};
@@ -1,15 +1,18 @@
 #include "UIDebugWindow.h"
 
 
-#include "UIDebugBenchmarkValue.h"
+#include "UIDebugProfiler.h"
 #include "UIDebugSection.h"
 
 
-void UIDebugWindow::DrawBenchmarkValues()
+void UIDebugWindow::DrawProfiler()
 {
-	for (const auto& value : GetBenchmarkValues())
+	UIDebugProfiler::DrawFrameStats();
+	UIDebugProfiler::DrawExportButton();
+
+	for (const auto& history : Core::Profiler::GetZoneHistories())
 	{
-		UIDebugBenchmarkValue::DrawBenchmarkGraph(value);
+		UIDebugProfiler::DrawZoneGraph(history);
 	}
 }
 
@@ -6,6 +6,6 @@
 class UIDebugWindow : Core::DebugWindow
 {
 public:
-	static void DrawBenchmarkValues();
+	static void DrawProfiler();
 	static void DrawDebugWindow();
 };
@@ -184,7 +184,7 @@ void UIImage::Init()
     imagePointer = ResourceManager::GetResource<void>(path + "imgui");
     if(imagePointer == nullptr)
     {
-        Core::ThreadPool::defaultThreadPool.AddTask([this]
+        Core::ThreadPool::GetDefaultThreadPool().AddTask([this]
         {
             ImGuiImpl::LoadImGuiTexture(path);
             this->imagePointer = ResourceManager::GetResource<void>(path + "imgui");
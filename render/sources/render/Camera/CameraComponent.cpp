@@ -1,5 +1,6 @@
 #include "CameraComponent.h"
 
+#include "core/GameLoop.h"
 #include "core/ECS/Entity.h"
 #include "core/scenegraph/SceneNode.h"
 
@@ -56,8 +57,10 @@ void CameraComponent::SetRotationQuaternion( LibMath::Quaternion rotation)
 
 LibMath::Matrix4 CameraComponent::ComputeLookAt()
 {
-	const LibMath::Vector3 position =
-		Core::Entity::GetEntity(GetEntityHandle())->GetAnchor()->GetWorldTransformNoCheck().position;
+	// interpolated like the rendered models, or the camera following a body would stutter against it
+	const Core::Transform transform = Core::Entity::GetEntity(GetEntityHandle())->GetAnchor()
+		->GetInterpolatedWorldTransform(Core::GameLoop::GetInterpolationAlpha());
 
-	return LibMath::Matrix4::LookAtLh(position, position + front, up);
+	return LibMath::Matrix4::LookAtLh(transform.position, transform.position + transform.rotation * LibMath::Vector3::Front,
+	                                  transform.rotation * LibMath::Vector3::Up);
 }
@@ -105,6 +105,11 @@ namespace Render
 		return width < 1 || height < 1;
     }
 
+	bool EngineWindow::IsFocused() const
+	{
+		return glfwGetWindowAttrib(window, GLFW_FOCUSED) == GLFW_TRUE;
+	}
+
 	void EngineWindow::FramebufferSizeCallback(GLFWwindow* /*window*/, int /*width*/, int /*height*/)
 	{
 		*WindowInstance->framebufferResized = true;
@@ -43,6 +43,7 @@ namespace Render
 		[[nodiscard]] GLFWwindow* GetGLFWWindow() const { return window; }
 
 		bool IsMinimized() const;
+		[[nodiscard]] bool IsFocused() const;
 
 	private:
 		static void FramebufferSizeCallback(GLFWwindow* window, int width, int height);
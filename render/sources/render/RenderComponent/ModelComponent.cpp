@@ -68,134 +68,54 @@ namespace Render
 		path = ((const ModelComponentInitParams*)params)->file.path;
 	}
 
-	void ModelComponent::Constructor()
+	void ModelComponent::LoadResources()
 	{
 		if (path.empty())
 			return;
 
-		VulkanRenderer::AddVulkanBuffersToModel(this, path);
+		Model::Model::Import(path);
 	}
 
-	void ModelComponent::Finalize()
+	void ModelComponent::Constructor()
 	{
-		for (auto& subComponent : meshes)
-		{
-			if (subComponent.vertexBuffer)
-			{
-				Core::MemoryPool::Free(subComponent.vertexBuffer);
-				subComponent.vertexBuffer = nullptr;
-			}
-
-			if (subComponent.indexBuffer)
-			{
-				Core::MemoryPool::Free(subComponent.indexBuffer);
-				subComponent.indexBuffer = nullptr;
-			}
-		}
-
-		meshes.clear();
-
-		if (modelMatrix)
-		{
-			Core::MemoryPool::Free(modelMatrix);
-			modelMatrix = nullptr;
-		}
-
-		path.clear();
+		if (path.empty())
+			return;
 
-		material.materials.clear();
+		VulkanRenderer::AddVulkanBuffersToModel(this, path);
 	}
 
-	void ModelComponent::Draw(const vk::CommandBuffer& commandBuffer, const vk::PipelineLayout pipelineLayout, int idx,
-	                          std::string& previousMaterialName)
+	void ModelComponent::Finalize()
 	{
-		vk::DeviceSize offsets[] = {0};
-
-		if (meshes.empty())
-			return;
-
-		modelMatrix->model =
-			Core::Entity::GetEntity(GetEntityHandle())->GetAnchor()->GenerateWorldTransformMatrixNoCheck();
-
-		for (auto& mesh : meshes)
+		// the buffers may still be drawn by the render snapshot being recorded
+		VulkanRenderer::ReleaseAfterRender([releasedMeshes = std::move(meshes), releasedMatrix = modelMatrix]() mutable
 		{
-			commandBuffer.bindVertexBuffers(0, 1, &mesh.vertexBuffer->GetBuffer(), offsets);
-
-			commandBuffer.pushConstants(pipelineLayout,
-			                            vk::ShaderStageFlagBits::eVertex, 0,
-			                            sizeof(VulkanPushConstant),
-			                            modelMatrix);
-
-			if (!mesh.material)
+			for (auto& subComponent : releasedMeshes)
 			{
-				if (previousMaterialName != Model::defaultMaterialName)
+				if (subComponent.vertexBuffer)
 				{
-					commandBuffer.bindDescriptorSets(
-						vk::PipelineBindPoint::eGraphics,
-						pipelineLayout, 2, 1,
-						&(ResourceManager::GetResource<Material>(Model::defaultMaterialName)->
-							GetDescriptorSet(idx)),
-						0,
-						nullptr);
-
-					previousMaterialName = Model::defaultMaterialName;
+					Core::MemoryPool::Free(subComponent.vertexBuffer);
+					subComponent.vertexBuffer = nullptr;
 				}
-			}
-			else
-			{
-				if (previousMaterialName != mesh.material->name)
-				{
-					commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-					                                 pipelineLayout, 2, 1,
-					                                 &(mesh.material->GetDescriptorSet(idx)), 0,
-					                                 nullptr);
 
-					previousMaterialName = mesh.material->name;
+				if (subComponent.indexBuffer)
+				{
+					Core::MemoryPool::Free(subComponent.indexBuffer);
+					subComponent.indexBuffer = nullptr;
 				}
 			}
 
-			if (mesh.indexBuffer->GetIndexCount() == 0 ||
-				mesh.indexBuffer->GetIndexCount() == mesh.vertexBuffer->GetVertexCount())
-			{
-				commandBuffer.draw(mesh.vertexBuffer->GetVertexCount(), 1, 0, 0);
-			}
-			else
+			if (releasedMatrix)
 			{
-				commandBuffer.bindIndexBuffer(mesh.indexBuffer->GetBuffer(), 0, vk::IndexType::eUint32);
-				commandBuffer.drawIndexed(mesh.indexBuffer->GetIndexCount(), 1, 0, 0, 0);
+				Core::MemoryPool::Free(releasedMatrix);
 			}
-		}
-	}
+		});
 
-	void ModelComponent::DrawUntextured(const vk::CommandBuffer& commandBuffer, const vk::PipelineLayout pipelineLayout)
-	{
-		vk::DeviceSize offsets[] = {0};
-
-		if (modelMatrix == nullptr) return;
-		modelMatrix->model =
-			Core::Entity::GetEntity(GetEntityHandle())->GetAnchor()->GenerateWorldTransformMatrixNoCheck();
-
-		for (auto& mesh : (meshes))
-		{
-			commandBuffer.bindVertexBuffers(0, 1, &mesh.vertexBuffer->GetBuffer(), offsets);
-
-			commandBuffer.pushConstants(pipelineLayout,
-			                            vk::ShaderStageFlagBits::eVertex, 0,
-			                            sizeof(VulkanPushConstant),
-			                            modelMatrix);
+		meshes.clear();
+		modelMatrix = nullptr;
 
+		path.clear();
 
-			if (mesh.indexBuffer->GetIndexCount() == 0 ||
-				mesh.indexBuffer->GetIndexCount() == mesh.vertexBuffer->GetVertexCount())
-			{
-				commandBuffer.draw(mesh.vertexBuffer->GetVertexCount(), 1, 0, 0);
-			}
-			else
-			{
-				commandBuffer.bindIndexBuffer(mesh.indexBuffer->GetBuffer(), 0, vk::IndexType::eUint32);
-				commandBuffer.drawIndexed(mesh.indexBuffer->GetIndexCount(), 1, 0, 0, 0);
-			}
-		}
+		material.materials.clear();
 	}
 
 	void ModelComponent::AddMaterialToModel(std::string materialName)
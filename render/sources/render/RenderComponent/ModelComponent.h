@@ -42,6 +42,7 @@ namespace Render
 	COMPONENT(ModelComponent,
 		INIT_PARAM(ModelComponentInitParams),
 		FUNCTION(void, Initialize, const void*, params),
+		FUNCTION(void, LoadResources),
 		FUNCTION(void, Constructor),
 		FUNCTION(void, Finalize),
 		FUNCTION(void, AddMaterialToModel, std::string, materialName),
@@ -51,8 +52,6 @@ namespace Render
 			EMPTY(),
 			ModelComponent() = default;
 	        ModelComponent(ModelComponent&& other) noexcept;
-			void Draw(const vk::CommandBuffer& commandBuffer, const vk::PipelineLayout pipelineLayout, int idx, std::string& previousMaterialName);
-			void DrawUntextured(const vk::CommandBuffer& commandBuffer, const vk::PipelineLayout pipelineLayout);
 			void UpdateMaterials(const std::string newMaterial);
 			std::vector<MeshSubComponent> meshes;
 			VulkanPushConstant* modelMatrix;,
@@ -9,9 +9,19 @@ namespace Render
 		app = new VulkanGlfwApplication(windowWidth, windowHeight, windowTitle);
 	}
 
-	void RenderApplication::DrawFrame(const float deltaTime) const
+	void RenderApplication::DrawFrame(const float deltaTime, const bool isPipelined) const
 	{
-		app->DrawFrame(deltaTime);
+		app->DrawFrame(deltaTime, isPipelined);
+	}
+
+	void RenderApplication::WaitRender() const
+	{
+		app->WaitRender();
+	}
+
+	bool RenderApplication::IsWindowActive() const
+	{
+		return app->IsWindowActive();
 	}
 
 	FreeCam& RenderApplication::GetCamera()
@@ -16,7 +16,11 @@ namespace Render
 	{
 	public:
 		RenderApplication(size_t windowWidth, size_t windowHeight, const char* windowTitle);
-		void DrawFrame(float deltaTime) const;
+		// pipelined : the frame is recorded on the render thread while the caller simulates the next one
+		void DrawFrame(float deltaTime, bool isPipelined = false) const;
+		void WaitRender() const; // before changes the frame in flight must not see (level reload, shutdown)
+
+		[[nodiscard]] bool IsWindowActive() const; // focused and not minimized
 
 		static FreeCam& GetCamera();
 
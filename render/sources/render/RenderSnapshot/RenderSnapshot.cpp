@@ -0,0 +1,107 @@
+#include "RenderSnapshot.h"
+
+#include "core/ResourceManager.h"
+#include "core/DebugWindow/Profiler.h"
+#include "core/ECS/Entity.h"
+#include "core/scenegraph/SceneNode.h"
+#include "model/Model.h"
+#include "render/VulkanMacros.h"
+#include "render/Material/Material.h"
+#include "render/RenderComponent/ModelComponent.h"
+#include "render/VulkanBuffer/VulkanIndexBuffer.h"
+#include "render/VulkanBuffer/VulkanVertexBuffer.h"
+
+namespace Render
+{
+	void RenderSnapshot::Extract(const float interpolationAlpha)
+	{
+		PROFILE_ZONE("Extract snapshot");
+
+		Clear();
+
+		Material* defaultMaterial = ResourceManager::GetResource<Material>(Model::defaultMaterialName);
+
+		ModelComponent::Iterator it = ModelComponent::GetAll();
+		while (it.Next())
+		{
+			if (it->meshes.empty() || it->modelMatrix == nullptr)
+				continue;
+
+			const auto modelIndex = static_cast<unsigned int>(models.size());
+			models.push_back({Core::Entity::GetEntity(it->GetEntityHandle())->GetAnchor()
+			                  ->GenerateInterpolatedWorldTransformMatrix(interpolationAlpha)});
+
+			for (const MeshSubComponent& mesh : it->meshes)
+			{
+				drawItems.push_back({mesh.vertexBuffer, mesh.indexBuffer,
+				                     mesh.material ? mesh.material : defaultMaterial, modelIndex});
+			}
+		}
+
+		Physics::GetDebugLines(debugVertices);
+	}
+
+	void RenderSnapshot::Clear()
+	{
+		// capacities are kept from one frame to the next
+		models.clear();
+		drawItems.clear();
+		debugVertices.clear();
+	}
+
+	void RenderSnapshot::DrawUntextured(const vk::CommandBuffer& commandBuffer, const vk::PipelineLayout& pipelineLayout) const
+	{
+		for (const DrawItem& drawItem : drawItems)
+		{
+			commandBuffer.pushConstants(pipelineLayout,
+			                            vk::ShaderStageFlagBits::eVertex, 0,
+			                            sizeof(VulkanPushConstant),
+			                            &models[drawItem.modelIndex]);
+
+			DrawMesh(commandBuffer, drawItem);
+		}
+	}
+
+	void RenderSnapshot::Draw(const vk::CommandBuffer& commandBuffer, const vk::PipelineLayout& pipelineLayout,
+	                          const int frameIndex) const
+	{
+		const Material* previousMaterial = nullptr;
+
+		for (const DrawItem& drawItem : drawItems)
+		{
+			commandBuffer.pushConstants(pipelineLayout,
+			                            vk::ShaderStageFlagBits::eVertex, 0,
+			                            sizeof(VulkanPushConstant),
+			                            &models[drawItem.modelIndex]);
+
+			if (drawItem.material != previousMaterial)
+			{
+				commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+				                                 pipelineLayout, 2, 1,
+				                                 &drawItem.material->GetDescriptorSet(frameIndex), 0,
+				                                 nullptr);
+
+				previousMaterial = drawItem.material;
+			}
+
+			DrawMesh(commandBuffer, drawItem);
+		}
+	}
+
+	void RenderSnapshot::DrawMesh(const vk::CommandBuffer& commandBuffer, const DrawItem& drawItem)
+	{
+		vk::DeviceSize offsets[] = {0};
+		commandBuffer.bindVertexBuffers(0, 1, &drawItem.vertexBuffer->GetBuffer(), offsets);
+
+		if (drawItem.indexBuffer->GetIndexCount() == 0 ||
+			drawItem.indexBuffer->GetIndexCount() == drawItem.vertexBuffer->GetVertexCount())
+		{
+			commandBuffer.draw(drawItem.vertexBuffer->GetVertexCount(), 1, 0, 0);
+		}
+		else
+		{
+			commandBuffer.bindIndexBuffer(drawItem.indexBuffer->GetBuffer(), 0, vk::IndexType::eUint32);
+			commandBuffer.drawIndexed(drawItem.indexBuffer->GetIndexCount(), 1, 0, 0, 0);
+		}
+	}
+}
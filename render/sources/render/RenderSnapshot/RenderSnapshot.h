@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "../../../../physic/sources/physic/PhysicsManager.h"
+#include "render/VulkanPushConstant/VulkanPushConstant.h"
+
+namespace vk
+{
+	class CommandBuffer;
+	class PipelineLayout;
+}
+
+namespace Render
+{
+	class Material;
+	class VulkanIndexBuffer;
+	class VulkanVertexBuffer;
+
+	// Copy of what a frame draws, extracted on the main thread once the transforms are up to date.
+	// Recording only reads the snapshot, so it can run on the render thread while the simulation moves to the next frame.
+	// The camera and the lights are not part of it : they are written to the per frame uniform buffers during the extraction.
+	struct RenderSnapshot
+	{
+		struct DrawItem
+		{
+			VulkanVertexBuffer* vertexBuffer = nullptr;
+			VulkanIndexBuffer* indexBuffer = nullptr;
+			Material* material = nullptr; // the default material is resolved at extraction
+			unsigned int modelIndex = 0; // in models
+		};
+
+		void Extract(float interpolationAlpha); // see SceneNode::GetInterpolatedWorldTransform
+		void Clear();
+
+		void DrawUntextured(const vk::CommandBuffer& commandBuffer, const vk::PipelineLayout& pipelineLayout) const;
+		void Draw(const vk::CommandBuffer& commandBuffer, const vk::PipelineLayout& pipelineLayout, int frameIndex) const;
+
+		std::vector<VulkanPushConstant> models;
+		std::vector<DrawItem> drawItems; // in model order, materials are bound only when they change
+		std::vector<Physics::DebugVertex> debugVertices;
+
+	private:
+		static void DrawMesh(const vk::CommandBuffer& commandBuffer, const DrawItem& drawItem);
+	};
+}
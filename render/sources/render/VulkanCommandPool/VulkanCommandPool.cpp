@@ -14,7 +14,7 @@
 #include "imgui/EditorUI.h"
 #include "imgui/ImguiImpl.h"
 #include "render/VulkanConstants.h"
-#include "render/RenderComponent/ModelComponent.h"
+#include "render/RenderSnapshot/RenderSnapshot.h"
 #include "render/VulkanBuffer/VulkanBuffer.h"
 #include "render/VulkanQueryPool/VulkanQueryPool.h"
 #include "model/Vertex.h"
@@ -153,7 +153,8 @@ namespace Render
 	                                            const vk::DescriptorSet lightDescriptor,
 	                                            const vk::Extent2D& viewportSize,
 	                                            VulkanVertexBuffer& debugLines,
-	                                            const VulkanQueryPool& queryPool)
+	                                            const VulkanQueryPool& queryPool,
+	                                            const RenderSnapshot& snapshot)
 	{
 		vk::CommandBufferBeginInfo beginInfo = {};
 		beginInfo.flags = vk::CommandBufferUsageFlags{};
@@ -206,13 +207,10 @@ namespace Render
 			                                 pipeline.GetLayout(VulkanPipeline::PipelineStage::DEPTH), 0, 1,
 			                                 &depthDescriptor, 0, nullptr);
 
-			START_BENCHMARK("Draw Shadow Map");
-			ModelComponent::Iterator it = ModelComponent::GetAll();
-			while (it.Next())
 			{
-				it->DrawUntextured(commandBuffer, pipeline.GetLayout(VulkanPipeline::PipelineStage::DEPTH));
+				PROFILE_ZONE("Draw Shadow Map");
+				snapshot.DrawUntextured(commandBuffer, pipeline.GetLayout(VulkanPipeline::PipelineStage::DEPTH));
 			}
-			STOP_BENCHMARK("Draw Shadow Map");
 
 
 			commandBuffer.endRenderPass();
@@ -240,48 +238,44 @@ namespace Render
 		if constexpr (VulkanConstants::enableValidationLayers)
 			commandBuffer.beginQuery(queryPool.GetQueryPool(), 0, vk::QueryControlFlags{});
 
-		START_BENCHMARK("Bind pipeline/descriptors");
+		vk::DeviceSize offset[] = {0};
+		{
+			PROFILE_ZONE("Bind pipeline/descriptors");
 
+			// Skybox
+			commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
+			                           pipeline.GetPipeline(VulkanPipeline::PipelineStage::SKYBOX));
 
-		// Skybox
-		commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
-		                           pipeline.GetPipeline(VulkanPipeline::PipelineStage::SKYBOX));
+			commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+			                                 pipeline.GetLayout(VulkanPipeline::PipelineStage::SKYBOX), 0, 1,
+			                                 &frameDescriptor, 0, nullptr);
 
-		commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-		                                 pipeline.GetLayout(VulkanPipeline::PipelineStage::SKYBOX), 0, 1,
-		                                 &frameDescriptor, 0, nullptr);
+			commandBuffer.bindVertexBuffers(0, 1, &cubemapVertices->GetBuffer(), offset);
+			commandBuffer.draw(cubemapVertices->GetVertexCount(), 1, 0, 0);
 
-		vk::DeviceSize offset[] = {0};
-		commandBuffer.bindVertexBuffers(0, 1, &cubemapVertices->GetBuffer(), offset);
-		commandBuffer.draw(cubemapVertices->GetVertexCount(), 1, 0, 0);
-
-		// Standard
-		commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
-		                           pipeline.GetPipeline(VulkanPipeline::PipelineStage::STANDARD));
-
-		commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-		                                 pipeline.GetLayout(VulkanPipeline::PipelineStage::STANDARD), 0, 1,
-		                                 &frameDescriptor, 0, nullptr);
-
-		commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-		                                 pipeline.GetLayout(VulkanPipeline::PipelineStage::STANDARD), 1, 1,
-		                                 &lightDescriptor, 0, nullptr);
-		STOP_BENCHMARK("Bind pipeline/descriptors");
-
-		START_BENCHMARK("Draw");
-		ModelComponent::Iterator it = ModelComponent::GetAll();
-		std::string previousMaterialName = "";
-		while (it.Next())
-		{
-			it->Draw(commandBuffer, pipeline.GetLayout(VulkanPipeline::PipelineStage::STANDARD),
-			         swapchain.GetFrameIndex(), previousMaterialName);
+			// Standard
+			commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
+			                           pipeline.GetPipeline(VulkanPipeline::PipelineStage::STANDARD));
+
+			commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+			                                 pipeline.GetLayout(VulkanPipeline::PipelineStage::STANDARD), 0, 1,
+			                                 &frameDescriptor, 0, nullptr);
+
+			commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+			                                 pipeline.GetLayout(VulkanPipeline::PipelineStage::STANDARD), 1, 1,
+			                                 &lightDescriptor, 0, nullptr);
 		}
-		STOP_BENCHMARK("Draw");
 
-		START_BENCHMARK("Physics Debug");
+		{
+			PROFILE_ZONE("Draw");
+			snapshot.Draw(commandBuffer, pipeline.GetLayout(VulkanPipeline::PipelineStage::STANDARD),
+			              swapchain.GetFrameIndex());
+		}
 
 		if (debugLines.GetVertexCount() > 0)
 		{
+			PROFILE_ZONE("Physics Debug");
+
 			commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
 			                           pipeline.GetPipeline(VulkanPipeline::PipelineStage::PHYSICS_DEBUG));
 
@@ -293,7 +287,6 @@ namespace Render
 
 			commandBuffer.draw(debugLines.GetVertexCount(), 1, 0, 0);
 		}
-		STOP_BENCHMARK("Physics Debug");
 
 		if constexpr (VulkanConstants::enableValidationLayers)
 			commandBuffer.endQuery(queryPool.GetQueryPool(), 0);
@@ -325,8 +318,10 @@ namespace Render
 	void VulkanCommandPool::CopyBuffer(VulkanBuffer& src, VulkanBuffer& dst, vk::DeviceSize size,
 	                                   const bool mutexLocked)
 	{
+		// the model uploads of the main thread may run while the render thread uploads the debug lines
+		std::unique_lock<std::mutex> lock(commandPoolMutex, std::defer_lock);
 		if (!mutexLocked)
-			std::lock_guard<std::mutex> lock(commandPoolMutex);
+			lock.lock();
 		// Create temp buffer
 		vk::CommandBufferAllocateInfo allocInfo{};
 		allocInfo.level = vk::CommandBufferLevel::ePrimary;
@@ -16,6 +16,7 @@ namespace Render
 	class VulkanSwapchain;
 	class VulkanDevice;
 	class Drawable;
+	struct RenderSnapshot;
 
 	class VulkanCommandPool
 	{
@@ -41,7 +42,8 @@ namespace Render
 		                         vk::DescriptorSet lightDescriptor,
 		                         const vk::Extent2D& viewportSize,
 		                         VulkanVertexBuffer& debugLines,
-		                         const VulkanQueryPool& queryPool);
+		                         const VulkanQueryPool& queryPool,
+		                         const RenderSnapshot& snapshot);
 
 		void CopyBuffer(VulkanBuffer& src, VulkanBuffer& dst, vk::DeviceSize size, bool mutexLocked = false);
 
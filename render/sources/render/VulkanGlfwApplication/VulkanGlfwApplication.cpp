@@ -62,34 +62,34 @@ namespace Render
 
 
 		Core::DefaultInputManager::OnPressed(EActionEnum::FREE_CAM_FORWARD)->Add(
-			std::bind(&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::FRONT));
+			&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::FRONT);
 		Core::DefaultInputManager::OnPressed(EActionEnum::FREE_CAM_BACKWARD)->Add(
-			std::bind(&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::BACK));
+			&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::BACK);
 		Core::DefaultInputManager::OnPressed(EActionEnum::FREE_CAM_LEFT)->Add(
-			std::bind(&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::LEFT));
+			&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::LEFT);
 		Core::DefaultInputManager::OnPressed(EActionEnum::FREE_CAM_RIGHT)->Add(
-			std::bind(&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::RIGHT));
+			&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::RIGHT);
 		Core::DefaultInputManager::OnPressed(EActionEnum::FREE_CAM_UP)->Add(
-			std::bind(&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::UP));
+			&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::UP);
 		Core::DefaultInputManager::OnPressed(EActionEnum::FREE_CAM_DOWN)->Add(
-			std::bind(&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::DOWN));
+			&FreeCam::StartMovingDir, &renderer->GetCamera(), FreeCam::Moving::DOWN);
 		Core::DefaultInputManager::OnPressed(EActionEnum::FREE_CAM_SPRINT)->Add(
-			std::bind(&FreeCam::StartSprint, &renderer->GetCamera()));
+			&FreeCam::StartSprint, &renderer->GetCamera());
 
 		Core::DefaultInputManager::OnReleased(EActionEnum::FREE_CAM_FORWARD)->Add(
-			std::bind(&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::FRONT));
+			&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::FRONT);
 		Core::DefaultInputManager::OnReleased(EActionEnum::FREE_CAM_BACKWARD)->Add(
-			std::bind(&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::BACK));
+			&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::BACK);
 		Core::DefaultInputManager::OnReleased(EActionEnum::FREE_CAM_LEFT)->Add(
-			std::bind(&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::LEFT));
+			&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::LEFT);
 		Core::DefaultInputManager::OnReleased(EActionEnum::FREE_CAM_RIGHT)->Add(
-			std::bind(&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::RIGHT));
+			&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::RIGHT);
 		Core::DefaultInputManager::OnReleased(EActionEnum::FREE_CAM_UP)->Add(
-			std::bind(&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::UP));
+			&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::UP);
 		Core::DefaultInputManager::OnReleased(EActionEnum::FREE_CAM_DOWN)->Add(
-			std::bind(&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::DOWN));
+			&FreeCam::StopMovingDir, &renderer->GetCamera(), FreeCam::Moving::DOWN);
 		Core::DefaultInputManager::OnReleased(EActionEnum::FREE_CAM_SPRINT)->Add(
-			std::bind(&FreeCam::StopSprint, &renderer->GetCamera()));
+			&FreeCam::StopSprint, &renderer->GetCamera());
 	}
 
 	FreeCam& VulkanGlfwApplication::GetCamera()
@@ -98,18 +98,32 @@ namespace Render
 	}
 
 
-	void VulkanGlfwApplication::DrawFrame(const float deltaTime) const
+	void VulkanGlfwApplication::DrawFrame(const float deltaTime, const bool isPipelined) const
 	{
 		if (!window->ShouldClose())
 		{
 			if(!window->IsMinimized())
 			{
-				renderer->DrawFrame(deltaTime);
+				if (isPipelined)
+					renderer->DrawFramePipelined(deltaTime);
+				else
+					renderer->DrawFrame(deltaTime);
 			}
 			return;
 		}
 
+		renderer->WaitRender();
 		renderer->WaitIdle();
 		Core::GameLoop::Stop();
 	}
+
+	void VulkanGlfwApplication::WaitRender() const
+	{
+		renderer->WaitRender();
+	}
+
+	bool VulkanGlfwApplication::IsWindowActive() const
+	{
+		return window->IsFocused() && !window->IsMinimized();
+	}
 }
@@ -15,7 +15,10 @@ namespace Render
 
 		static FreeCam& GetCamera();
 
-		void DrawFrame(float deltaTime) const;
+		void DrawFrame(float deltaTime, bool isPipelined) const;
+		void WaitRender() const;
+
+		[[nodiscard]] bool IsWindowActive() const;
 
 	private:
 		EngineWindow* window = nullptr;
@@ -7,8 +7,10 @@
 
 
 #include "core/CLog.h"
+#include "core/GameLoop.h"
 #include "core/PoolAllocator.h"
 #include "core/ResourceManager.h"
+#include "core/ThreadPool.h"
 #include "core/DebugWindow/DebugWindow.h"
 #include "core/ECS/Entity.h"
 #include "core/InputManager/DefaultInputManager.h"
@@ -44,6 +46,9 @@ namespace Render
 
 		s_renderer = this;
 
+		Model::Model::onMaterialTextureImport.Add(&VulkanRenderer::AddVulkanTextureToMaterial);
+		Model::Model::onMaterialValueImport.Add(&VulkanRenderer::AddValuesToMaterial);
+
 		engineWindow = &window;
 		bool ok = rhi.Initialize(instanceParams);
 		ASSERT(ok, "RHI failed to initialize", Core::ELogChannel::CLOG_RENDER);
@@ -187,6 +192,12 @@ namespace Render
 
 	VulkanRenderer::~VulkanRenderer()
 	{
+		WaitRender();
+		delete renderThread;
+
+		Model::Model::onMaterialTextureImport.ClearDelegates();
+		Model::Model::onMaterialValueImport.ClearDelegates();
+
 		ImGuiImpl::ShutdownImGui();
 
 		Core::MemoryPool::Free(sampler);
@@ -243,6 +254,62 @@ namespace Render
 	}
 
 	void VulkanRenderer::DrawFrame(const float deltaTime)
+	{
+		WaitRender();
+
+		const vk::Extent2D viewportSize = PrepareFrame(deltaTime);
+		RecordFrame(viewportSize);
+	}
+
+	void VulkanRenderer::DrawFramePipelined(const float deltaTime)
+	{
+		WaitRender();
+
+		const vk::Extent2D viewportSize = PrepareFrame(deltaTime);
+
+		if (renderThread == nullptr)
+		{
+			renderThread = new Core::ThreadPool(1);
+		}
+
+		isRenderInFlight = true;
+		renderTask = renderThread->AddTask([this, viewportSize]
+		{
+			PROFILE_ZONE("Render thread");
+			RecordFrame(viewportSize);
+		});
+	}
+
+	void VulkanRenderer::WaitRender()
+	{
+		if (isRenderInFlight)
+		{
+			PROFILE_ZONE("Wait render");
+			renderTask.wait();
+			isRenderInFlight = false;
+		}
+
+		// nothing reads the previous snapshot anymore, and Present waited for the device
+		std::vector<std::function<void()>> releases = std::move(pendingReleases);
+		pendingReleases.clear();
+		for (const std::function<void()>& release : releases)
+		{
+			release();
+		}
+	}
+
+	void VulkanRenderer::ReleaseAfterRender(std::function<void()> release)
+	{
+		if (s_renderer && s_renderer->isRenderInFlight)
+		{
+			s_renderer->pendingReleases.push_back(std::move(release));
+			return;
+		}
+
+		release();
+	}
+
+	vk::Extent2D VulkanRenderer::PrepareFrame(const float deltaTime)
 	{
 		vk::Extent2D viewportSize = HandleViewportResize();
 
@@ -250,43 +317,51 @@ namespace Render
 
 		HandleEditorMousePosition(deltaTime);
 
-		START_BENCHMARK("Update ubo");
-		uniformBuffers[swapchain->GetFrameIndex()]->UpdateViewMatrix();
-		uniformBuffers[swapchain->GetFrameIndex()]->Update(*graphicsDevice);
-
-		UpdateDirectionalLightBuffers(viewportAspectRatio);
+		{
+			PROFILE_ZONE("Update ubo");
+			uniformBuffers[swapchain->GetFrameIndex()]->UpdateViewMatrix();
+			uniformBuffers[swapchain->GetFrameIndex()]->Update(*graphicsDevice);
 
-		UpdateLightBuffers();
+			UpdateDirectionalLightBuffers(viewportAspectRatio);
 
-		STOP_BENCHMARK("Update ubo");
+			UpdateLightBuffers();
+		}
 
-		START_BENCHMARK("UI draw");
+		{
+			PROFILE_ZONE("UI draw");
 
 #ifndef _SHIPPING
-		editorUI.UpdateStyle();
+			editorUI.UpdateStyle();
 #endif
 
-		ImGuiImpl::NewFrame();
+			ImGuiImpl::NewFrame();
 #ifdef _SHIPPING
-		int width, height;
-		engineWindow->GetWindowSize(&width, &height);
-		GameViewport::gameViewport.Draw(swapchain->GetFrameIndex(), width, height);
+			int width, height;
+			engineWindow->GetWindowSize(&width, &height);
+			GameViewport::gameViewport.Draw(swapchain->GetFrameIndex(), width, height);
 #else
-		editorUI.Draw(swapchain->GetFrameIndex());
+			editorUI.Draw(swapchain->GetFrameIndex());
 #endif
-		ImGuiImpl::Render();
-		STOP_BENCHMARK("UI draw");
-
-		std::vector<Physics::DebugVertex> debugVertices;
-		GetDebugLines(debugVertices);
+			ImGuiImpl::Render();
+		}
 
+		// after the UI, it may still edit the scene this frame
+		snapshot.Extract(Core::GameLoop::GetInterpolationAlpha());
 
-		debugLines->ClearBuffer();
+		return viewportSize;
+	}
 
+	void VulkanRenderer::RecordFrame(const vk::Extent2D& viewportSize)
+	{
 		{
+			PROFILE_ZONE("Upload debug lines");
 			std::lock_guard<std::mutex> lock(singleUsePool->GetCommandPoolMutex());
-			debugLines->Initialize(*graphicsDevice, *singleUsePool, debugVertices);
+			debugLines->ClearBuffer();
+			debugLines->Initialize(*graphicsDevice, *singleUsePool, snapshot.debugVertices);
+		}
 
+		{
+			PROFILE_ZONE("Record and submit");
 			commandPool[swapchain->GetFrameIndex()]->RecordCommandBuffer(
 				swapchainFramebuffers[swapchain->GetImageInFlightIndex()]->GetFramebuffer(),
 				offscreenFramebuffers[swapchain->GetFrameIndex()]->GetFramebuffer(),
@@ -298,19 +373,20 @@ namespace Render
 				lightDescriptors->GetDescriptorSet(swapchain->GetFrameIndex()),
 				viewportSize,
 				*debugLines,
-				*queryPool);
+				*queryPool,
+				snapshot);
 
 			if constexpr (VulkanConstants::enableValidationLayers)
 				queryPool->GetQueryResults(*graphicsDevice);
 
-			START_BENCHMARK("Submit");
+			PROFILE_ZONE("Submit");
 			swapchain->SubmitCommandBuffers(commandPool[swapchain->GetFrameIndex()]->GetCommandBuffer(), 1);
 		}
-		STOP_BENCHMARK("Submit");
 
-		START_BENCHMARK("Present");
-		swapchain->PresentFrame();
-		STOP_BENCHMARK("Present");
+		{
+			PROFILE_ZONE("Present");
+			swapchain->PresentFrame();
+		}
 
 		commandPool[swapchain->GetFrameIndex()]->ResetCommandPool();
 	}
@@ -3,13 +3,21 @@
 #ifndef _SHIPPING
 #include "../../imgui/EditorUI.h"
 #endif
+#include <functional>
+#include <future>
 #include <mutex>
 #include <vector>
 
 #include "../VulkanRHI/VulkanRHI.h"
+#include "render/RenderSnapshot/RenderSnapshot.h"
 #include "Vector/Vector3.h"
 
 
+namespace Core
+{
+	class ThreadPool;
+}
+
 namespace LibMath
 {
 	//struct Vector3;
@@ -55,6 +63,13 @@ namespace Render
 		~VulkanRenderer();
 
 		void DrawFrame(float deltaTime);
+		// records and presents on the render thread, returns once the frame is extracted
+		void DrawFramePipelined(float deltaTime);
+		// blocks until the frame given to the render thread is presented, call before destroying what it may use
+		void WaitRender();
+
+		// frees GPU resources once the frame being recorded no longer uses them, immediately when no frame is in flight
+		static void ReleaseAfterRender(std::function<void()> release);
 
 		void WaitIdle() const;
 
@@ -94,6 +109,9 @@ namespace Render
 		void HandleEditorMousePosition(float deltaTime);
 		vk::Extent2D HandleViewportResize();
 
+		vk::Extent2D PrepareFrame(float deltaTime); // main thread : UI, uniform buffers, snapshot
+		void RecordFrame(const vk::Extent2D& viewportSize); // only reads the snapshot
+
 		VulkanRHI rhi = {};
 		class VulkanDevice* graphicsDevice = nullptr;
 		VulkanSwapchain* swapchain = nullptr;
@@ -140,6 +158,12 @@ namespace Render
 		CubemapImage* cubemapImage = nullptr;
 
 		VulkanVertexBuffer* debugLines = nullptr;
+
+		RenderSnapshot snapshot; // owned by the render thread while a frame is in flight
+		Core::ThreadPool* renderThread = nullptr; // created by the first pipelined frame
+		std::future<void> renderTask;
+		bool isRenderInFlight = false;
+		std::vector<std::function<void()>> pendingReleases;
 	};
 
 	static VulkanRenderer* s_renderer;
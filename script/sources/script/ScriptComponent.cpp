@@ -60,9 +60,8 @@ namespace script
 
 		if (lua_pcall(L, 1, 0, 0) != 0)
 		{
-			LOG(Core::ELogLevel::CLOG_ERROR,
-				Core::CLog::FormatString("%s::Update(%.3f) error: %s", script.c_str(), elapsedTime, lua_tostring(L, -1)),
-				Core::ELogChannel::CLOG_SCRIPT); // todo: make this line work
+			LOGF(Core::ELogLevel::CLOG_ERROR, Core::ELogChannel::CLOG_SCRIPT,
+				"%s::Update(%.3f) error: %s", script, elapsedTime, lua_tostring(L, -1));
 		}
 	}
 
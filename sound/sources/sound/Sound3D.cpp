@@ -47,6 +47,15 @@ namespace Sound
         maxDistance = initParams->maxDistance;
     }
 
+    void Sound3DComponent::LoadResources()
+    {
+        // the FMOD system is thread safe, opening the stream reads the file
+        if (path.empty() == false && sound == nullptr)
+        {
+            SoundManager::Load3DSound(this, path, isLoop);
+        }
+    }
+
     void Sound3DComponent::Constructor()
     {
         if (path == "")
@@ -56,7 +65,14 @@ namespace Sound
             return;
         }
 
-        CreateSound(path, isLoop);
+        if (sound == nullptr) // not opened by LoadResources
+        {
+            CreateSound(path, isLoop);
+        }
+        else
+        {
+            PlayPaused();
+        }
         SetMinMaxDistance(minDistance, maxDistance);
     }
 
@@ -134,7 +150,11 @@ namespace Sound
         int channelIndex;
         channel->getIndex(&channelIndex);
 
+        PlayPaused();
+    }
 
+    void Sound3DComponent::PlayPaused()
+    {
         SoundManager::GetFMODSystem()->playSound(sound, nullptr, false, &channel);
 
         channel->setPaused(true);
@@ -36,6 +36,7 @@ namespace Sound
         INIT_PARAM(SoundComponentParams),
         PRIVATE_FIELD(LibMath::Vector3, location, Core::FieldFlag::EDITOR_HIDDEN),
         FUNCTION(void, Initialize, const void*, params),
+        FUNCTION(void, LoadResources),
         FUNCTION(void, Constructor),
         FUNCTION(void, BeginPlay),
         FUNCTION(void, Finalize),
@@ -55,7 +56,8 @@ namespace Sound
         SUPPLEMENT(
             EMPTY(),
             Sound3DComponent() = default;
-            Sound3DComponent(Sound3DComponent&& other) noexcept; ,
+            Sound3DComponent(Sound3DComponent&& other) noexcept;
+            void PlayPaused();,
         EMPTY()
         )
     );